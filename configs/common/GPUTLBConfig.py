@@ -208,4 +208,11 @@ def config_tlb_hierarchy(options, system, shader_idx):
     # L2 <-> L3
     system.l2_tlb[0].master[0] = system.l3_coalescer[0].slave[0]
 
+    # The page walker of the last level TLB. Its memory port is connected
+    # by the caller once the memory system has been created.
+    if options.gpu_page_walker:
+        system.l3_tlb[0].page_walker = X86GPUPageWalker(
+            num_walkers = options.num_gpu_page_walkers,
+            pwc_size = options.gpu_pwc_entries)
+
     return system
@@ -82,6 +82,21 @@ def tlb_options(parser):
     parser.add_option("--L3MaxOutstandingReqs", type='int', default="64")
     parser.add_option("--L3AccessDistanceStat", action="store_true")
 
+    #===================================================================
+    #   Page Walker Options (attached to the L3 TLB)
+    #===================================================================
+
+    parser.add_option("--gpu-page-walker", action="store_true",
+                      help="resolve L3 TLB misses with timing page table "
+                      "walks instead of --L3MissLatency")
+    parser.add_option("--num-gpu-page-walkers", type='int', default="8",
+                      help="number of concurrent page table walks")
+    parser.add_option("--gpu-pwc-entries", type='int', default="32",
+                      help="number of page walk cache entries")
+    parser.add_option("--gpu-large-pages", action="store_true",
+                      help="map aligned 2MB and 1GB regions of the process "
+                      "with large pages, which the GPU TLBs cache as such")
+
     #===================================================================
     #   L1 TLBCoalescer Options
     #===================================================================
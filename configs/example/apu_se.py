@@ -129,7 +129,7 @@ parser.add_option("--wfs-per-simd", type="int", default=10, help="Number of " \
                   "WF slots per SIMD")
 
 parser.add_option("--registerManagerPolicy", type="string", default="static",
-                  help="Register manager policy")
+                  help="Register manager policy (static or dynamic)")
 parser.add_option("--vreg-file-size", type="int", default=2048,
                   help="number of physical vector registers per SIMD")
 parser.add_option("--vreg-min-alloc", type="int", default=4,
@@ -157,7 +157,11 @@ parser.add_option("--gpu-voltage", action="store", type="string",
                   default='1.0V',
                   help = """CPU  voltage domain""")
 parser.add_option("--CUExecPolicy", type="string", default="OLDEST-FIRST",
-                  help="WF exec policy (OLDEST-FIRST, ROUND-ROBIN)")
+                  help="WF exec policy (OLDEST-FIRST, ROUND-ROBIN, "
+                  "LOOSE-ROUND-ROBIN, GREEDY-THEN-OLDEST, TWO-LEVEL)")
+parser.add_option("--two-level-active-waves", type="int", default=4,
+                  help="number of waves in the active pool of each "
+                  "TWO-LEVEL scheduler")
 parser.add_option("--SegFaultDebug",action="store_true",
                  help="checks for GPU seg fault before TLB access")
 parser.add_option("--FunctionalTLB",action="store_true",
@@ -181,6 +185,26 @@ parser.add_option('--fast-forward-pseudo-op', action='store_true',
                   ' m5_switchcpu pseudo-ops will toggle back and forth')
 parser.add_option("--num-hw-queues", type="int", default=10,
                   help="number of hw queues in packet processor")
+parser.add_option("--cu-event-queues", type="int", default=0,
+                  help="simulate the CUs on this many event queues (and "
+                  "threads) of their own, 0 keeps the CUs on the main queue")
+parser.add_option("--sim-quantum", type="string", default="1us",
+                  help="simulation quantum used when the CUs have their "
+                  "own event queues")
+parser.add_option("--check-cu-handoffs", action="store_true",
+                  help="hash all packets crossing between the CU event "
+                  "queues and the memory system so that runs can be "
+                  "compared")
+parser.add_option("--gpu-fast-forward-kernels", type="int", default=0,
+                  help="execute this many kernel launches functionally "
+                  "before switching to the detailed GPU model")
+parser.add_option("--gpu-functional-kernels", type="string", default="",
+                  help="comma separated list of kernel launch indices and "
+                  "kernel names to execute functionally")
+parser.add_option("--gpu-sample-period", type="int", default=0,
+                  help="execute one of every N launches of each kernel in "
+                  "detail and the others functionally, and extrapolate the "
+                  "kernel run times from the detailed launches")
 
 Ruby.define_options(parser)
 
@@ -274,6 +298,8 @@ for i in xrange(n_cu):
                                      options.shr_mem_pipes_per_cu,
                                      n_wf = options.wfs_per_simd,
                                      execPolicy = options.CUExecPolicy,
+                                     twoLevelActiveWaves = \
+                                     options.two_level_active_waves,
                                      debugSegFault = options.SegFaultDebug,
                                      functionalTLB = options.FunctionalTLB,
                                      localMemBarrier = options.LocalMemBarrier,
@@ -321,6 +347,11 @@ for i in xrange(n_cu):
     compute_units[-1].ldsPort = compute_units[-1].ldsBus.slave
     compute_units[-1].ldsBus.master = compute_units[-1].localDataStore.cuPort
 
+    # the CU and its private children (LDS, register files, etc.) run on
+    # their own queue, the memory system stays on the main queue
+    if options.cu_event_queues > 0:
+        compute_units[-1].eventq_index = 1 + i % options.cu_event_queues
+
 # Attach compute units to GPU
 shader.CUs = compute_units
 
@@ -414,6 +445,13 @@ gpu_driver = GPUComputeDriver(filename="kfd")
 gpu_hsapp = HSAPacketProcessor(pioAddr=hsapp_gpu_map_paddr,
                                numHWQueues=options.num_hw_queues)
 dispatcher = GPUDispatcher()
+dispatcher.fast_forward_kernels = options.gpu_fast_forward_kernels
+dispatcher.sample_period = options.gpu_sample_period
+functional_kernels = filter(None, options.gpu_functional_kernels.split(','))
+dispatcher.functional_kernels = \
+    [int(k) for k in functional_kernels if k.isdigit()]
+dispatcher.functional_kernel_names = \
+    [k for k in functional_kernels if not k.isdigit()]
 gpu_cmd_proc = GPUCommandProcessor(hsapp=gpu_hsapp,
                                    dispatcher=dispatcher)
 gpu_driver.device = gpu_cmd_proc
@@ -471,6 +509,14 @@ for cpu in cpu_list:
 for cp in cp_list:
     cp.workload = host_cpu.workload
 
+# the GPU page walker reads the page table from simulated memory
+if options.gpu_page_walker:
+    process.useArchPT = True
+
+# let the GPU TLBs cache 2MB and 1GB pages
+if options.gpu_large_pages:
+    process.useLargePages = True
+
 if fast_forward:
     for i in xrange(len(future_cpu_list)):
         future_cpu_list[i].workload = cpu_list[i].workload
@@ -582,6 +628,11 @@ for i in xrange(n_cu):
         system.ruby._cpu_ports[gpu_port_idx].slave
 gpu_port_idx = gpu_port_idx + 1
 
+# page table walks go through the last scalar cache
+if options.gpu_page_walker:
+    system.l3_tlb[0].page_walker.port = \
+        system.ruby._cpu_ports[gpu_port_idx - 1].slave
+
 # attach CP ports to Ruby
 for i in xrange(options.num_cp):
     system.cpu[cp_idx].createInterruptController()
@@ -594,6 +645,22 @@ for i in xrange(options.num_cp):
     system.cpu[cp_idx].interrupts[0].int_slave = system.piobus.master
     cp_idx = cp_idx + 1
 
+# When the CUs have their own event queues, splice a queue bridge into
+# every port that leaves the CU. The bridge lives on the main queue and
+# hands packets between the CU's thread and the memory system's.
+if options.cu_event_queues > 0:
+    for cu in system.cpu[shader_idx].CUs:
+        cu.queue_bridge = QueueBridge(eventq_index = 0,
+                                      check_handoffs = \
+                                      options.check_cu_handoffs)
+        cu_ports = [cu.memory_port[j] for j in xrange(len(cu.memory_port))]
+        cu_ports += [cu.translation_port[j]
+                     for j in xrange(len(cu.translation_port))]
+        cu_ports += [cu.sqc_port, cu.sqc_tlb_port, cu.scalar_port,
+                     cu.scalar_tlb_port]
+        for j, port in enumerate(cu_ports):
+            port.splice(cu.queue_bridge.master[j], cu.queue_bridge.slave[j])
+
 ################# Connect the CPU and GPU via GPU Dispatcher ###################
 # CPU rings the GPU doorbell to notify a pending task
 # using this interface.
@@ -627,6 +694,10 @@ root = Root(system=system, full_system=False)
 hsaTopology.createHsaTopology(options)
 
 m5.ticks.setGlobalFrequency('1THz')
+
+if options.cu_event_queues > 0:
+    root.sim_quantum = m5.ticks.fromSeconds(
+        m5.util.convert.anyToLatency(options.sim_quantum))
 if options.abs_max_tick:
     maxtick = options.abs_max_tick
 else:
@@ -36,21 +36,24 @@
 #ifndef __ARCH_GCN3_GPU_MEM_HELPERS_HH__
 #define __ARCH_GCN3_GPU_MEM_HELPERS_HH__
 
+#include <algorithm>
+#include <cstring>
+#include <utility>
+#include <vector>
+
 #include "arch/gcn3/insts/gpu_static_inst.hh"
 #include "arch/gcn3/insts/op_encodings.hh"
 #include "debug/GPUMem.hh"
 #include "gpu-compute/gpu_dyn_inst.hh"
 
 /**
- * Helper function for instructions declared in op_encodings.  This function
- * takes in all of the arguments for a given memory request we are trying to
- * initialize, then submits the request or requests depending on if the
- * original request is aligned or unaligned.
+ * Helper function for initMemReqHelper.  This function issues the request,
+ * or the two requests if the access is misaligned, for a single lane.
  */
 template<typename T, int N>
 inline void
-initMemReqHelper(GPUDynInstPtr gpuDynInst, MemCmd mem_req_type,
-                 bool is_atomic=false)
+initLaneMemReqHelper(GPUDynInstPtr gpuDynInst, int lane, MemCmd mem_req_type,
+                     bool is_atomic)
 {
     // local variables
     int req_size = N * sizeof(T);
@@ -60,66 +63,213 @@ initMemReqHelper(GPUDynInstPtr gpuDynInst, MemCmd mem_req_type,
     RequestPtr req = nullptr, req1 = nullptr, req2 = nullptr;
     PacketPtr pkt = nullptr, pkt1 = nullptr, pkt2 = nullptr;
 
-    gpuDynInst->resetEntireStatusVector();
+    vaddr = gpuDynInst->addr[lane];
+
+    /**
+     * the base address of the cache line where the the last
+     * byte of the request will be stored.
+     */
+    split_addr = roundDown(vaddr + req_size - 1, block_size);
+
+    assert(split_addr <= vaddr || split_addr - vaddr < block_size);
+    /**
+     * if the base cache line address of the last byte is
+     * greater than the address of the first byte then we have
+     * a misaligned access.
+     */
+    misaligned_acc = split_addr > vaddr;
+
+    if (is_atomic) {
+        req = new Request(0, vaddr, sizeof(T), 0,
+            gpuDynInst->computeUnit()->masterId(), 0,
+            gpuDynInst->wfDynId,
+            gpuDynInst->makeAtomicOpFunctor<T>(
+                &(reinterpret_cast<T*>(gpuDynInst->a_data))[lane],
+                &(reinterpret_cast<T*>(gpuDynInst->x_data))[lane]));
+    } else {
+        req = new Request(0, vaddr, req_size, 0,
+                          gpuDynInst->computeUnit()->masterId(), 0,
+                          gpuDynInst->wfDynId);
+    }
+
+    if (misaligned_acc) {
+        gpuDynInst->setStatusVector(lane, 2);
+        req->splitOnVaddr(split_addr, req1, req2);
+        gpuDynInst->setRequestFlags(req1);
+        gpuDynInst->setRequestFlags(req2);
+        pkt1 = new Packet(req1, mem_req_type);
+        pkt2 = new Packet(req2, mem_req_type);
+        pkt1->dataStatic(&(reinterpret_cast<T*>(
+            gpuDynInst->d_data))[lane * N]);
+        pkt2->dataStatic(&(reinterpret_cast<T*>(
+            gpuDynInst->d_data))[lane * N + req1->getSize()]);
+        DPRINTF(GPUMem, "CU%d: WF[%d][%d]: index: %d unaligned memory "
+                "request for %#x\n", gpuDynInst->cu_id,
+                gpuDynInst->simdId, gpuDynInst->wfSlotId, lane,
+                split_addr);
+        gpuDynInst->computeUnit()->sendRequest(gpuDynInst, lane, pkt1);
+        gpuDynInst->computeUnit()->sendRequest(gpuDynInst, lane, pkt2);
+        // sendRequest() counts the two halves, but not the original
+        gpuDynInst->computeUnit()->vmemReqHeapAllocs++;
+        delete req;
+    } else {
+        gpuDynInst->setStatusVector(lane, 1);
+        gpuDynInst->setRequestFlags(req);
+        pkt = new Packet(req, mem_req_type);
+        pkt->dataStatic(&(reinterpret_cast<T*>(
+            gpuDynInst->d_data))[lane * N]);
+        gpuDynInst->computeUnit()->sendRequest(gpuDynInst, lane, pkt);
+    }
+}
+
+/**
+ * Helper function for initMemReqHelper.  This function merges the accesses
+ * of all active lanes that fall within the same cache line into a single
+ * request that spans the bytes touched by those lanes.  The request is
+ * issued on behalf of the lowest lane in the group, its data is gathered
+ * from (for stores) or scattered back to (for loads, see
+ * GPUDynInst::scatterCoalescedData()) each lane's d_data slot.
+ *
+ * Requests carry no byte mask, so a store is only merged if its lanes
+ * write every byte of the span exactly once.  Loads may cover holes and
+ * lanes that read the same bytes.  Misaligned accesses, and accesses that
+ * can not be merged with any other lane, are issued per lane.
+ */
+template<typename T, int N>
+inline void
+initCoalescedMemReqHelper(GPUDynInstPtr gpuDynInst, MemCmd mem_req_type)
+{
+    int req_size = N * sizeof(T);
+    int block_size = gpuDynInst->computeUnit()->cacheLineSize();
+    ComputeUnit *cu = gpuDynInst->computeUnit();
+
+    // the lanes that access each cache line, in the order in which the
+    // lines are first accessed. the number of lines is small enough that
+    // a linear search beats a map.
+    std::vector<std::pair<Addr, std::vector<int>>> line_lanes;
+
     for (int lane = 0; lane < Gcn3ISA::NumVecElemPerVecReg; ++lane) {
-        if (gpuDynInst->exec_mask[lane]) {
-            vaddr = gpuDynInst->addr[lane];
-
-            /**
-             * the base address of the cache line where the the last
-             * byte of the request will be stored.
-             */
-            split_addr = roundDown(vaddr + req_size - 1, block_size);
-
-            assert(split_addr <= vaddr || split_addr - vaddr < block_size);
-            /**
-             * if the base cache line address of the last byte is
-             * greater than the address of the first byte then we have
-             * a misaligned access.
-             */
-            misaligned_acc = split_addr > vaddr;
-
-            if (is_atomic) {
-                req = new Request(0, vaddr, sizeof(T), 0,
-                    gpuDynInst->computeUnit()->masterId(), 0,
-                    gpuDynInst->wfDynId,
-                    gpuDynInst->makeAtomicOpFunctor<T>(
-                        &(reinterpret_cast<T*>(gpuDynInst->a_data))[lane],
-                        &(reinterpret_cast<T*>(gpuDynInst->x_data))[lane]));
-            } else {
-                req = new Request(0, vaddr, req_size, 0,
-                                  gpuDynInst->computeUnit()->masterId(), 0,
-                                  gpuDynInst->wfDynId);
+        if (!gpuDynInst->exec_mask[lane]) {
+            continue;
+        }
+
+        Addr vaddr = gpuDynInst->addr[lane];
+        Addr line_addr = roundDown(vaddr, block_size);
+
+        if (roundDown(vaddr + req_size - 1, block_size) != line_addr) {
+            initLaneMemReqHelper<T, N>(gpuDynInst, lane, mem_req_type,
+                                       false);
+            continue;
+        }
+
+        auto line = std::find_if(line_lanes.begin(), line_lanes.end(),
+            [line_addr](const std::pair<Addr, std::vector<int>> &l)
+            { return l.first == line_addr; });
+
+        if (line == line_lanes.end()) {
+            line_lanes.emplace_back(line_addr, std::vector<int>(1, lane));
+        } else {
+            line->second.push_back(lane);
+        }
+    }
+
+    if (line_lanes.empty()) {
+        return;
+    }
+
+    gpuDynInst->coalescedLeader.assign(Gcn3ISA::NumVecElemPerVecReg, -1);
+    gpuDynInst->coalescedOffset.assign(Gcn3ISA::NumVecElemPerVecReg, 0);
+    gpuDynInst->coalescedData.assign(line_lanes.size() * block_size, 0);
+    gpuDynInst->coalescedLaneSize = req_size;
+
+    for (int line_idx = 0; line_idx < line_lanes.size(); ++line_idx) {
+        std::vector<int> &lanes = line_lanes[line_idx].second;
+
+        if (lanes.size() == 1) {
+            initLaneMemReqHelper<T, N>(gpuDynInst, lanes.front(),
+                                       mem_req_type, false);
+            continue;
+        }
+
+        std::vector<int> by_addr(lanes);
+        std::sort(by_addr.begin(), by_addr.end(),
+            [gpuDynInst](int a, int b)
+            { return gpuDynInst->addr[a] < gpuDynInst->addr[b]; });
+
+        Addr start_addr = gpuDynInst->addr[by_addr.front()];
+        Addr end_addr = gpuDynInst->addr[by_addr.back()] + req_size;
+
+        bool dense = true;
+        for (int i = 1; i < by_addr.size(); ++i) {
+            dense = dense && gpuDynInst->addr[by_addr[i]] ==
+                gpuDynInst->addr[by_addr[i - 1]] + req_size;
+        }
+
+        if (mem_req_type.isWrite() && !dense) {
+            // there are holes in, or overlapping writes to, the span
+            for (int lane : lanes) {
+                initLaneMemReqHelper<T, N>(gpuDynInst, lane, mem_req_type,
+                                           false);
             }
+            continue;
+        }
+
+        int leader = lanes.front();
+        uint8_t *line_data =
+            gpuDynInst->coalescedData.data() + line_idx * block_size;
 
-            if (misaligned_acc) {
-                gpuDynInst->setStatusVector(lane, 2);
-                req->splitOnVaddr(split_addr, req1, req2);
-                gpuDynInst->setRequestFlags(req1);
-                gpuDynInst->setRequestFlags(req2);
-                pkt1 = new Packet(req1, mem_req_type);
-                pkt2 = new Packet(req2, mem_req_type);
-                pkt1->dataStatic(&(reinterpret_cast<T*>(
-                    gpuDynInst->d_data))[lane * N]);
-                pkt2->dataStatic(&(reinterpret_cast<T*>(
-                    gpuDynInst->d_data))[lane * N + req1->getSize()]);
-                DPRINTF(GPUMem, "CU%d: WF[%d][%d]: index: %d unaligned memory "
-                        "request for %#x\n", gpuDynInst->cu_id,
-                        gpuDynInst->simdId, gpuDynInst->wfSlotId, lane,
-                        split_addr);
-                gpuDynInst->computeUnit()->sendRequest(gpuDynInst, lane, pkt1);
-                gpuDynInst->computeUnit()->sendRequest(gpuDynInst, lane, pkt2);
-                delete req;
-            } else {
-                gpuDynInst->setStatusVector(lane, 1);
-                gpuDynInst->setRequestFlags(req);
-                pkt = new Packet(req, mem_req_type);
-                pkt->dataStatic(&(reinterpret_cast<T*>(
-                    gpuDynInst->d_data))[lane * N]);
-                gpuDynInst->computeUnit()->sendRequest(gpuDynInst, lane, pkt);
+        for (int lane : lanes) {
+            int offset = gpuDynInst->addr[lane] - start_addr;
+            gpuDynInst->coalescedLeader[lane] = leader;
+            gpuDynInst->coalescedOffset[lane] =
+                line_idx * block_size + offset;
+
+            if (mem_req_type.isWrite()) {
+                std::memcpy(line_data + offset,
+                            gpuDynInst->d_data + lane * req_size, req_size);
             }
-        } else { // if lane is not active, then no pending requests
-            gpuDynInst->setStatusVector(lane, 0);
+        }
+
+        RequestPtr req = new Request(0, start_addr, end_addr - start_addr, 0,
+                                     cu->masterId(), 0, gpuDynInst->wfDynId);
+        gpuDynInst->setStatusVector(leader, 1);
+        gpuDynInst->setRequestFlags(req);
+        PacketPtr pkt = new Packet(req, mem_req_type);
+        pkt->dataStatic(line_data);
+
+        DPRINTF(GPUMem, "CU%d: WF[%d][%d]: index: %d coalesced request for "
+                "%d lanes to %#x\n", gpuDynInst->cu_id, gpuDynInst->simdId,
+                gpuDynInst->wfSlotId, leader, lanes.size(), start_addr);
+
+        cu->coalescedMemReqs++;
+        cu->coalescedLaneReqs += lanes.size();
+        cu->sendRequest(gpuDynInst, leader, pkt);
+    }
+}
+
+/**
+ * Helper function for instructions declared in op_encodings.  This function
+ * takes in all of the arguments for a given memory request we are trying to
+ * initialize, then submits the request or requests depending on if the
+ * original request is aligned or unaligned.
+ */
+template<typename T, int N>
+inline void
+initMemReqHelper(GPUDynInstPtr gpuDynInst, MemCmd mem_req_type,
+                 bool is_atomic=false)
+{
+    gpuDynInst->resetEntireStatusVector();
+
+    if (!is_atomic && gpuDynInst->computeUnit()->coalesceVectorMem) {
+        initCoalescedMemReqHelper<T, N>(gpuDynInst, mem_req_type);
+        return;
+    }
+
+    for (int lane = 0; lane < Gcn3ISA::NumVecElemPerVecReg; ++lane) {
+        // if lane is not active, then no pending requests
+        if (gpuDynInst->exec_mask[lane]) {
+            initLaneMemReqHelper<T, N>(gpuDynInst, lane, mem_req_type,
+                                       is_atomic);
         }
     }
 }
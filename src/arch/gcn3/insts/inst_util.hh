@@ -38,6 +38,7 @@
 
 #include <cmath>
 
+#include "arch/gcn3/insts/lane_op.hh"
 #include "arch/gcn3/registers.hh"
 
 // values for SDWA select operations
@@ -3723,7 +3723,7 @@ namespace Gcn3ISA
         wf->setStatus(Wavefront::S_STOPPED);
 
         int refCount = wf->computeUnit->getLds()
-            .decreaseRefCounter(wf->dispatchId, wf->wgId);
+            .decreaseRefCounter(wf->ldsChunk);
 
         DPRINTF(GPUExec, "CU%d: decrease ref ctr WG[%d] to [%d]\n",
             wf->computeUnit->cu_id, wf->wgId, refCount);
@@ -3762,6 +3762,9 @@ namespace Gcn3ISA
             // further check whether 'release @ kernel end' is needed
             bool relNeeded =
                 wf->computeUnit->shader->impl_kern_end_rel;
+            // functionally executed kernels leave no dirty data to
+            // release, see ComputeUnit::execFunctionalAccess()
+            relNeeded = relNeeded && !wf->functionalMode;
 
             // if not a kernel end or no release needed, retire the workgroup
             // directly
@@ -4398,7 +4401,7 @@ namespace Gcn3ISA
         calcAddr(gpuDynInst, addr, offset);
 
         gpuDynInst->computeUnit()->scalarMemoryPipe
-            .getGMReqFIFO().push(gpuDynInst);
+            .issueRequest(gpuDynInst);
 
         wf->scalarRdGmReqsInPipe--;
         wf->scalarOutstandingReqsRdGm++;
@@ -4456,8 +4459,7 @@ namespace Gcn3ISA
 
         calcAddr(gpuDynInst, addr, offset);
 
-        gpuDynInst->computeUnit()->scalarMemoryPipe.
-            getGMReqFIFO().push(gpuDynInst);
+        gpuDynInst->computeUnit()->scalarMemoryPipe.issueRequest(gpuDynInst);
 
         wf->scalarRdGmReqsInPipe--;
         wf->scalarOutstandingReqsRdGm++;
@@ -4513,8 +4515,7 @@ namespace Gcn3ISA
 
         calcAddr(gpuDynInst, addr, offset);
 
-        gpuDynInst->computeUnit()->scalarMemoryPipe.
-            getGMReqFIFO().push(gpuDynInst);
+        gpuDynInst->computeUnit()->scalarMemoryPipe.issueRequest(gpuDynInst);
 
         wf->scalarRdGmReqsInPipe--;
         wf->scalarOutstandingReqsRdGm++;
@@ -4570,8 +4571,7 @@ namespace Gcn3ISA
 
         calcAddr(gpuDynInst, addr, offset);
 
-        gpuDynInst->computeUnit()->scalarMemoryPipe.
-            getGMReqFIFO().push(gpuDynInst);
+        gpuDynInst->computeUnit()->scalarMemoryPipe.issueRequest(gpuDynInst);
 
         wf->scalarRdGmReqsInPipe--;
         wf->scalarOutstandingReqsRdGm++;
@@ -4627,8 +4627,7 @@ namespace Gcn3ISA
 
         calcAddr(gpuDynInst, addr, offset);
 
-        gpuDynInst->computeUnit()->scalarMemoryPipe.
-            getGMReqFIFO().push(gpuDynInst);
+        gpuDynInst->computeUnit()->scalarMemoryPipe.issueRequest(gpuDynInst);
 
         wf->scalarRdGmReqsInPipe--;
         wf->scalarOutstandingReqsRdGm++;
@@ -4837,8 +4836,7 @@ namespace Gcn3ISA
 
         calcAddr(gpuDynInst, addr, offset);
 
-        gpuDynInst->computeUnit()->scalarMemoryPipe.
-            getGMReqFIFO().push(gpuDynInst);
+        gpuDynInst->computeUnit()->scalarMemoryPipe.issueRequest(gpuDynInst);
 
         wf->scalarWrGmReqsInPipe--;
         wf->scalarOutstandingReqsWrGm++;
@@ -4896,8 +4894,7 @@ namespace Gcn3ISA
 
         calcAddr(gpuDynInst, addr, offset);
 
-        gpuDynInst->computeUnit()->scalarMemoryPipe.
-            getGMReqFIFO().push(gpuDynInst);
+        gpuDynInst->computeUnit()->scalarMemoryPipe.issueRequest(gpuDynInst);
 
         wf->scalarWrGmReqsInPipe--;
         wf->scalarOutstandingReqsWrGm++;
@@ -4955,8 +4952,7 @@ namespace Gcn3ISA
 
         calcAddr(gpuDynInst, addr, offset);
 
-        gpuDynInst->computeUnit()->scalarMemoryPipe.
-            getGMReqFIFO().push(gpuDynInst);
+        gpuDynInst->computeUnit()->scalarMemoryPipe.issueRequest(gpuDynInst);
 
         wf->scalarWrGmReqsInPipe--;
         wf->scalarOutstandingReqsWrGm++;
@@ -5247,7 +5243,6 @@ namespace Gcn3ISA
     void
     Inst_VOP2__V_ADD_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src0(gpuDynInst, instData.SRC0);
         VecOperandF32 src1(gpuDynInst, instData.VSRC1);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
@@ -5274,11 +5269,8 @@ namespace Gcn3ISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src0[lane] + src1[lane];
-            }
-        }
+        laneOp(vdst.lanes(), src0.lanes(), src1.lanes(),
+            [](VecElemF32 a, VecElemF32 b) { return a + b; });
 
         vdst.write();
     }
@@ -5298,7 +5290,6 @@ namespace Gcn3ISA
     void
     Inst_VOP2__V_SUB_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src0(gpuDynInst, instData.SRC0);
         ConstVecOperandF32 src1(gpuDynInst, instData.VSRC1);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
@@ -5306,11 +5297,8 @@ namespace Gcn3ISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src0[lane] - src1[lane];
-            }
-        }
+        laneOp(vdst.lanes(), src0.lanes(), src1.lanes(),
+            [](VecElemF32 a, VecElemF32 b) { return a - b; });
 
         vdst.write();
     }
@@ -5330,7 +5318,6 @@ namespace Gcn3ISA
     void
     Inst_VOP2__V_SUBREV_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src0(gpuDynInst, instData.SRC0);
         ConstVecOperandF32 src1(gpuDynInst, instData.VSRC1);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
@@ -5338,11 +5325,8 @@ namespace Gcn3ISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src1[lane] - src0[lane];
-            }
-        }
+        laneOp(vdst.lanes(), src0.lanes(), src1.lanes(),
+            [](VecElemF32 a, VecElemF32 b) { return b - a; });
 
         vdst.write();
     }
@@ -5362,7 +5346,6 @@ namespace Gcn3ISA
     void
     Inst_VOP2__V_MUL_LEGACY_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src0(gpuDynInst, instData.SRC0);
         ConstVecOperandF32 src1(gpuDynInst, instData.VSRC1);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
@@ -5370,11 +5353,8 @@ namespace Gcn3ISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src0[lane] * src1[lane];
-            }
-        }
+        laneOp(vdst.lanes(), src0.lanes(), src1.lanes(),
+            [](VecElemF32 a, VecElemF32 b) { return a * b; });
 
         vdst.write();
     }
@@ -5647,7 +5627,6 @@ namespace Gcn3ISA
     void
     Inst_VOP2__V_MIN_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src0(gpuDynInst, instData.SRC0);
         ConstVecOperandF32 src1(gpuDynInst, instData.VSRC1);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
@@ -5655,11 +5634,8 @@ namespace Gcn3ISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::fmin(src0[lane], src1[lane]);
-            }
-        }
+        laneOp(vdst.lanes(), src0.lanes(), src1.lanes(),
+            [](VecElemF32 a, VecElemF32 b) { return std::fmin(a, b); });
 
         vdst.write();
     }
@@ -5679,7 +5655,6 @@ namespace Gcn3ISA
     void
     Inst_VOP2__V_MAX_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src0(gpuDynInst, instData.SRC0);
         ConstVecOperandF32 src1(gpuDynInst, instData.VSRC1);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
@@ -5687,11 +5662,8 @@ namespace Gcn3ISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::fmax(src0[lane], src1[lane]);
-            }
-        }
+        laneOp(vdst.lanes(), src0.lanes(), src1.lanes(),
+            [](VecElemF32 a, VecElemF32 b) { return std::fmax(a, b); });
 
         vdst.write();
     }
@@ -5710,7 +5682,6 @@ namespace Gcn3ISA
     void
     Inst_VOP2__V_MIN_I32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandI32 src0(gpuDynInst, instData.SRC0);
         ConstVecOperandI32 src1(gpuDynInst, instData.VSRC1);
         VecOperandI32 vdst(gpuDynInst, instData.VDST);
@@ -5718,11 +5689,8 @@ namespace Gcn3ISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::min(src0[lane], src1[lane]);
-            }
-        }
+        laneOp(vdst.lanes(), src0.lanes(), src1.lanes(),
+            [](VecElemI32 a, VecElemI32 b) { return std::min(a, b); });
 
         vdst.write();
     }
@@ -5741,7 +5709,6 @@ namespace Gcn3ISA
     void
     Inst_VOP2__V_MAX_I32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandI32 src0(gpuDynInst, instData.SRC0);
         ConstVecOperandI32 src1(gpuDynInst, instData.VSRC1);
         VecOperandI32 vdst(gpuDynInst, instData.VDST);
@@ -5749,11 +5716,8 @@ namespace Gcn3ISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::max(src0[lane], src1[lane]);
-            }
-        }
+        laneOp(vdst.lanes(), src0.lanes(), src1.lanes(),
+            [](VecElemI32 a, VecElemI32 b) { return std::max(a, b); });
 
         vdst.write();
     }
@@ -5772,7 +5736,6 @@ namespace Gcn3ISA
     void
     Inst_VOP2__V_MIN_U32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src0(gpuDynInst, instData.SRC0);
         ConstVecOperandU32 src1(gpuDynInst, instData.VSRC1);
         VecOperandU32 vdst(gpuDynInst, instData.VDST);
@@ -5780,11 +5743,8 @@ namespace Gcn3ISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::min(src0[lane], src1[lane]);
-            }
-        }
+        laneOp(vdst.lanes(), src0.lanes(), src1.lanes(),
+            [](VecElemU32 a, VecElemU32 b) { return std::min(a, b); });
 
         vdst.write();
     }
@@ -5803,7 +5763,6 @@ namespace Gcn3ISA
     void
     Inst_VOP2__V_MAX_U32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src0(gpuDynInst, instData.SRC0);
         ConstVecOperandU32 src1(gpuDynInst, instData.VSRC1);
         VecOperandU32 vdst(gpuDynInst, instData.VDST);
@@ -5811,11 +5770,8 @@ namespace Gcn3ISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::max(src0[lane], src1[lane]);
-            }
-        }
+        laneOp(vdst.lanes(), src0.lanes(), src1.lanes(),
+            [](VecElemU32 a, VecElemU32 b) { return std::max(a, b); });
 
         vdst.write();
     }
@@ -5971,7 +5927,6 @@ namespace Gcn3ISA
     void
     Inst_VOP2__V_AND_B32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src0(gpuDynInst, instData.SRC0);
         ConstVecOperandU32 src1(gpuDynInst, instData.VSRC1);
         VecOperandU32 vdst(gpuDynInst, instData.VDST);
@@ -5979,11 +5934,8 @@ namespace Gcn3ISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src0[lane] & src1[lane];
-            }
-        }
+        laneOp(vdst.lanes(), src0.lanes(), src1.lanes(),
+            [](VecElemU32 a, VecElemU32 b) { return a & b; });
 
         vdst.write();
     }
@@ -6076,7 +6028,6 @@ namespace Gcn3ISA
     void
     Inst_VOP2__V_XOR_B32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src0(gpuDynInst, instData.SRC0);
         ConstVecOperandU32 src1(gpuDynInst, instData.VSRC1);
         VecOperandU32 vdst(gpuDynInst, instData.VDST);
@@ -6084,11 +6035,8 @@ namespace Gcn3ISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src0[lane] ^ src1[lane];
-            }
-        }
+        laneOp(vdst.lanes(), src0.lanes(), src1.lanes(),
+            [](VecElemU32 a, VecElemU32 b) { return a ^ b; });
 
         vdst.write();
     }
@@ -6109,7 +6057,6 @@ namespace Gcn3ISA
     void
     Inst_VOP2__V_MAC_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src0(gpuDynInst, instData.SRC0);
         VecOperandF32 src1(gpuDynInst, instData.VSRC1);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
@@ -6137,11 +6084,9 @@ namespace Gcn3ISA
             processDPP(gpuDynInst, extData.iFmt_VOP_DPP, src0_dpp, src1);
         }
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::fma(src0[lane], src1[lane], vdst[lane]);
-            }
-        }
+        laneOp(vdst.lanes(), src0.lanes(), src1.lanes(), vdst.lanes(),
+            [](VecElemF32 a, VecElemF32 b, VecElemF32 c)
+            { return std::fma(a, b, c); });
 
         vdst.write();
     }
@@ -6654,7 +6599,6 @@ namespace Gcn3ISA
     void
     Inst_VOP2__V_ADD_U16::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU16 src0(gpuDynInst, instData.SRC0);
         ConstVecOperandU16 src1(gpuDynInst, instData.VSRC1);
         VecOperandU16 vdst(gpuDynInst, instData.VDST);
@@ -6662,11 +6606,8 @@ namespace Gcn3ISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src0[lane] + src1[lane];
-            }
-        }
+        laneOp(vdst.lanes(), src0.lanes(), src1.lanes(),
+            [](VecElemU16 a, VecElemU16 b) { return a + b; });
 
         vdst.write();
     }
@@ -6685,7 +6626,6 @@ namespace Gcn3ISA
     void
     Inst_VOP2__V_SUB_U16::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU16 src0(gpuDynInst, instData.SRC0);
         ConstVecOperandU16 src1(gpuDynInst, instData.VSRC1);
         VecOperandU16 vdst(gpuDynInst, instData.VDST);
@@ -6693,11 +6633,8 @@ namespace Gcn3ISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src0[lane] - src1[lane];
-            }
-        }
+        laneOp(vdst.lanes(), src0.lanes(), src1.lanes(),
+            [](VecElemU16 a, VecElemU16 b) { return a - b; });
 
         vdst.write();
     }
@@ -6716,7 +6653,6 @@ namespace Gcn3ISA
     void
     Inst_VOP2__V_SUBREV_U16::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU16 src0(gpuDynInst, instData.SRC0);
         ConstVecOperandU16 src1(gpuDynInst, instData.VSRC1);
         VecOperandU16 vdst(gpuDynInst, instData.VDST);
@@ -6724,11 +6660,8 @@ namespace Gcn3ISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src1[lane] - src0[lane];
-            }
-        }
+        laneOp(vdst.lanes(), src0.lanes(), src1.lanes(),
+            [](VecElemU16 a, VecElemU16 b) { return b - a; });
 
         vdst.write();
     }
@@ -6747,7 +6680,6 @@ namespace Gcn3ISA
     void
     Inst_VOP2__V_MUL_LO_U16::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU16 src0(gpuDynInst, instData.SRC0);
         ConstVecOperandU16 src1(gpuDynInst, instData.VSRC1);
         VecOperandU16 vdst(gpuDynInst, instData.VDST);
@@ -6755,11 +6687,8 @@ namespace Gcn3ISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src0[lane] * src1[lane];
-            }
-        }
+        laneOp(vdst.lanes(), src0.lanes(), src1.lanes(),
+            [](VecElemU16 a, VecElemU16 b) { return a * b; });
 
         vdst.write();
     }
@@ -6909,7 +6838,6 @@ namespace Gcn3ISA
     void
     Inst_VOP2__V_MAX_U16::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU16 src0(gpuDynInst, instData.SRC0);
         ConstVecOperandU16 src1(gpuDynInst, instData.VSRC1);
         VecOperandU16 vdst(gpuDynInst, instData.VDST);
@@ -6917,11 +6845,8 @@ namespace Gcn3ISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::max(src0[lane], src1[lane]);
-            }
-        }
+        laneOp(vdst.lanes(), src0.lanes(), src1.lanes(),
+            [](VecElemU16 a, VecElemU16 b) { return std::max(a, b); });
 
         vdst.write();
     }
@@ -6940,7 +6865,6 @@ namespace Gcn3ISA
     void
     Inst_VOP2__V_MAX_I16::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandI16 src0(gpuDynInst, instData.SRC0);
         ConstVecOperandI16 src1(gpuDynInst, instData.VSRC1);
         VecOperandI16 vdst(gpuDynInst, instData.VDST);
@@ -6948,11 +6872,8 @@ namespace Gcn3ISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::max(src0[lane], src1[lane]);
-            }
-        }
+        laneOp(vdst.lanes(), src0.lanes(), src1.lanes(),
+            [](VecElemI16 a, VecElemI16 b) { return std::max(a, b); });
 
         vdst.write();
     }
@@ -6971,7 +6892,6 @@ namespace Gcn3ISA
     void
     Inst_VOP2__V_MIN_U16::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU16 src0(gpuDynInst, instData.SRC0);
         ConstVecOperandU16 src1(gpuDynInst, instData.VSRC1);
         VecOperandU16 vdst(gpuDynInst, instData.VDST);
@@ -6979,11 +6899,8 @@ namespace Gcn3ISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::min(src0[lane], src1[lane]);
-            }
-        }
+        laneOp(vdst.lanes(), src0.lanes(), src1.lanes(),
+            [](VecElemU16 a, VecElemU16 b) { return std::min(a, b); });
 
         vdst.write();
     }
@@ -7002,7 +6919,6 @@ namespace Gcn3ISA
     void
     Inst_VOP2__V_MIN_I16::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandI16 src0(gpuDynInst, instData.SRC0);
         ConstVecOperandI16 src1(gpuDynInst, instData.VSRC1);
         VecOperandI16 vdst(gpuDynInst, instData.VDST);
@@ -7010,11 +6926,8 @@ namespace Gcn3ISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::min(src0[lane], src1[lane]);
-            }
-        }
+        laneOp(vdst.lanes(), src0.lanes(), src1.lanes(),
+            [](VecElemI16 a, VecElemI16 b) { return std::min(a, b); });
 
         vdst.write();
     }
@@ -7193,17 +7106,13 @@ namespace Gcn3ISA
     void
     Inst_VOP1__V_CVT_F64_I32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandI32 src(gpuDynInst, instData.SRC0);
         VecOperandF64 vdst(gpuDynInst, instData.VDST);
 
         src.readSrc();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = (VecElemF64)src[lane];
-            }
-        }
+        laneOp(vdst.lanes(), src.lanes(),
+            [](VecElemI32 a) { return (VecElemF64)a; });
 
         vdst.write();
     }
@@ -7223,17 +7132,13 @@ namespace Gcn3ISA
     void
     Inst_VOP1__V_CVT_F32_I32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandI32 src(gpuDynInst, instData.SRC0);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
 
         src.readSrc();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = (VecElemF32)src[lane];
-            }
-        }
+        laneOp(vdst.lanes(), src.lanes(),
+            [](VecElemI32 a) { return (VecElemF32)a; });
 
         vdst.write();
     }
@@ -7253,17 +7158,13 @@ namespace Gcn3ISA
     void
     Inst_VOP1__V_CVT_F32_U32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src(gpuDynInst, instData.SRC0);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
 
         src.readSrc();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = (VecElemF32)src[lane];
-            }
-        }
+        laneOp(vdst.lanes(), src.lanes(),
+            [](VecElemU32 a) { return (VecElemF32)a; });
 
         vdst.write();
     }
@@ -7489,17 +7390,13 @@ namespace Gcn3ISA
     void
     Inst_VOP1__V_CVT_F32_F64::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF64 src(gpuDynInst, instData.SRC0);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
 
         src.readSrc();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = (VecElemF32)src[lane];
-            }
-        }
+        laneOp(vdst.lanes(), src.lanes(),
+            [](VecElemF64 a) { return (VecElemF32)a; });
 
         vdst.write();
     }
@@ -7519,17 +7416,13 @@ namespace Gcn3ISA
     void
     Inst_VOP1__V_CVT_F64_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src(gpuDynInst, instData.SRC0);
         VecOperandF64 vdst(gpuDynInst, instData.VDST);
 
         src.readSrc();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = (VecElemF64)src[lane];
-            }
-        }
+        laneOp(vdst.lanes(), src.lanes(),
+            [](VecElemF32 a) { return (VecElemF64)a; });
 
         vdst.write();
     }
@@ -7705,17 +7598,13 @@ namespace Gcn3ISA
     void
     Inst_VOP1__V_CVT_F64_U32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src(gpuDynInst, instData.SRC0);
         VecOperandF64 vdst(gpuDynInst, instData.VDST);
 
         src.readSrc();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = (VecElemF64)src[lane];
-            }
-        }
+        laneOp(vdst.lanes(), src.lanes(),
+            [](VecElemU32 a) { return (VecElemF64)a; });
 
         vdst.write();
     }
@@ -7735,17 +7624,13 @@ namespace Gcn3ISA
     void
     Inst_VOP1__V_TRUNC_F64::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF64 src(gpuDynInst, instData.SRC0);
         VecOperandF64 vdst(gpuDynInst, instData.VDST);
 
         src.readSrc();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::trunc(src[lane]);
-            }
-        }
+        laneOp(vdst.lanes(), src.lanes(),
+            [](VecElemF64 a) { return std::trunc(a); });
 
         vdst.write();
     }
@@ -7765,17 +7650,13 @@ namespace Gcn3ISA
     void
     Inst_VOP1__V_CEIL_F64::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF64 src(gpuDynInst, instData.SRC0);
         VecOperandF64 vdst(gpuDynInst, instData.VDST);
 
         src.readSrc();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::ceil(src[lane]);
-            }
-        }
+        laneOp(vdst.lanes(), src.lanes(),
+            [](VecElemF64 a) { return std::ceil(a); });
 
         vdst.write();
     }
@@ -7825,17 +7706,13 @@ namespace Gcn3ISA
     void
     Inst_VOP1__V_FLOOR_F64::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF64 src(gpuDynInst, instData.SRC0);
         VecOperandF64 vdst(gpuDynInst, instData.VDST);
 
         src.readSrc();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::floor(src[lane]);
-            }
-        }
+        laneOp(vdst.lanes(), src.lanes(),
+            [](VecElemF64 a) { return std::floor(a); });
 
         vdst.write();
     }
@@ -7886,17 +7763,13 @@ namespace Gcn3ISA
     void
     Inst_VOP1__V_TRUNC_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src(gpuDynInst, instData.SRC0);
         VecOperandF32 vdst (gpuDynInst, instData.VDST);
 
         src.readSrc();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::trunc(src[lane]);
-            }
-        }
+        laneOp(vdst.lanes(), src.lanes(),
+            [](VecElemF32 a) { return std::trunc(a); });
 
         vdst.write();
     }
@@ -7916,17 +7789,13 @@ namespace Gcn3ISA
     void
     Inst_VOP1__V_CEIL_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src(gpuDynInst, instData.SRC0);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
 
         src.readSrc();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::ceil(src[lane]);
-            }
-        }
+        laneOp(vdst.lanes(), src.lanes(),
+            [](VecElemF32 a) { return std::ceil(a); });
 
         vdst.write();
     }
@@ -7976,17 +7845,13 @@ namespace Gcn3ISA
     void
     Inst_VOP1__V_FLOOR_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src(gpuDynInst, instData.SRC0);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
 
         src.readSrc();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::floor(src[lane]);
-            }
-        }
+        laneOp(vdst.lanes(), src.lanes(),
+            [](VecElemF32 a) { return std::floor(a); });
 
         vdst.write();
     }
@@ -8066,17 +7931,13 @@ namespace Gcn3ISA
     void
     Inst_VOP1__V_RCP_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src(gpuDynInst, instData.SRC0);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
 
         src.readSrc();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = 1.0 / src[lane];
-            }
-        }
+        laneOp(vdst.lanes(), src.lanes(),
+            [](VecElemF32 a) { return 1.0 / a; });
 
         vdst.write();
     }
@@ -8239,17 +8100,13 @@ namespace Gcn3ISA
     void
     Inst_VOP1__V_SQRT_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src(gpuDynInst, instData.SRC0);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
 
         src.readSrc();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::sqrt(src[lane]);
-            }
-        }
+        laneOp(vdst.lanes(), src.lanes(),
+            [](VecElemF32 a) { return std::sqrt(a); });
 
         vdst.write();
     }
@@ -8269,17 +8126,13 @@ namespace Gcn3ISA
     void
     Inst_VOP1__V_SQRT_F64::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF64 src(gpuDynInst, instData.SRC0);
         VecOperandF64 vdst(gpuDynInst, instData.VDST);
 
         src.readSrc();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::sqrt(src[lane]);
-            }
-        }
+        laneOp(vdst.lanes(), src.lanes(),
+            [](VecElemF64 a) { return std::sqrt(a); });
 
         vdst.write();
     }
@@ -8371,17 +8224,13 @@ namespace Gcn3ISA
     void
     Inst_VOP1__V_NOT_B32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src(gpuDynInst, instData.SRC0);
         VecOperandU32 vdst(gpuDynInst, instData.VDST);
 
         src.readSrc();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = ~src[lane];
-            }
-        }
+        laneOp(vdst.lanes(), src.lanes(),
+            [](VecElemU32 a) { return ~a; });
 
         vdst.write();
     }
@@ -22885,7 +22734,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_ADD_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandF32 src1(gpuDynInst, extData.SRC1);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
@@ -22915,11 +22763,8 @@ namespace Gcn3ISA
         assert(!(instData.ABS & 0x4));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src0[lane] + src1[lane];
-            }
-        }
+        laneOp(vdst.lanes(), src0.lanes(), src1.lanes(),
+            [](VecElemF32 a, VecElemF32 b) { return a + b; });
 
         vdst.write();
     }
@@ -22939,7 +22784,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_SUB_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandF32 src1(gpuDynInst, extData.SRC1);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
@@ -22969,11 +22813,8 @@ namespace Gcn3ISA
         assert(!(instData.ABS & 0x4));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src0[lane] - src1[lane];
-            }
-        }
+        laneOp(vdst.lanes(), src0.lanes(), src1.lanes(),
+            [](VecElemF32 a, VecElemF32 b) { return a - b; });
 
         vdst.write();
     }
@@ -22993,7 +22834,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_SUBREV_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandF32 src1(gpuDynInst, extData.SRC1);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
@@ -23023,11 +22863,8 @@ namespace Gcn3ISA
         assert(!(instData.ABS & 0x4));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src1[lane] - src0[lane];
-            }
-        }
+        laneOp(vdst.lanes(), src0.lanes(), src1.lanes(),
+            [](VecElemF32 a, VecElemF32 b) { return b - a; });
 
         vdst.write();
     }
@@ -23417,7 +23254,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_MIN_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandF32 src1(gpuDynInst, extData.SRC1);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
@@ -23447,11 +23283,8 @@ namespace Gcn3ISA
         assert(!(instData.ABS & 0x4));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::fmin(src0[lane], src1[lane]);
-            }
-        }
+        laneOp(vdst.lanes(), src0.lanes(), src1.lanes(),
+            [](VecElemF32 a, VecElemF32 b) { return std::fmin(a, b); });
 
         vdst.write();
     }
@@ -23471,7 +23304,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_MAX_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandF32 src1(gpuDynInst, extData.SRC1);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
@@ -23501,11 +23333,8 @@ namespace Gcn3ISA
         assert(!(instData.ABS & 0x4));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::fmax(src0[lane], src1[lane]);
-            }
-        }
+        laneOp(vdst.lanes(), src0.lanes(), src1.lanes(),
+            [](VecElemF32 a, VecElemF32 b) { return std::fmax(a, b); });
 
         vdst.write();
     }
@@ -23524,7 +23353,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_MIN_I32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandI32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandI32 src1(gpuDynInst, extData.SRC1);
         VecOperandI32 vdst(gpuDynInst, instData.VDST);
@@ -23542,11 +23370,8 @@ namespace Gcn3ISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::min(src0[lane], src1[lane]);
-            }
-        }
+        laneOp(vdst.lanes(), src0.lanes(), src1.lanes(),
+            [](VecElemI32 a, VecElemI32 b) { return std::min(a, b); });
 
         vdst.write();
     }
@@ -23565,7 +23390,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_MAX_I32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandI32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandI32 src1(gpuDynInst, extData.SRC1);
         VecOperandI32 vdst(gpuDynInst, instData.VDST);
@@ -23583,11 +23407,8 @@ namespace Gcn3ISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::max(src0[lane], src1[lane]);
-            }
-        }
+        laneOp(vdst.lanes(), src0.lanes(), src1.lanes(),
+            [](VecElemI32 a, VecElemI32 b) { return std::max(a, b); });
 
         vdst.write();
     }
@@ -23606,7 +23427,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_MIN_U32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandU32 src1(gpuDynInst, extData.SRC1);
         VecOperandU32 vdst(gpuDynInst, instData.VDST);
@@ -23624,11 +23444,8 @@ namespace Gcn3ISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::min(src0[lane], src1[lane]);
-            }
-        }
+        laneOp(vdst.lanes(), src0.lanes(), src1.lanes(),
+            [](VecElemU32 a, VecElemU32 b) { return std::min(a, b); });
 
         vdst.write();
     }
@@ -23647,7 +23464,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_MAX_U32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandU32 src1(gpuDynInst, extData.SRC1);
         VecOperandU32 vdst(gpuDynInst, instData.VDST);
@@ -23665,11 +23481,8 @@ namespace Gcn3ISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::max(src0[lane], src1[lane]);
-            }
-        }
+        laneOp(vdst.lanes(), src0.lanes(), src1.lanes(),
+            [](VecElemU32 a, VecElemU32 b) { return std::max(a, b); });
 
         vdst.write();
     }
@@ -23814,7 +23627,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_AND_B32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandU32 src1(gpuDynInst, extData.SRC1);
         VecOperandU32 vdst(gpuDynInst, instData.VDST);
@@ -23832,11 +23644,8 @@ namespace Gcn3ISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src0[lane] & src1[lane];
-            }
-        }
+        laneOp(vdst.lanes(), src0.lanes(), src1.lanes(),
+            [](VecElemU32 a, VecElemU32 b) { return a & b; });
 
         vdst.write();
     }
@@ -23856,7 +23665,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_OR_B32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandU32 src1(gpuDynInst, extData.SRC1);
         VecOperandU32 vdst(gpuDynInst, instData.VDST);
@@ -23874,11 +23682,8 @@ namespace Gcn3ISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src0[lane] | src1[lane];
-            }
-        }
+        laneOp(vdst.lanes(), src0.lanes(), src1.lanes(),
+            [](VecElemU32 a, VecElemU32 b) { return a | b; });
 
         vdst.write();
     }
@@ -23898,7 +23703,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_XOR_B32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandU32 src1(gpuDynInst, extData.SRC1);
         VecOperandU32 vdst(gpuDynInst, instData.VDST);
@@ -23916,11 +23720,8 @@ namespace Gcn3ISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src0[lane] ^ src1[lane];
-            }
-        }
+        laneOp(vdst.lanes(), src0.lanes(), src1.lanes(),
+            [](VecElemU32 a, VecElemU32 b) { return a ^ b; });
 
         vdst.write();
     }
@@ -23941,7 +23742,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_MAC_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandF32 src1(gpuDynInst, extData.SRC1);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
@@ -23972,11 +23772,9 @@ namespace Gcn3ISA
         assert(!(instData.ABS & 0x4));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::fma(src0[lane], src1[lane], vdst[lane]);
-            }
-        }
+        laneOp(vdst.lanes(), src0.lanes(), src1.lanes(), vdst.lanes(),
+            [](VecElemF32 a, VecElemF32 b, VecElemF32 c)
+            { return std::fma(a, b, c); });
 
         vdst.write();
     }
@@ -24379,7 +24177,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_ADD_U16::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU16 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandU16 src1(gpuDynInst, extData.SRC1);
         VecOperandU16 vdst(gpuDynInst, instData.VDST);
@@ -24397,11 +24194,8 @@ namespace Gcn3ISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src0[lane] + src1[lane];
-            }
-        }
+        laneOp(vdst.lanes(), src0.lanes(), src1.lanes(),
+            [](VecElemU16 a, VecElemU16 b) { return a + b; });
 
         vdst.write();
     }
@@ -24420,7 +24214,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_SUB_U16::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU16 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandU16 src1(gpuDynInst, extData.SRC1);
         VecOperandU16 vdst(gpuDynInst, instData.VDST);
@@ -24438,11 +24231,8 @@ namespace Gcn3ISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src0[lane] - src1[lane];
-            }
-        }
+        laneOp(vdst.lanes(), src0.lanes(), src1.lanes(),
+            [](VecElemU16 a, VecElemU16 b) { return a - b; });
 
         vdst.write();
     }
@@ -24461,7 +24251,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_SUBREV_U16::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU16 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandU16 src1(gpuDynInst, extData.SRC1);
         VecOperandU16 vdst(gpuDynInst, instData.VDST);
@@ -24479,11 +24268,8 @@ namespace Gcn3ISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src1[lane] - src0[lane];
-            }
-        }
+        laneOp(vdst.lanes(), src0.lanes(), src1.lanes(),
+            [](VecElemU16 a, VecElemU16 b) { return b - a; });
 
         vdst.write();
     }
@@ -24502,7 +24288,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_MUL_LO_U16::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU16 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandU16 src1(gpuDynInst, extData.SRC1);
         VecOperandU16 vdst(gpuDynInst, instData.VDST);
@@ -24520,11 +24305,8 @@ namespace Gcn3ISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src0[lane] * src1[lane];
-            }
-        }
+        laneOp(vdst.lanes(), src0.lanes(), src1.lanes(),
+            [](VecElemU16 a, VecElemU16 b) { return a * b; });
 
         vdst.write();
     }
@@ -24710,7 +24492,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_MAX_U16::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU16 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandU16 src1(gpuDynInst, extData.SRC1);
         VecOperandU16 vdst(gpuDynInst, instData.VDST);
@@ -24734,11 +24515,8 @@ namespace Gcn3ISA
             src1.negModifier();
         }
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::max(src0[lane], src1[lane]);
-            }
-        }
+        laneOp(vdst.lanes(), src0.lanes(), src1.lanes(),
+            [](VecElemU16 a, VecElemU16 b) { return std::max(a, b); });
 
         vdst.write();
     }
@@ -24757,7 +24535,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_MAX_I16::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandI16 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandI16 src1(gpuDynInst, extData.SRC1);
         VecOperandI16 vdst(gpuDynInst, instData.VDST);
@@ -24781,11 +24558,8 @@ namespace Gcn3ISA
             src1.negModifier();
         }
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::max(src0[lane], src1[lane]);
-            }
-        }
+        laneOp(vdst.lanes(), src0.lanes(), src1.lanes(),
+            [](VecElemI16 a, VecElemI16 b) { return std::max(a, b); });
 
         vdst.write();
     }
@@ -24804,7 +24578,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_MIN_U16::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU16 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandU16 src1(gpuDynInst, extData.SRC1);
         VecOperandU16 vdst(gpuDynInst, instData.VDST);
@@ -24828,11 +24601,8 @@ namespace Gcn3ISA
             src1.negModifier();
         }
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::min(src0[lane], src1[lane]);
-            }
-        }
+        laneOp(vdst.lanes(), src0.lanes(), src1.lanes(),
+            [](VecElemU16 a, VecElemU16 b) { return std::min(a, b); });
 
         vdst.write();
     }
@@ -24851,7 +24621,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_MIN_I16::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandI16 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandI16 src1(gpuDynInst, extData.SRC1);
         VecOperandI16 vdst(gpuDynInst, instData.VDST);
@@ -24875,11 +24644,8 @@ namespace Gcn3ISA
             src1.negModifier();
         }
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::min(src0[lane], src1[lane]);
-            }
-        }
+        laneOp(vdst.lanes(), src0.lanes(), src1.lanes(),
+            [](VecElemI16 a, VecElemI16 b) { return std::min(a, b); });
 
         vdst.write();
     }
@@ -25008,7 +24774,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_CVT_F64_I32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandI32 src(gpuDynInst, extData.SRC0);
         VecOperandF64 vdst(gpuDynInst, instData.VDST);
 
@@ -25022,11 +24787,8 @@ namespace Gcn3ISA
             src.negModifier();
         }
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = (VecElemF64)src[lane];
-            }
-        }
+        laneOp(vdst.lanes(), src.lanes(),
+            [](VecElemI32 a) { return (VecElemF64)a; });
 
         vdst.write();
     }
@@ -25046,7 +24808,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_CVT_F32_I32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         VecOperandI32 src(gpuDynInst, extData.SRC0);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
 
@@ -25062,11 +24823,8 @@ namespace Gcn3ISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = (VecElemF32)src[lane];
-            }
-        }
+        laneOp(vdst.lanes(), src.lanes(),
+            [](VecElemI32 a) { return (VecElemF32)a; });
 
         vdst.write();
     }
@@ -25086,7 +24844,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_CVT_F32_U32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src(gpuDynInst, extData.SRC0);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
 
@@ -25100,11 +24857,8 @@ namespace Gcn3ISA
             src.negModifier();
         }
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = (VecElemF32)src[lane];
-            }
-        }
+        laneOp(vdst.lanes(), src.lanes(),
+            [](VecElemU32 a) { return (VecElemF32)a; });
 
         vdst.write();
     }
@@ -25370,7 +25124,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_CVT_F32_F64::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF64 src(gpuDynInst, extData.SRC0);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
 
@@ -25392,11 +25145,8 @@ namespace Gcn3ISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = (VecElemF32)src[lane];
-            }
-        }
+        laneOp(vdst.lanes(), src.lanes(),
+            [](VecElemF64 a) { return (VecElemF32)a; });
 
         vdst.write();
     }
@@ -25416,7 +25166,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_CVT_F64_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src(gpuDynInst, extData.SRC0);
         VecOperandF64 vdst(gpuDynInst, instData.VDST);
 
@@ -25438,11 +25187,8 @@ namespace Gcn3ISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = (VecElemF64)src[lane];
-            }
-        }
+        laneOp(vdst.lanes(), src.lanes(),
+            [](VecElemF32 a) { return (VecElemF64)a; });
 
         vdst.write();
     }
@@ -25654,7 +25400,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_CVT_F64_U32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src(gpuDynInst, extData.SRC0);
         VecOperandF64 vdst(gpuDynInst, instData.VDST);
 
@@ -25668,11 +25413,8 @@ namespace Gcn3ISA
             src.negModifier();
         }
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = (VecElemF64)src[lane];
-            }
-        }
+        laneOp(vdst.lanes(), src.lanes(),
+            [](VecElemU32 a) { return (VecElemF64)a; });
 
         vdst.write();
     }
@@ -25692,7 +25434,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_TRUNC_F64::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF64 src(gpuDynInst, extData.SRC0);
         VecOperandF64 vdst(gpuDynInst, instData.VDST);
 
@@ -25706,11 +25447,8 @@ namespace Gcn3ISA
             src.negModifier();
         }
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::trunc(src[lane]);
-            }
-        }
+        laneOp(vdst.lanes(), src.lanes(),
+            [](VecElemF64 a) { return std::trunc(a); });
 
         vdst.write();
     }
@@ -25730,7 +25468,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_CEIL_F64::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF64 src(gpuDynInst, extData.SRC0);
         VecOperandF64 vdst(gpuDynInst, instData.VDST);
 
@@ -25744,11 +25481,8 @@ namespace Gcn3ISA
             src.negModifier();
         }
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::ceil(src[lane]);
-            }
-        }
+        laneOp(vdst.lanes(), src.lanes(),
+            [](VecElemF64 a) { return std::ceil(a); });
 
         vdst.write();
     }
@@ -25806,7 +25540,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_FLOOR_F64::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF64 src(gpuDynInst, extData.SRC0);
         VecOperandF64 vdst(gpuDynInst, instData.VDST);
 
@@ -25820,11 +25553,8 @@ namespace Gcn3ISA
             src.negModifier();
         }
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::floor(src[lane]);
-            }
-        }
+        laneOp(vdst.lanes(), src.lanes(),
+            [](VecElemF64 a) { return std::floor(a); });
 
         vdst.write();
     }
@@ -25883,7 +25613,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_TRUNC_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src(gpuDynInst, extData.SRC0);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
 
@@ -25897,11 +25626,8 @@ namespace Gcn3ISA
             src.negModifier();
         }
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::trunc(src[lane]);
-            }
-        }
+        laneOp(vdst.lanes(), src.lanes(),
+            [](VecElemF32 a) { return std::trunc(a); });
 
         vdst.write();
     }
@@ -25921,7 +25647,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_CEIL_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src(gpuDynInst, extData.SRC0);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
 
@@ -25935,11 +25660,8 @@ namespace Gcn3ISA
             src.negModifier();
         }
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::ceil(src[lane]);
-            }
-        }
+        laneOp(vdst.lanes(), src.lanes(),
+            [](VecElemF32 a) { return std::ceil(a); });
 
         vdst.write();
     }
@@ -25997,7 +25719,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_FLOOR_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src(gpuDynInst, extData.SRC0);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
 
@@ -26011,11 +25732,8 @@ namespace Gcn3ISA
             src.negModifier();
         }
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::floor(src[lane]);
-            }
-        }
+        laneOp(vdst.lanes(), src.lanes(),
+            [](VecElemF32 a) { return std::floor(a); });
 
         vdst.write();
     }
@@ -26119,7 +25837,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_RCP_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src(gpuDynInst, extData.SRC0);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
 
@@ -26133,11 +25850,8 @@ namespace Gcn3ISA
             src.negModifier();
         }
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = 1.0 / src[lane];
-            }
-        }
+        laneOp(vdst.lanes(), src.lanes(),
+            [](VecElemF32 a) { return 1.0 / a; });
 
         vdst.write();
     }
@@ -26331,7 +26045,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_SQRT_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src(gpuDynInst, extData.SRC0);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
 
@@ -26345,11 +26058,8 @@ namespace Gcn3ISA
             src.negModifier();
         }
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::sqrt(src[lane]);
-            }
-        }
+        laneOp(vdst.lanes(), src.lanes(),
+            [](VecElemF32 a) { return std::sqrt(a); });
 
         vdst.write();
     }
@@ -26369,7 +26079,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_SQRT_F64::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF64 src(gpuDynInst, extData.SRC0);
         VecOperandF64 vdst(gpuDynInst, instData.VDST);
 
@@ -26383,11 +26092,8 @@ namespace Gcn3ISA
             src.negModifier();
         }
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::sqrt(src[lane]);
-            }
-        }
+        laneOp(vdst.lanes(), src.lanes(),
+            [](VecElemF64 a) { return std::sqrt(a); });
 
         vdst.write();
     }
@@ -26487,17 +26193,13 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_NOT_B32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src(gpuDynInst, extData.SRC0);
         VecOperandU32 vdst(gpuDynInst, instData.VDST);
 
         src.readSrc();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = ~src[lane];
-            }
-        }
+        laneOp(vdst.lanes(), src.lanes(),
+            [](VecElemU32 a) { return ~a; });
 
         vdst.write();
     }
@@ -27307,7 +27009,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_MAD_LEGACY_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandF32 src1(gpuDynInst, extData.SRC1);
         ConstVecOperandF32 src2(gpuDynInst, extData.SRC2);
@@ -27341,11 +27042,9 @@ namespace Gcn3ISA
             src2.negModifier();
         }
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::fma(src0[lane], src1[lane], src2[lane]);
-            }
-        }
+        laneOp(vdst.lanes(), src0.lanes(), src1.lanes(), src2.lanes(),
+            [](VecElemF32 a, VecElemF32 b, VecElemF32 c)
+            { return std::fma(a, b, c); });
 
         vdst.write();
     }
@@ -27366,7 +27065,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_MAD_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandF32 src1(gpuDynInst, extData.SRC1);
         ConstVecOperandF32 src2(gpuDynInst, extData.SRC2);
@@ -27400,11 +27098,9 @@ namespace Gcn3ISA
             src2.negModifier();
         }
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::fma(src0[lane], src1[lane], src2[lane]);
-            }
-        }
+        laneOp(vdst.lanes(), src0.lanes(), src1.lanes(), src2.lanes(),
+            [](VecElemF32 a, VecElemF32 b, VecElemF32 c)
+            { return std::fma(a, b, c); });
 
         vdst.write();
     }
@@ -27671,7 +27367,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_BFI_B32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandU32 src1(gpuDynInst, extData.SRC1);
         ConstVecOperandU32 src2(gpuDynInst, extData.SRC2);
@@ -27691,12 +27386,9 @@ namespace Gcn3ISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = (src0[lane] & src1[lane]) | (~src0[lane]
-                    & src2[lane]);
-            }
-        }
+        laneOp(vdst.lanes(), src0.lanes(), src1.lanes(), src2.lanes(),
+            [](VecElemU32 a, VecElemU32 b, VecElemU32 c)
+            { return (a & b) | (~a & c); });
 
         vdst.write();
     }
@@ -27717,7 +27409,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_FMA_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandF32 src1(gpuDynInst, extData.SRC1);
         ConstVecOperandF32 src2(gpuDynInst, extData.SRC2);
@@ -27751,11 +27442,9 @@ namespace Gcn3ISA
             src2.negModifier();
         }
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::fma(src0[lane], src1[lane], src2[lane]);
-            }
-        }
+        laneOp(vdst.lanes(), src0.lanes(), src1.lanes(), src2.lanes(),
+            [](VecElemF32 a, VecElemF32 b, VecElemF32 c)
+            { return std::fma(a, b, c); });
 
         vdst.write();
     }
@@ -27776,7 +27465,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_FMA_F64::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF64 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandF64 src1(gpuDynInst, extData.SRC1);
         ConstVecOperandF64 src2(gpuDynInst, extData.SRC2);
@@ -27810,11 +27498,9 @@ namespace Gcn3ISA
             src2.negModifier();
         }
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::fma(src0[lane], src1[lane], src2[lane]);
-            }
-        }
+        laneOp(vdst.lanes(), src0.lanes(), src1.lanes(), src2.lanes(),
+            [](VecElemF64 a, VecElemF64 b, VecElemF64 c)
+            { return std::fma(a, b, c); });
 
         vdst.write();
     }
@@ -29784,7 +29470,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_MIN_F64::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF64 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandF64 src1(gpuDynInst, extData.SRC1);
         VecOperandF64 vdst(gpuDynInst, instData.VDST);
@@ -29814,11 +29499,8 @@ namespace Gcn3ISA
         assert(!(instData.ABS & 0x4));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::fmin(src0[lane], src1[lane]);
-            }
-        }
+        laneOp(vdst.lanes(), src0.lanes(), src1.lanes(),
+            [](VecElemF64 a, VecElemF64 b) { return std::fmin(a, b); });
 
         vdst.write();
     }
@@ -29838,7 +29520,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_MAX_F64::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF64 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandF64 src1(gpuDynInst, extData.SRC1);
         VecOperandF64 vdst(gpuDynInst, instData.VDST);
@@ -29868,11 +29549,8 @@ namespace Gcn3ISA
         assert(!(instData.ABS & 0x4));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::fmax(src0[lane], src1[lane]);
-            }
-        }
+        laneOp(vdst.lanes(), src0.lanes(), src1.lanes(),
+            [](VecElemF64 a, VecElemF64 b) { return std::fmax(a, b); });
 
         vdst.write();
     }
@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __ARCH_GCN3_INSTS_LANE_OP_HH__
+#define __ARCH_GCN3_INSTS_LANE_OP_HH__
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <type_traits>
+
+#include "arch/gcn3/registers.hh"
+
+namespace Gcn3ISA
+{
+    /**
+     * laneOp applies a lane-wise operation to all lanes of its operands,
+     * which are the per-lane arrays returned by VecOperand::lanes().
+     *
+     * unlike the usual execute() loop, the EXEC mask is not checked for
+     * each lane: VecOperand::write() only updates the register file for
+     * active lanes, so inactive lanes may be computed and discarded. this
+     * leaves a branch free loop over plain arrays, which the compiler is
+     * able to vectorize. as inactive lanes may hold any value, laneOp may
+     * only be used for operations that have no side effects and are well
+     * defined for all inputs (e.g., no signed overflow or division).
+     */
+    template<typename DstT, typename SrcT, typename Op>
+    inline void
+    laneOp(DstT *dst, const SrcT *src, Op op)
+    {
+        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
+            dst[lane] = op(src[lane]);
+        }
+    }
+
+    template<typename DstT, typename Src0T, typename Src1T, typename Op>
+    inline void
+    laneOp(DstT *dst, const Src0T *src0, const Src1T *src1, Op op)
+    {
+        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
+            dst[lane] = op(src0[lane], src1[lane]);
+        }
+    }
+
+    template<typename DstT, typename Src0T, typename Src1T, typename Src2T,
+             typename Op>
+    inline void
+    laneOp(DstT *dst, const Src0T *src0, const Src1T *src1,
+           const Src2T *src2, Op op)
+    {
+        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
+            dst[lane] = op(src0[lane], src1[lane], src2[lane]);
+        }
+    }
+
+    /**
+     * copy all lanes of a 32b vector register into the lanes of an
+     * operand, which may be narrower than a dword, in which case only the
+     * low bytes of each register lane are used.
+     */
+    template<typename T>
+    inline void
+    readVgprLanes(T *lanes, const VecElemU32 *vgpr)
+    {
+        if (sizeof(T) == sizeof(VecElemU32)) {
+            std::memcpy(lanes, vgpr, NumVecElemPerVecReg * sizeof(T));
+        } else {
+            for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
+                std::memcpy((void*)&lanes[lane], (void*)&vgpr[lane],
+                    sizeof(T));
+            }
+        }
+    }
+
+    /**
+     * copy the lanes of an operand into a 32b vector register. only the
+     * lanes that are set in the exec mask are written, unless all_lanes
+     * is set, so inactive lanes keep their old value. narrow operands
+     * only update the low bytes of each register lane.
+     */
+    template<typename T, typename Mask>
+    inline void
+    writeVgprLanes(VecElemU32 *vgpr, const T *lanes, const Mask &exec_mask,
+                   bool all_lanes)
+    {
+        if (sizeof(T) == sizeof(VecElemU32) && all_lanes) {
+            // all lanes are written, copy the register as a block
+            std::memcpy(vgpr, lanes, NumVecElemPerVecReg * sizeof(T));
+        } else {
+            for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
+                if (all_lanes || exec_mask[lane]) {
+                    std::memcpy((void*)&vgpr[lane], (void*)&lanes[lane],
+                        sizeof(T));
+                }
+            }
+        }
+    }
+
+    /**
+     * prepare the lanes of a source operand for laneOp(), this is the
+     * implementation of VecOperand::lanes() for source operands. a 32b
+     * source is read in place, in_place then points at the lanes in the
+     * register file, and it is returned as is unless a modifier has to be
+     * applied. otherwise the lanes are in buf, where a scalar source is
+     * broadcast to all lanes and the abs/neg modifiers are applied to
+     * each lane. the register file itself is never modified. the state
+     * that has been applied to buf is cleared, so the operand's
+     * operator[] sees the final values and a second call does nothing.
+     */
+    template<typename T, typename LaneT>
+    inline LaneT*
+    srcOperandLanes(T *buf, LaneT *&in_place, bool &scalar, T scalar_val,
+                    bool &abs_mod, bool &neg_mod)
+    {
+        if (in_place) {
+            if (!abs_mod && !neg_mod) {
+                return in_place;
+            }
+            // the modifiers are applied to a private copy
+            std::copy(in_place, in_place + NumVecElemPerVecReg, buf);
+            in_place = nullptr;
+        }
+
+        if (scalar) {
+            std::fill(buf, buf + NumVecElemPerVecReg, scalar_val);
+            scalar = false;
+        }
+
+        if (abs_mod) {
+            assert(std::is_floating_point<T>::value);
+            for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
+                buf[lane] = std::fabs(buf[lane]);
+            }
+            abs_mod = false;
+        }
+
+        if (neg_mod) {
+            assert(std::is_floating_point<T>::value);
+            for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
+                buf[lane] = -buf[lane];
+            }
+            neg_mod = false;
+        }
+
+        return buf;
+    }
+} // namespace Gcn3ISA
+
+#endif // __ARCH_GCN3_INSTS_LANE_OP_HH__
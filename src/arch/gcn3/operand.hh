@@ -36,8 +36,11 @@
 #ifndef __ARCH_GCN3_OPERAND_HH__
 #define __ARCH_GCN3_OPERAND_HH__
 
+#include <algorithm>
 #include <array>
+#include <type_traits>
 
+#include "arch/gcn3/insts/lane_op.hh"
 #include "arch/gcn3/registers.hh"
 #include "arch/generic/vec_reg.hh"
 #include "gpu-compute/scalar_register_file.hh"
@@ -110,9 +113,12 @@ namespace Gcn3ISA
         VecOperand(GPUDynInstPtr gpuDynInst, int opIdx)
             : Operand(gpuDynInst, opIdx), scalar(false), absMod(false),
               negMod(false), scRegData(gpuDynInst, _opIdx),
-              vrfData{{ nullptr }}
+              vrfData{{ nullptr }}, srcLanes(nullptr)
         {
-            vecReg.zero();
+            // src operands are always read in full before they are used
+            if (!Const) {
+                vecReg.zero();
+            }
         }
 
         ~VecOperand()
@@ -162,11 +168,12 @@ namespace Gcn3ISA
 
             if (NumDwords == 1) {
                 assert(vrfData[0]);
-                auto vgpr = vecReg.template as<DataType>();
-                auto reg_file_vgpr = vrfData[0]->template as<VecElemU32>();
-                for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-                    std::memcpy((void*)&vgpr[lane],
-                        (void*)&reg_file_vgpr[lane], sizeof(DataType));
+                if (Const && sizeof(DataType) == sizeof(VecElemU32)) {
+                    // src operands read the register file in place
+                    srcLanes = vrfData[0]->template raw_ptr<DataType>();
+                } else {
+                    readVgprLanes(vecReg.template raw_ptr<DataType>(),
+                        vrfData[0]->template raw_ptr<VecElemU32>());
                 }
             } else if (NumDwords == 2) {
                 assert(vrfData[0]);
@@ -210,15 +217,9 @@ namespace Gcn3ISA
                 int vgprIdx = cu->registerManager.mapVgpr(wf, _opIdx);
                 vrfData[0] = &cu->vrf[wf->simdId]->readWriteable(vgprIdx);
                 assert(vrfData[0]);
-                auto reg_file_vgpr = vrfData[0]->template as<VecElemU32>();
-                auto vgpr = vecReg.template as<DataType>();
-
-                for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-                    if (exec_mask[lane] || _gpuDynInst->ignoreExec()) {
-                        std::memcpy((void*)&reg_file_vgpr[lane],
-                            (void*)&vgpr[lane], sizeof(DataType));
-                    }
-                }
+                writeVgprLanes(vrfData[0]->template raw_ptr<VecElemU32>(),
+                    vecReg.template raw_ptr<DataType>(), exec_mask,
+                    exec_mask.all() || _gpuDynInst->ignoreExec());
 
                 DPRINTF(GPUVRF, "Write v[%d]\n", vgprIdx);
                 cu->vrf[wf->simdId]->printReg(wf, vgprIdx);
@@ -284,8 +285,8 @@ namespace Gcn3ISA
 
                 return ret_val;
             } else {
-                auto vgpr = vecReg.template as<DataType>();
-                DataType ret_val = vgpr[idx];
+                DataType ret_val = srcLanes ? srcLanes[idx]
+                    : vecReg.template as<DataType>()[idx];
 
                 if (absMod) {
                     assert(std::is_floating_point<DataType>::value);
@@ -316,6 +317,35 @@ namespace Gcn3ISA
             return vecReg.template as<DataType>()[idx];
         }
 
+        using LaneType = typename std::conditional<Const, const DataType,
+                                                   DataType>::type;
+
+        /**
+         * return a pointer to the data of all lanes of this operand, so
+         * an instruction may operate on them with a plain loop that the
+         * compiler can vectorize (see laneOp() in insts/lane_op.hh).
+         * for source operands any scalar value is first broadcast to all
+         * lanes, and the abs/neg modifiers are applied to the lanes once
+         * here, rather than by operator[] on every access (see
+         * srcOperandLanes()).
+         */
+        LaneType*
+        lanes()
+        {
+            static_assert(NumDwords == 1 || NumDwords == 2,
+                          "lanes() only supports 8b to 64b operands");
+
+            DataType *vgpr = vecReg.template raw_ptr<DataType>();
+
+            if (Const) {
+                return srcOperandLanes(vgpr, srcLanes, scalar,
+                                       scRegData.rawData(), absMod, negMod);
+            }
+
+            assert(!scalar);
+            return vgpr;
+        }
+
         private:
           /**
            * if we determine that this operand is a scalar (reg or constant)
@@ -363,6 +393,13 @@ namespace Gcn3ISA
            * registers in the register file).
            */
           std::array<VecRegContainerU32*, NumDwords> vrfData;
+          /**
+           * 32b src operands are not copied out of the register file,
+           * this points directly at the lanes of the source register.
+           * it is only valid for the duration of the instruction's
+           * execute(), before any of its dst operands are written.
+           */
+          LaneType *srcLanes;
     };
 
     template<typename DataType, bool Const,
@@ -0,0 +1,469 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <bitset>
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "arch/gcn3/insts/lane_op.hh"
+#include "base/gtest/benchmark.hh"
+
+using namespace Gcn3ISA;
+
+namespace {
+
+typedef std::bitset<NumVecElemPerVecReg> LaneMask;
+
+const int numLanes = NumVecElemPerVecReg;
+
+/**
+ * the per-lane loop VALU instructions used before laneOp: only active
+ * lanes are computed, and they are written to the destination in place.
+ */
+template<typename DstT, typename Src0T, typename Src1T, typename Op>
+void
+maskedLoop(DstT *dst, const Src0T *src0, const Src1T *src1,
+           const LaneMask &mask, Op op)
+{
+    for (int lane = 0; lane < numLanes; ++lane) {
+        if (mask[lane]) {
+            dst[lane] = op(src0[lane], src1[lane]);
+        }
+    }
+}
+
+template<typename DstT, typename Src0T, typename Src1T, typename Src2T,
+         typename Op>
+void
+maskedLoop(DstT *dst, const Src0T *src0, const Src1T *src1,
+           const Src2T *src2, const LaneMask &mask, Op op)
+{
+    for (int lane = 0; lane < numLanes; ++lane) {
+        if (mask[lane]) {
+            dst[lane] = op(src0[lane], src1[lane], src2[lane]);
+        }
+    }
+}
+
+/**
+ * the write-back of a laneOp result, which only updates active lanes
+ */
+template<typename T>
+void
+maskedWrite(T *dst, const T *lanes, const LaneMask &mask)
+{
+    for (int lane = 0; lane < numLanes; ++lane) {
+        if (mask[lane]) {
+            dst[lane] = lanes[lane];
+        }
+    }
+}
+
+std::vector<LaneMask>
+testMasks(std::mt19937 &rng)
+{
+    std::vector<LaneMask> masks;
+    masks.push_back(LaneMask());
+    masks.push_back(LaneMask().set());
+    masks.push_back(LaneMask(1));
+    masks.push_back(LaneMask(0x5555555555555555ULL));
+    masks.push_back(LaneMask(0x00000000ffffffffULL));
+    masks.push_back(LaneMask().set().reset(numLanes - 1));
+    for (int i = 0; i < 8; ++i) {
+        masks.push_back(LaneMask((uint64_t)rng() << 32 | rng()));
+    }
+    return masks;
+}
+
+template<typename T>
+void
+fill(T *lanes, std::mt19937 &rng)
+{
+    for (int lane = 0; lane < numLanes; ++lane) {
+        lanes[lane] = (T)rng();
+    }
+}
+
+void
+fill(VecElemF32 *lanes, std::mt19937 &rng)
+{
+    std::uniform_real_distribution<VecElemF32> dist(-1000.0, 1000.0);
+    for (int lane = 0; lane < numLanes; ++lane) {
+        lanes[lane] = dist(rng);
+    }
+}
+
+struct AddF32
+{
+    VecElemF32
+    operator()(VecElemF32 a, VecElemF32 b) const
+    {
+        return a + b;
+    }
+};
+
+struct FmaF32
+{
+    VecElemF32
+    operator()(VecElemF32 a, VecElemF32 b, VecElemF32 c) const
+    {
+        return std::fma(a, b, c);
+    }
+};
+
+} // anonymous namespace
+
+TEST(LaneOpTest, KnownValues)
+{
+    VecElemF32 a[numLanes], b[numLanes], c[numLanes], dst[numLanes];
+    VecElemU16 h[numLanes], hdst[numLanes];
+    VecElemU32 u[numLanes], udst[numLanes];
+
+    for (int lane = 0; lane < numLanes; ++lane) {
+        a[lane] = lane;
+        b[lane] = 0.5f;
+        c[lane] = -1.0f;
+        h[lane] = 0xfff0 + lane;
+        u[lane] = 1u << (lane % 32);
+    }
+
+    laneOp(dst, a, b, AddF32());
+    for (int lane = 0; lane < numLanes; ++lane) {
+        EXPECT_EQ(lane + 0.5f, dst[lane]);
+    }
+
+    laneOp(dst, a, b, c, FmaF32());
+    for (int lane = 0; lane < numLanes; ++lane) {
+        EXPECT_EQ(lane * 0.5f - 1.0f, dst[lane]);
+    }
+
+    // 16b adds wrap around
+    laneOp(hdst, h, h, [](VecElemU16 x, VecElemU16 y)
+        { return (VecElemU16)(x + y); });
+    for (int lane = 0; lane < numLanes; ++lane) {
+        EXPECT_EQ((VecElemU16)(0xffe0 + 2 * lane), hdst[lane]);
+    }
+
+    laneOp(udst, u, [](VecElemU32 x) { return ~x; });
+    for (int lane = 0; lane < numLanes; ++lane) {
+        EXPECT_EQ(0xffffffffu ^ (1u << (lane % 32)), udst[lane]);
+    }
+}
+
+TEST(SrcOperandLanesTest, ScalarBroadcast)
+{
+    VecElemU32 buf[numLanes] = { };
+    const VecElemU32 *in_place = nullptr;
+    bool scalar = true, abs_mod = false, neg_mod = false;
+
+    const VecElemU32 *lanes = srcOperandLanes(buf, in_place, scalar,
+        (VecElemU32)0x1234, abs_mod, neg_mod);
+
+    EXPECT_EQ(buf, lanes);
+    EXPECT_FALSE(scalar);
+    for (int lane = 0; lane < numLanes; ++lane) {
+        EXPECT_EQ(0x1234, lanes[lane]);
+    }
+}
+
+TEST(SrcOperandLanesTest, AbsNegModifiers)
+{
+    const bool mods[3][2] = { { true, false }, { false, true },
+                              { true, true } };
+
+    for (auto &mod : mods) {
+        VecElemF32 buf[numLanes];
+        for (int lane = 0; lane < numLanes; ++lane) {
+            buf[lane] = (lane - 32) * 1.5f;
+        }
+        const VecElemF32 *in_place = nullptr;
+        bool scalar = false, abs_mod = mod[0], neg_mod = mod[1];
+
+        const VecElemF32 *lanes = srcOperandLanes(buf, in_place, scalar,
+            0.0f, abs_mod, neg_mod);
+
+        EXPECT_EQ(buf, lanes);
+        EXPECT_FALSE(abs_mod);
+        EXPECT_FALSE(neg_mod);
+        for (int lane = 0; lane < numLanes; ++lane) {
+            VecElemF32 val = (lane - 32) * 1.5f;
+            VecElemF32 expected = mod[0] ? std::fabs(val) : val;
+            expected = mod[1] ? -expected : expected;
+            EXPECT_EQ(expected, lanes[lane]) << "lane " << lane;
+        }
+    }
+}
+
+TEST(SrcOperandLanesTest, ScalarWithModifiers)
+{
+    VecElemF32 buf[numLanes];
+    const VecElemF32 *in_place = nullptr;
+    bool scalar = true, abs_mod = true, neg_mod = true;
+
+    // -|s| for s = 2.5
+    const VecElemF32 *lanes = srcOperandLanes(buf, in_place, scalar,
+        2.5f, abs_mod, neg_mod);
+
+    for (int lane = 0; lane < numLanes; ++lane) {
+        EXPECT_EQ(-2.5f, lanes[lane]);
+    }
+}
+
+/**
+ * v_add_f32 v2, -s0, v1 as executed with laneOp: src0 is a scalar with
+ * the neg modifier, src1 is read in place from its register, and the
+ * result is written back to the active lanes of v2 only.
+ */
+TEST(LaneOpTest, AddF32ExecMaskWriteBack)
+{
+    VecRegContainerU32 v1, v2;
+    for (int lane = 0; lane < numLanes; ++lane) {
+        v1.raw_ptr<VecElemF32>()[lane] = lane;
+        v2.raw_ptr<VecElemU32>()[lane] = 0xdeadbeef;
+    }
+
+    VecElemF32 src0_buf[numLanes];
+    const VecElemF32 *src0_in_place = nullptr;
+    bool src0_scalar = true, src0_abs = false, src0_neg = true;
+    const VecElemF32 *src0 = srcOperandLanes(src0_buf, src0_in_place,
+        src0_scalar, 2.0f, src0_abs, src0_neg);
+
+    VecElemF32 src1_buf[numLanes];
+    const VecElemF32 *src1_in_place = v1.raw_ptr<VecElemF32>();
+    bool src1_scalar = false, src1_abs = false, src1_neg = false;
+    const VecElemF32 *src1 = srcOperandLanes(src1_buf, src1_in_place,
+        src1_scalar, 0.0f, src1_abs, src1_neg);
+
+    VecElemF32 vdst[numLanes];
+    laneOp(vdst, src0, src1, AddF32());
+
+    const LaneMask exec_mask(0x00000000ffff00ffULL);
+    writeVgprLanes(v2.raw_ptr<VecElemU32>(), vdst, exec_mask,
+                   exec_mask.all());
+
+    for (int lane = 0; lane < numLanes; ++lane) {
+        if (exec_mask[lane]) {
+            EXPECT_EQ(lane - 2.0f, v2.raw_ptr<VecElemF32>()[lane])
+                << "lane " << lane;
+        } else {
+            EXPECT_EQ(0xdeadbeef, v2.raw_ptr<VecElemU32>()[lane])
+                << "lane " << lane;
+        }
+    }
+}
+
+TEST(VgprLanesTest, ReadNarrowLanes)
+{
+    std::mt19937 rng(5);
+    VecElemU32 vgpr[numLanes];
+    VecElemU16 lanes[numLanes];
+    VecElemF32 flanes[numLanes];
+    fill(vgpr, rng);
+
+    readVgprLanes(lanes, vgpr);
+    readVgprLanes(flanes, vgpr);
+
+    for (int lane = 0; lane < numLanes; ++lane) {
+        EXPECT_EQ((VecElemU16)vgpr[lane], lanes[lane]);
+        EXPECT_EQ(0, std::memcmp(&vgpr[lane], &flanes[lane],
+                                 sizeof(VecElemF32)));
+    }
+}
+
+namespace {
+
+/**
+ * write lanes to a vgpr and check that only the active lanes changed,
+ * and that narrow lanes only changed the low bytes of a register lane
+ */
+template<typename T>
+void
+checkPartialWrite()
+{
+    std::mt19937 rng(6);
+    VecElemU32 vgpr[numLanes], orig[numLanes];
+    T lanes[numLanes];
+
+    for (const LaneMask &mask : testMasks(rng)) {
+        fill(orig, rng);
+        fill(lanes, rng);
+        std::memcpy(vgpr, orig, sizeof(vgpr));
+
+        writeVgprLanes(vgpr, lanes, mask, mask.all());
+
+        for (int lane = 0; lane < numLanes; ++lane) {
+            VecElemU32 expected = orig[lane];
+            if (mask[lane]) {
+                std::memcpy(&expected, &lanes[lane], sizeof(T));
+            }
+            EXPECT_EQ(expected, vgpr[lane])
+                << "lane " << lane << " exec mask " << mask;
+        }
+    }
+}
+
+} // anonymous namespace
+
+TEST(VgprLanesTest, PartialWriteKeepsInactiveLanes)
+{
+    checkPartialWrite<VecElemF32>();
+    checkPartialWrite<VecElemU32>();
+    checkPartialWrite<VecElemU16>();
+    checkPartialWrite<VecElemU8>();
+}
+
+TEST(VgprLanesTest, IgnoreExecWritesAllLanes)
+{
+    std::mt19937 rng(7);
+    VecElemU32 vgpr[numLanes];
+    VecElemF32 lanes[numLanes];
+    fill(vgpr, rng);
+    fill(lanes, rng);
+
+    writeVgprLanes(vgpr, lanes, LaneMask(), true);
+
+    EXPECT_EQ(0, std::memcmp(vgpr, lanes, sizeof(vgpr)));
+}
+
+/**
+ * a 32b source that is read in place and has no modifiers is used
+ * straight from the register file, without copying it.
+ */
+TEST(SrcOperandLanesTest, ZeroCopyReadsRegisterInPlace)
+{
+    VecRegContainerU32 vgpr;
+    VecElemF32 buf[numLanes];
+    for (int lane = 0; lane < numLanes; ++lane) {
+        vgpr.raw_ptr<VecElemF32>()[lane] = lane;
+        buf[lane] = -1.0f;
+    }
+
+    const VecElemF32 *in_place = vgpr.raw_ptr<VecElemF32>();
+    bool scalar = false, abs_mod = false, neg_mod = false;
+
+    const VecElemF32 *lanes = srcOperandLanes(buf, in_place, scalar, 0.0f,
+        abs_mod, neg_mod);
+
+    EXPECT_EQ(vgpr.raw_ptr<VecElemF32>(), lanes);
+    EXPECT_EQ(vgpr.raw_ptr<VecElemF32>(), in_place);
+    for (int lane = 0; lane < numLanes; ++lane) {
+        EXPECT_EQ(-1.0f, buf[lane]);
+    }
+
+    // integer sources are read in place as well
+    VecElemU32 ubuf[numLanes];
+    const VecElemU32 *u_in_place = vgpr.raw_ptr<VecElemU32>();
+    EXPECT_EQ(vgpr.raw_ptr<VecElemU32>(), srcOperandLanes(ubuf, u_in_place,
+        scalar, (VecElemU32)0, abs_mod, neg_mod));
+}
+
+/**
+ * a modifier on a source that is read in place falls back to a copy,
+ * the register itself must not be modified, and the modifiers must not
+ * be applied twice if lanes() is called again.
+ */
+TEST(SrcOperandLanesTest, ModifiersCopyLeavesRegisterIntact)
+{
+    VecRegContainerU32 vgpr;
+    vgpr.zero();
+    for (int lane = 0; lane < numLanes; ++lane) {
+        vgpr.raw_ptr<VecElemF32>()[lane] = lane - 32.0f;
+    }
+    VecRegContainerU32 orig = vgpr;
+
+    VecElemF32 buf[numLanes];
+    const VecElemF32 *in_place = vgpr.raw_ptr<VecElemF32>();
+    bool scalar = false, abs_mod = true, neg_mod = true;
+
+    const VecElemF32 *lanes = srcOperandLanes(buf, in_place, scalar, 0.0f,
+        abs_mod, neg_mod);
+
+    EXPECT_EQ(buf, lanes);
+    EXPECT_EQ(nullptr, in_place);
+    EXPECT_TRUE(vgpr == orig);
+    for (int lane = 0; lane < numLanes; ++lane) {
+        EXPECT_EQ(-std::fabs(lane - 32.0f), lanes[lane]);
+    }
+
+    lanes = srcOperandLanes(buf, in_place, scalar, 0.0f, abs_mod, neg_mod);
+
+    EXPECT_EQ(buf, lanes);
+    for (int lane = 0; lane < numLanes; ++lane) {
+        EXPECT_EQ(-std::fabs(lane - 32.0f), lanes[lane]);
+    }
+}
+
+// Simulated VALU instructions per host second for a partial exec mask.
+// Disabled by default, run with --gtest_also_run_disabled_tests.
+TEST(LaneOpTest, DISABLED_InstThroughput)
+{
+    const int iters = 2000000;
+    std::mt19937 rng(4);
+    VecElemF32 src0[numLanes], src1[numLanes], src2[numLanes];
+    VecElemF32 dst[numLanes], result[numLanes];
+    fill(src0, rng);
+    fill(src1, rng);
+    fill(src2, rng);
+    const LaneMask mask(0x7fffffffffffffffULL);
+
+    volatile VecElemF32 sink = 0;
+
+    recordThroughput("v_add_f32_masked_loop_per_second", iters, [&]() {
+        for (int i = 0; i < iters; ++i) {
+            maskedLoop(dst, src0, src1, mask, AddF32());
+            sink = dst[0];
+        }
+    });
+    recordThroughput("v_add_f32_lane_op_per_second", iters, [&]() {
+        for (int i = 0; i < iters; ++i) {
+            laneOp(result, src0, src1, AddF32());
+            maskedWrite(dst, result, mask);
+            sink = dst[0];
+        }
+    });
+    recordThroughput("v_fma_f32_masked_loop_per_second", iters, [&]() {
+        for (int i = 0; i < iters; ++i) {
+            maskedLoop(dst, src0, src1, src2, mask, FmaF32());
+            sink = dst[0];
+        }
+    });
+    recordThroughput("v_fma_f32_lane_op_per_second", iters, [&]() {
+        for (int i = 0; i < iters; ++i) {
+            laneOp(result, src0, src1, src2, FmaF32());
+            maskedWrite(dst, result, mask);
+            sink = dst[0];
+        }
+    });
+
+    (void)sink;
+}
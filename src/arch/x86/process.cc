@@ -100,10 +100,6 @@ template class MultiLevelPageTable<LongModePTE<47, 39>,
                                    LongModePTE<38, 30>,
                                    LongModePTE<29, 21>,
                                    LongModePTE<20, 12> >;
-typedef MultiLevelPageTable<LongModePTE<47, 39>,
-                            LongModePTE<38, 30>,
-                            LongModePTE<29, 21>,
-                            LongModePTE<20, 12> > ArchPageTable;
 
 X86Process::X86Process(ProcessParams *params, ObjectFile *objFile,
                        SyscallDesc *_syscallDescs, int _numSyscallDescs)
@@ -143,6 +139,13 @@ X86_64Process::X86_64Process(ProcessParams *params, ObjectFile *objFile,
                                                   params->system, PageBytes)) :
                    make_shared<EmulationPageTable>(params->name, params->pid,
                                                    PageBytes);
+
+    // long mode supports 2MB and 1GB pages
+    if (params->useLargePages) {
+        p_table->addLargePageSize(2 * 1024 * 1024);
+        p_table->addLargePageSize(1024 * 1024 * 1024);
+    }
+
     memState = make_shared<MemState>(this, brk_point, stack_base,
                                      max_stack_size, next_thread_stack_base,
                                      mmap_end, params->system, p_table);
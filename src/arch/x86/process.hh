@@ -57,6 +57,15 @@ namespace X86ISA
         M5_AT_SYSINFO_EHDR = 33
     };
 
+    /**
+     * The in-memory, 4-level x86-64 page table that is maintained for
+     * processes with useArchPT set.
+     */
+    typedef MultiLevelPageTable<LongModePTE<47, 39>,
+                                LongModePTE<38, 30>,
+                                LongModePTE<29, 21>,
+                                LongModePTE<20, 12> > ArchPageTable;
+
     class X86Process : public Process
     {
       protected:
@@ -113,6 +113,6 @@ HSADriver::allocateQueue(const SETranslatingPortProxy &mem_proxy, Addr ioc_buf)
     auto &hsa_pp = device->hsaPacketProc();
     hsa_pp.setDeviceQueueDesc(args->read_pointer_address,
                               args->ring_base_address, args->queue_id,
-                              args->ring_size);
+                              args->ring_size, args->queue_priority);
     args.copyOut(mem_proxy);
 }
@@ -39,6 +39,7 @@
 
 #include "base/chunk_generator.hh"
 #include "base/compiler.hh"
+#include "debug/Drain.hh"
 #include "debug/HSAPacketProcessor.hh"
 #include "dev/dma_device.hh"
 #include "dev/hsa/hsa_device.hh"
@@ -99,13 +100,44 @@ void
 HSAPacketProcessor::setDeviceQueueDesc(uint64_t hostReadIndexPointer,
                                        uint64_t basePointer,
                                        uint64_t queue_id,
-                                       uint32_t size)
+                                       uint32_t size,
+                                       uint32_t priority)
 {
     DPRINTF(HSAPacketProcessor,
-             "%s:base = %p, qID = %d, ze = %d\n", __FUNCTION__,
-             (void *)basePointer, queue_id, size);
+             "%s:base = %p, qID = %d, ze = %d, prio = %d\n", __FUNCTION__,
+             (void *)basePointer, queue_id, size, priority);
     hwSchdlr->registerNewQueue(hostReadIndexPointer,
-                               basePointer, queue_id, size);
+                               basePointer, queue_id, size, priority);
+}
+
+void
+HSAPacketProcessor::setQueuePriority(uint64_t queue_id, uint32_t priority)
+{
+    DPRINTF(HSAPacketProcessor, "%s: qID = %d, prio = %d\n", __FUNCTION__,
+            queue_id, priority);
+    HSAQueueDescriptor *q_desc = hwSchdlr->queueDesc(queue_id);
+    if (!q_desc) {
+        warn("Ignoring priority update of unknown queue %d", queue_id);
+        return;
+    }
+    q_desc->priority = priority;
+    // a queue may now outrank one of the mapped queues
+    hwSchdlr->schedWakeup();
+}
+
+void
+HSAPacketProcessor::setQueueCuMask(uint64_t queue_id,
+                                   const std::vector<bool> &mask)
+{
+    DPRINTF(HSAPacketProcessor, "%s: qID = %d, %d CUs\n", __FUNCTION__,
+            queue_id, mask.size());
+    // the mask only applies to kernels submitted after it is set
+    HSAQueueDescriptor *q_desc = hwSchdlr->queueDesc(queue_id);
+    if (!q_desc) {
+        warn("Ignoring CU mask of unknown queue %d", queue_id);
+        return;
+    }
+    q_desc->cuMask = mask;
 }
 
 AddrRangeList
@@ -278,6 +310,7 @@ HSAPacketProcessor::CmdQueueCmdDmaEvent::process()
             // schedule queue wakeup
             hsaPP->schedAQLProcessing(rl_idx);
             delete series_ctx;
+            hsaPP->checkDrain();
         }
     }
 }
@@ -359,7 +392,7 @@ HSAPacketProcessor::processPkt(void* pkt, uint32_t rl_idx, Addr host_pkt_addr)
                         // This signal is not yet ready, read it again
                         isReady = false;
                         DepSignalsReadDmaEvent *sgnl_rd_evnt =
-                            new DepSignalsReadDmaEvent(dep_sgnl_rd_st);
+                            new DepSignalsReadDmaEvent(this, dep_sgnl_rd_st);
                         dmaReadVirt(signal_addr, sizeof(hsa_signal_value_t),
                                     sgnl_rd_evnt, signal_val);
                         dep_sgnl_rd_st->pendingReads++;
@@ -371,7 +404,7 @@ HSAPacketProcessor::processPkt(void* pkt, uint32_t rl_idx, Addr host_pkt_addr)
                     // This signal is not yet ready, read it again
                     isReady = false;
                     DepSignalsReadDmaEvent *sgnl_rd_evnt =
-                        new DepSignalsReadDmaEvent(dep_sgnl_rd_st);
+                        new DepSignalsReadDmaEvent(this, dep_sgnl_rd_st);
                     dmaReadVirt(signal_addr, sizeof(hsa_signal_value_t),
                                 sgnl_rd_evnt, signal_val);
                     dep_sgnl_rd_st->pendingReads++;
@@ -639,6 +672,63 @@ AQLRingBuffer::allocEntry(uint32_t nBufReq)
     return nBufReq;
 }
 
+void
+HSAQueueDescriptor::serialize(CheckpointOut &cp) const
+{
+    SERIALIZE_SCALAR(basePointer);
+    SERIALIZE_SCALAR(doorbellPointer);
+    SERIALIZE_SCALAR(writeIndex);
+    SERIALIZE_SCALAR(readIndex);
+    SERIALIZE_SCALAR(numElts);
+    SERIALIZE_SCALAR(hostReadIndexPtr);
+    SERIALIZE_SCALAR(stalledOnDmaBufAvailability);
+    SERIALIZE_SCALAR(dmaInProgress);
+    SERIALIZE_SCALAR(queueId);
+    SERIALIZE_SCALAR(priority);
+    SERIALIZE_CONTAINER(cuMask);
+}
+
+void
+HSAQueueDescriptor::unserialize(CheckpointIn &cp)
+{
+    UNSERIALIZE_SCALAR(basePointer);
+    UNSERIALIZE_SCALAR(doorbellPointer);
+    UNSERIALIZE_SCALAR(writeIndex);
+    UNSERIALIZE_SCALAR(readIndex);
+    UNSERIALIZE_SCALAR(numElts);
+    UNSERIALIZE_SCALAR(hostReadIndexPtr);
+    UNSERIALIZE_SCALAR(stalledOnDmaBufAvailability);
+    UNSERIALIZE_SCALAR(dmaInProgress);
+    UNSERIALIZE_SCALAR(queueId);
+    UNSERIALIZE_SCALAR(priority);
+    UNSERIALIZE_CONTAINER(cuMask);
+}
+
+void
+AQLRingBuffer::serialize(CheckpointOut &cp) const
+{
+    // the packets are plain data, so they are saved as raw bytes
+    arrayParamOut(cp, "aql_buf", (const uint8_t*)_aqlBuf.data(),
+                  _aqlBuf.size() * sizeof(hsa_kernel_dispatch_packet_t));
+    SERIALIZE_CONTAINER(_hostDispAddresses);
+    SERIALIZE_CONTAINER(_aqlComplete);
+    SERIALIZE_SCALAR(_wrIdx);
+    SERIALIZE_SCALAR(_rdIdx);
+    SERIALIZE_SCALAR(_dispIdx);
+}
+
+void
+AQLRingBuffer::unserialize(CheckpointIn &cp)
+{
+    arrayParamIn(cp, "aql_buf", (uint8_t*)_aqlBuf.data(),
+                 _aqlBuf.size() * sizeof(hsa_kernel_dispatch_packet_t));
+    UNSERIALIZE_CONTAINER(_hostDispAddresses);
+    UNSERIALIZE_CONTAINER(_aqlComplete);
+    UNSERIALIZE_SCALAR(_wrIdx);
+    UNSERIALIZE_SCALAR(_rdIdx);
+    UNSERIALIZE_SCALAR(_dispIdx);
+}
+
 HSAPacketProcessor *
 HSAPacketProcessorParams::create()
 {
@@ -684,3 +774,93 @@ HSAPacketProcessor::finishPkt(void *pvPkt, uint32_t rl_idx)
                                         // multi-process support
     }
 }
+
+bool
+HSAPacketProcessor::isDrained() const
+{
+    for (const auto &queue : regdQList) {
+        if (queue->depSignalRdState.pendingReads) {
+            return false;
+        }
+
+        if (queue->qCntxt.qDesc && queue->qCntxt.qDesc->dmaInProgress) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void
+HSAPacketProcessor::checkDrain()
+{
+    if (drainState() == DrainState::Draining && isDrained()) {
+        DPRINTF(Drain, "HSAPacketProcessor done draining\n");
+        signalDrainDone();
+    }
+}
+
+/**
+ * The packet processor is drained once all DMAs of AQL packets and
+ * dependency signals have completed. Packets that were already fetched
+ * remain in the AQL buffers and are saved with them; the packets that
+ * were submitted to the device are owned by their tasks, which the
+ * device saves.
+ */
+DrainState
+HSAPacketProcessor::drain()
+{
+    return isDrained() ? DrainState::Drained : DrainState::Draining;
+}
+
+void
+HSAPacketProcessor::serialize(CheckpointOut &cp) const
+{
+    hwSchdlr->serializeSection(cp, "hw_scheduler");
+
+    for (int i = 0; i < numHWQueues; ++i) {
+        ScopedCheckpointSection sec(cp, csprintf("regd_queue%d", i));
+        const RQLEntry *queue = regdQList[i];
+
+        bool barrier_bit = queue->getBarrierBit();
+        Tick event_tick = queue->aqlProcessEvent.scheduled() ?
+            queue->aqlProcessEvent.when() : 0;
+
+        SERIALIZE_SCALAR(barrier_bit);
+        SERIALIZE_SCALAR(event_tick);
+        paramOut(cp, "all_read", queue->depSignalRdState.allRead);
+        paramOut(cp, "discard_read", queue->depSignalRdState.discardRead);
+        arrayParamOut(cp, "signal_values", queue->depSignalRdState.values);
+    }
+}
+
+void
+HSAPacketProcessor::unserialize(CheckpointIn &cp)
+{
+    // restores the queues and maps them to the registered list
+    hwSchdlr->unserializeSection(cp, "hw_scheduler");
+
+    for (int i = 0; i < numHWQueues; ++i) {
+        ScopedCheckpointSection sec(cp, csprintf("regd_queue%d", i));
+        RQLEntry *queue = regdQList[i];
+
+        bool barrier_bit;
+        Tick event_tick;
+
+        UNSERIALIZE_SCALAR(barrier_bit);
+        UNSERIALIZE_SCALAR(event_tick);
+        paramIn(cp, "all_read", queue->depSignalRdState.allRead);
+        paramIn(cp, "discard_read", queue->depSignalRdState.discardRead);
+        arrayParamIn(cp, "signal_values", queue->depSignalRdState.values);
+
+        queue->setBarrierBit(barrier_bit);
+
+        if (queue->aqlProcessEvent.scheduled()) {
+            deschedule(queue->aqlProcessEvent);
+        }
+
+        if (event_tick) {
+            schedule(queue->aqlProcessEvent, event_tick);
+        }
+    }
+}
@@ -39,11 +39,13 @@
 #include <cstdint>
 
 #include <queue>
+#include <vector>
 
 #include "dev/dma_device.hh"
 #include "dev/hsa/hsa.h"
 #include "dev/hsa/hsa_queue.hh"
 #include "params/HSAPacketProcessor.hh"
+#include "sim/serialize.hh"
 
 #define AQL_PACKET_SIZE 64
 #define PAGE_SIZE 4096
@@ -61,7 +63,7 @@ class HSADevice;
 class HWScheduler;
 
 // Our internal representation of an HSA queue
-class HSAQueueDescriptor {
+class HSAQueueDescriptor : public Serializable {
     public:
         uint64_t     basePointer;
         uint64_t     doorbellPointer;
@@ -71,14 +73,23 @@ class HSAQueueDescriptor {
         uint64_t     hostReadIndexPtr;
         bool         stalledOnDmaBufAvailability;
         bool         dmaInProgress;
+        // ID of the queue assigned by the driver
+        uint32_t     queueId;
+        // scheduling priority of the queue, higher values are mapped
+        // to HW queues and dispatched first
+        uint32_t     priority;
+        // CUs the kernels of the queue may run on, indexed by CU ID;
+        // all CUs are enabled if the mask is empty
+        std::vector<bool> cuMask;
 
         HSAQueueDescriptor(uint64_t base_ptr, uint64_t db_ptr,
-                           uint64_t hri_ptr, uint32_t size)
+                           uint64_t hri_ptr, uint32_t size,
+                           uint32_t queue_id = 0, uint32_t prio = 0)
           : basePointer(base_ptr), doorbellPointer(db_ptr),
             writeIndex(0), readIndex(0),
             numElts(size), hostReadIndexPtr(hri_ptr),
             stalledOnDmaBufAvailability(false),
-            dmaInProgress(false)
+            dmaInProgress(false), queueId(queue_id), priority(prio)
         {  }
         uint64_t spaceRemaining() { return numElts - (writeIndex - readIndex); }
         uint64_t spaceUsed() { return writeIndex - readIndex; }
@@ -92,6 +103,9 @@ class HSAQueueDescriptor {
             return basePointer +
                 ((ix % numElts) * objSize());
         }
+
+        void serialize(CheckpointOut &cp) const override;
+        void unserialize(CheckpointIn &cp) override;
 };
 
 /**
@@ -106,7 +120,7 @@ class HSAQueueDescriptor {
  * SUBMITTED: Packet has been submitted to the HSADevice, but has not
  *            yet completed
  */
-class AQLRingBuffer
+class AQLRingBuffer : public Serializable
 {
    private:
      std::vector<hsa_kernel_dispatch_packet_t> _aqlBuf;
@@ -168,6 +182,18 @@ class AQLRingBuffer
      void incWrIdx(uint64_t value) { _wrIdx += value; }
      void incDispIdx(uint64_t value) { _dispIdx += value; }
 
+     /**
+      * Index of the given packet in the buffer, used to refer to the
+      * packets of in-flight tasks in checkpoints.
+      */
+     uint32_t
+     pktIdx(void *pkt) const
+     {
+         return (hsa_kernel_dispatch_packet_t *)pkt - _aqlBuf.data();
+     }
+
+     void serialize(CheckpointOut &cp) const override;
+     void unserialize(CheckpointIn &cp) override;
 };
 
 typedef struct QueueContext {
@@ -258,6 +284,13 @@ class HSAPacketProcessor: public DmaDevice
     bool processPkt(void* pkt, uint32_t rl_idx, Addr host_pkt_addr);
     void displayQueueDescriptor(int pid, uint32_t rl_idx);
 
+    /**
+     * Signal the end of draining once no queue has outstanding DMAs
+     * of AQL packets or dependency signals.
+     */
+    bool isDrained() const;
+    void checkDrain();
+
   public:
     HSAQueueDescriptor*
     getQueueDesc(uint32_t queId)
@@ -282,8 +315,11 @@ class HSAPacketProcessor: public DmaDevice
     void setDeviceQueueDesc(uint64_t hostReadIndexPointer,
                             uint64_t basePointer,
                             uint64_t queue_id,
-                            uint32_t size);
+                            uint32_t size,
+                            uint32_t priority);
     void unsetDeviceQueueDesc(uint64_t queue_id);
+    void setQueuePriority(uint64_t queue_id, uint32_t priority);
+    void setQueueCuMask(uint64_t queue_id, const std::vector<bool> &mask);
     void setDevice(HSADevice * dev);
     void updateReadIndex(int, uint32_t);
     void getCommandsFromHost(int pid, uint32_t rl_idx);
@@ -296,15 +332,25 @@ class HSAPacketProcessor: public DmaDevice
     void finishPkt(void *pkt) { finishPkt(pkt, 0); }
     void schedAQLProcessing(uint32_t rl_idx);
 
+    DrainState drain() override;
+    void serialize(CheckpointOut &cp) const override;
+    void unserialize(CheckpointIn &cp) override;
+
     class DepSignalsReadDmaEvent : public Event
     {
       protected:
+        HSAPacketProcessor *hsaPP;
         SignalState *signalState;
       public:
-        DepSignalsReadDmaEvent(SignalState *ss)
-            : Event(Default_Pri, AutoDelete), signalState(ss)
+        DepSignalsReadDmaEvent(HSAPacketProcessor *_hsaPP, SignalState *ss)
+            : Event(Default_Pri, AutoDelete), hsaPP(_hsaPP), signalState(ss)
         {}
-        virtual void process() { signalState->handleReadDMA(); }
+        virtual void
+        process()
+        {
+            signalState->handleReadDMA();
+            hsaPP->checkDrain();
+        }
         virtual const char *description() const;
     };
 
@@ -84,7 +84,8 @@ void
 HWScheduler::registerNewQueue(uint64_t hostReadIndexPointer,
                               uint64_t basePointer,
                               uint64_t queue_id,
-                              uint32_t size)
+                              uint32_t size,
+                              uint32_t priority)
 {
     assert(queue_id < MAX_ACTIVE_QUEUES);
     // Map queue ID to doorbell.
@@ -105,7 +106,8 @@ HWScheduler::registerNewQueue(uint64_t hostReadIndexPointer,
 
     HSAQueueDescriptor* q_desc =
        new HSAQueueDescriptor(basePointer, db_offset,
-                              hostReadIndexPointer, size);
+                              hostReadIndexPointer, size, queue_id,
+                              priority);
     AQLRingBuffer* aql_buf =
         new AQLRingBuffer(NUM_DMA_BUFS, hsaPP->name());
     QCntxt q_cntxt(q_desc, aql_buf);
@@ -256,6 +258,12 @@ HWScheduler::removeQCntxt()
 bool
 HWScheduler::findNextActiveALQ()
 {
+    // Pick the unmapped queue with the highest priority, queues of
+    // the same priority are picked round robin starting at nextALId
+    bool found = false;
+    uint32_t next_al_id = nextALId;
+    uint32_t max_priority = 0;
+
     for (int activeQId = 0; activeQId < MAX_ACTIVE_QUEUES; activeQId++) {
         uint32_t al_id = (nextALId + activeQId) % MAX_ACTIVE_QUEUES;
         auto aqlmap_iter = activeList.find(al_id);
@@ -263,29 +271,58 @@ HWScheduler::findNextActiveALQ()
             // If this queue is already mapped
             if (regdListMap.find(al_id) != regdListMap.end()) {
                 continue;
-            } else {
-                DPRINTF(HSAPacketProcessor,
-                        "Next Active ALQ %d (current %d), max ALQ %d\n",
-                         al_id, nextALId, MAX_ACTIVE_QUEUES);
-                nextALId = al_id;
-                return true;
+            }
+            uint32_t priority = aqlmap_iter->second.qDesc->priority;
+            if (!found || priority > max_priority) {
+                found = true;
+                next_al_id = al_id;
+                max_priority = priority;
             }
         }
     }
-    return false;
+
+    if (found) {
+        DPRINTF(HSAPacketProcessor,
+                "Next Active ALQ %d (current %d, prio %d), max ALQ %d\n",
+                 next_al_id, nextALId, max_priority, MAX_ACTIVE_QUEUES);
+        nextALId = next_al_id;
+    }
+    return found;
 }
 
 bool
 HWScheduler::findNextIdleRLQ()
 {
+    // Unmap the idle queue with the lowest priority, but never make
+    // room for the queue at nextALId by unmapping a queue of higher
+    // priority that still has packets to process
+    uint32_t al_priority = activeList.at(nextALId).qDesc->priority;
+    bool found = false;
+    uint32_t next_rl_id = nextRLId;
+    uint32_t min_priority = 0;
+
     for (int regdQId = 0; regdQId < hsaPP->numHWQueues; regdQId++) {
         uint32_t rl_idx = (nextRLId + regdQId) % hsaPP->numHWQueues;
-        if (isRLQIdle(rl_idx)) {
-            nextRLId = rl_idx;
-            return true;
+        if (!isRLQIdle(rl_idx)) {
+            continue;
+        }
+        HSAQueueDescriptor* q_desc =
+            hsaPP->getRegdListEntry(rl_idx)->qCntxt.qDesc;
+        uint32_t priority = q_desc->isEmpty() ? 0 : q_desc->priority;
+        if (priority > al_priority) {
+            continue;
+        }
+        if (!found || priority < min_priority) {
+            found = true;
+            next_rl_id = rl_idx;
+            min_priority = priority;
         }
     }
-    return false;
+
+    if (found) {
+        nextRLId = next_rl_id;
+    }
+    return found;
 }
 
 // This function could be moved to packet processor
@@ -330,6 +367,16 @@ HWScheduler::write(Addr db_addr, uint32_t doorbell_reg)
     }
 }
 
+HSAQueueDescriptor*
+HWScheduler::queueDesc(uint64_t queue_id)
+{
+    auto queue = activeList.find(queue_id);
+    if (queue == activeList.end()) {
+        return nullptr;
+    }
+    return queue->second.qDesc;
+}
+
 void
 HWScheduler::unregisterQueue(uint64_t queue_id)
 {
@@ -370,3 +417,74 @@ HWScheduler::unregisterQueue(uint64_t queue_id)
     }
     schedWakeup();
 }
+
+void
+HWScheduler::serialize(CheckpointOut &cp) const
+{
+    std::vector<uint32_t> queue_ids;
+
+    for (const auto &queue : activeList) {
+        queue_ids.push_back(queue.first);
+
+        ScopedCheckpointSection sec(cp, csprintf("queue%d", queue.first));
+        auto regd_queue = regdListMap.find(queue.first);
+        // index of the queue in the registered list, -1 if it is unmapped
+        int rl_idx = regd_queue == regdListMap.end() ? -1 :
+            regd_queue->second;
+
+        SERIALIZE_SCALAR(rl_idx);
+        queue.second.qDesc->serializeSection(cp, "desc");
+        queue.second.aqlBuf->serializeSection(cp, "aql_buf");
+    }
+
+    Tick event_tick = schedWakeupEvent.scheduled() ?
+        schedWakeupEvent.when() : 0;
+
+    SERIALIZE_CONTAINER(queue_ids);
+    SERIALIZE_SCALAR(nextALId);
+    SERIALIZE_SCALAR(nextRLId);
+    SERIALIZE_SCALAR(event_tick);
+}
+
+void
+HWScheduler::unserialize(CheckpointIn &cp)
+{
+    std::vector<uint32_t> queue_ids;
+    Tick event_tick;
+
+    UNSERIALIZE_CONTAINER(queue_ids);
+    UNSERIALIZE_SCALAR(nextALId);
+    UNSERIALIZE_SCALAR(nextRLId);
+    UNSERIALIZE_SCALAR(event_tick);
+
+    for (auto queue_id : queue_ids) {
+        ScopedCheckpointSection sec(cp, csprintf("queue%d", queue_id));
+        int rl_idx;
+
+        UNSERIALIZE_SCALAR(rl_idx);
+
+        HSAQueueDescriptor* q_desc = new HSAQueueDescriptor(0, 0, 0, 0);
+        AQLRingBuffer* aql_buf =
+            new AQLRingBuffer(NUM_DMA_BUFS, hsaPP->name());
+
+        q_desc->unserializeSection(cp, "desc");
+        aql_buf->unserializeSection(cp, "aql_buf");
+
+        activeList[queue_id] = QCntxt(q_desc, aql_buf);
+        dbMap[q_desc->doorbellPointer] = queue_id;
+
+        if (rl_idx >= 0) {
+            hsaPP->getRegdListEntry(rl_idx)->qCntxt.qDesc = q_desc;
+            hsaPP->getRegdListEntry(rl_idx)->qCntxt.aqlBuf = aql_buf;
+            regdListMap[queue_id] = rl_idx;
+        }
+    }
+
+    if (schedWakeupEvent.scheduled()) {
+        hsaPP->deschedule(&schedWakeupEvent);
+    }
+
+    if (event_tick) {
+        hsaPP->schedule(&schedWakeupEvent, event_tick);
+    }
+}
@@ -37,12 +37,13 @@
 #define __DEV_HSA_HW_SCHEDULER_HH__
 
 #include "dev/hsa/hsa_packet_processor.hh"
+#include "sim/serialize.hh"
 
 // We allocate one PIO page for doorbells and each
 // address is 8 bytes
 #define MAX_ACTIVE_QUEUES (PAGE_SIZE/8)
 
-class HWScheduler
+class HWScheduler : public Serializable
 {
   public:
     HWScheduler(HSAPacketProcessor* hsa_pp, Tick wakeup_delay)
@@ -53,8 +54,11 @@ class HWScheduler
     void registerNewQueue(uint64_t hostReadIndexPointer,
                           uint64_t basePointer,
                           uint64_t queue_id,
-                          uint32_t size);
+                          uint32_t size,
+                          uint32_t priority);
     void unregisterQueue(uint64_t queue_id);
+    // Returns nullptr if no queue with this ID is registered
+    HSAQueueDescriptor* queueDesc(uint64_t queue_id);
     void wakeup();
     void schedWakeup();
     class SchedulerWakeupEvent : public Event
@@ -80,6 +84,14 @@ class HWScheduler
     void scheduleAndWakeupMappedQ();
     void updateRRVars(uint32_t al_idx, uint32_t rl_idx);
 
+    /**
+     * Save and restore all created queues, including the packets
+     * fetched into their AQL buffers, and the mapping of the queues
+     * to the registered list of the packet processor.
+     */
+    void serialize(CheckpointOut &cp) const override;
+    void unserialize(CheckpointIn &cp) override;
+
   private:
     // Active list keeps track of all queues created
     std::map<uint32_t, QCntxt> activeList;
@@ -93,10 +105,8 @@ class HWScheduler
     HSAPacketProcessor* hsaPP;
 
     // Scheduling information.
-    // For now, this is simple round robin but
-    // this will be changed to a sophisticated logic
-    // in the future. So, in the future, we will
-    // move these variables into a scheduler class
+    // Queues are mapped in order of their priority, and
+    // round robin among queues of the same priority
     uint32_t nextALId;
     uint32_t nextRLId;
     const Tick wakeupDelay;
@@ -91,7 +91,8 @@ class RegisterManager(SimObject):
     cxx_class = 'RegisterManager'
     cxx_header = 'gpu-compute/register_manager.hh'
 
-    policy = Param.String("static", "Register Manager Policy")
+    policy = Param.String("static", "Register Manager Policy (static or "
+                          "dynamic)")
     vrf_pool_managers = VectorParam.PoolManager('VRF Pool Managers')
     srf_pool_managers = VectorParam.PoolManager('SRF Pool Managers')
 
@@ -171,7 +172,12 @@ class ComputeUnit(MemObject):
     prefetch_prev_type = Param.PrefetchType('PF_PHASE', "Prefetch the stride "\
                                             "from last mem req in lane of "\
                                             "CU|Phase|Wavefront")
-    execPolicy = Param.String("OLDEST-FIRST", "WF execution selection policy");
+    execPolicy = Param.String("OLDEST-FIRST", "WF execution selection "\
+                              "policy (OLDEST-FIRST, ROUND-ROBIN, "\
+                              "LOOSE-ROUND-ROBIN, GREEDY-THEN-OLDEST, "\
+                              "TWO-LEVEL)")
+    twoLevelActiveWaves = Param.Int(4, "Number of waves in the active pool "\
+                                    "of each TWO-LEVEL scheduler")
     debugSegFault = Param.Bool(False, "enable debugging GPU seg faults")
     functionalTLB = Param.Bool(False, "Assume TLB causes no delay")
 
@@ -204,6 +210,17 @@ class ComputeUnit(MemObject):
     register_manager = Param.RegisterManager("Register Manager")
     fetch_depth = Param.Int(2, 'number of i-cache lines that may be '
                             'buffered in the fetch unit.')
+    idle_cycle_skip = Param.Bool(False, "stop ticking the CU while all of "
+                                 "its waves are blocked on external events "
+                                 "(memory responses, register file "
+                                 "writeback, waitcnts) and wake it up when "
+                                 "one arrives")
+    coalesce_vector_mem = Param.Bool(False, "merge the aligned, non-atomic "
+                                     "accesses of a vector memory "
+                                     "instruction that fall in the same "
+                                     "cache line into a single request "
+                                     "before sending them to the TLB and "
+                                     "memory ports")
 
 class Shader(ClockedObject):
     type = 'Shader'
@@ -225,6 +242,15 @@ class Shader(ClockedObject):
     timer_period = Param.Clock('10us', "system timer period")
     idlecu_timeout = Param.Tick(0, "Idle CU watchdog timeout threshold")
     max_valu_insts = Param.Int(0, "Maximum vALU insts before exiting")
+    inst_profile_dir = Param.String("", "directory in the output directory "
+                                    "to which a per-instruction profile of "
+                                    "each kernel is written, empty "
+                                    "disables profiling")
+    trace_file = Param.String("", "file in the output directory to which "
+                              "a timeline trace of the wavefronts is "
+                              "written, empty disables tracing")
+    trace_buffer_size = Param.Int(65536, "number of trace events each CU "
+                                  "buffers before writing them out")
 
 class GPUComputeDriver(HSADriver):
     type = 'GPUComputeDriver'
@@ -233,6 +259,23 @@ class GPUComputeDriver(HSADriver):
 class GPUDispatcher(SimObject):
     type = 'GPUDispatcher'
     cxx_header = 'gpu-compute/dispatcher.hh'
+    # kernels selected by any of the following are executed functionally,
+    # all other kernels use the detailed CU model
+    functional_kernels = VectorParam.Int([], "indices (in launch order) "
+                                         "of the kernels to execute "
+                                         "functionally")
+    functional_kernel_names = VectorParam.String([], "names of the kernels "
+                                                 "to execute functionally")
+    fast_forward_kernels = Param.Int(0, "number of kernel launches to "
+                                     "execute functionally before switching "
+                                     "to the detailed model")
+    sample_period = Param.Int(0, "execute one of every sample_period "
+                              "launches of each kernel in detail and the "
+                              "others functionally, 0 disables sampling")
+    sample_file = Param.String("kernel_samples.csv", "file in the output "
+                               "directory to which the run times "
+                               "extrapolated from the sampled kernel "
+                               "launches are written")
 
 class GPUCommandProcessor(HSADevice):
     type = 'GPUCommandProcessor'
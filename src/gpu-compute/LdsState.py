@@ -46,4 +46,5 @@ class LdsState(MemObject):
     bankConflictPenalty = Param.Int(1, 'penalty per LDS bank conflict when '\
                                     'accessing data')
     banks = Param.Int(32, 'Number of LDS banks')
+    bankWidth = Param.Int(4, 'width of each LDS bank in bytes')
     cuPort = SlavePort("port that goes to the compute unit")
@@ -44,6 +44,17 @@ if buildEnv['FULL_SYSTEM']:
         port = SlavePort("Port for the hardware table walker")
         system = Param.System(Parent.any, "system object")
 
+class X86GPUPageWalker(MemObject):
+    type = 'X86GPUPageWalker'
+    cxx_class = 'X86ISA::GpuPageWalker'
+    cxx_header = 'gpu-compute/gpu_page_walker.hh'
+    port = MasterPort("Port to the memory system holding the page table")
+    system = Param.System(Parent.any, "system object")
+    num_walkers = Param.Int(8, "Number of page table walks that may be "\
+                            "in flight at once")
+    pwc_size = Param.Int(32, "Number of entries in the page walk cache "\
+                         "(0 disables it)")
+
 class X86GPUTLB(MemObject):
     type = 'X86GPUTLB'
     cxx_class = 'X86ISA::GpuTLB'
@@ -63,6 +74,10 @@ class X86GPUTLB(MemObject):
     master = VectorMasterPort("Port on side closer to memory")
     allocationPolicy = Param.Bool(True, "Allocate on an access")
     accessDistance = Param.Bool(False, "print accessDistance stats")
+    page_walker = Param.X86GPUPageWalker(NULL, "Timing page table walker "\
+                                         "used by the last-level TLB. If "\
+                                         "unset, walks are functional and "\
+                                         "take missLatency2 cycles")
 
 class TLBCoalescer(MemObject):
     type = 'TLBCoalescer'
@@ -0,0 +1,190 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <set>
+#include <vector>
+
+#include "gpu-compute/misc.hh"
+
+namespace {
+
+struct Obj
+{
+    Obj(int v) : val(v) { }
+    int val;
+    uint8_t pad[100];
+};
+
+// counts the live instances, like a sender state holding a GPUDynInstPtr
+struct Counted
+{
+    Counted(int v, std::shared_ptr<int> r) : val(v), ref(r) { ++live; }
+    ~Counted() { --live; }
+    int val;
+    std::shared_ptr<int> ref;
+    static int live;
+};
+
+int Counted::live = 0;
+
+} // anonymous namespace
+
+TEST(BufferPoolTest, ReusesReleasedBuffers)
+{
+    BufferPool pool(256);
+    EXPECT_EQ(256, pool.size());
+    EXPECT_TRUE(pool.empty());
+
+    uint8_t *a = pool.acquire();
+    uint8_t *b = pool.acquire();
+    EXPECT_NE(a, b);
+    EXPECT_TRUE(pool.empty());
+
+    pool.release(a);
+    pool.release(b);
+    EXPECT_FALSE(pool.empty());
+
+    // the most recently released buffer is handed out first
+    EXPECT_EQ(b, pool.acquire());
+    EXPECT_EQ(a, pool.acquire());
+    EXPECT_TRUE(pool.empty());
+
+    pool.release(a);
+    pool.release(b);
+}
+
+TEST(BufferPoolTest, SteadyStateNeedsNoHeap)
+{
+    const int inFlight = 16;
+    BufferPool pool(64);
+    std::vector<uint8_t*> bufs;
+    std::set<uint8_t*> seen;
+
+    int heapAllocs = 0;
+    for (int i = 0; i < 1000; ++i) {
+        if (bufs.size() == inFlight) {
+            pool.release(bufs.front());
+            bufs.erase(bufs.begin());
+        }
+        if (pool.empty())
+            heapAllocs++;
+        bufs.push_back(pool.acquire());
+        seen.insert(bufs.back());
+    }
+
+    // only the first inFlight acquires allocate
+    EXPECT_EQ(inFlight, heapAllocs);
+    EXPECT_EQ(inFlight, seen.size());
+
+    for (auto buf : bufs)
+        pool.release(buf);
+}
+
+TEST(FreeListAllocatorTest, RecyclesSharedObjects)
+{
+    FreeListAllocator<Obj> alloc;
+
+    std::shared_ptr<Obj> a = std::allocate_shared<Obj>(alloc, 1);
+    Obj *first = a.get();
+    a.reset();
+
+    // the combined object and control block is reused
+    std::shared_ptr<Obj> b = std::allocate_shared<Obj>(alloc, 2);
+    EXPECT_EQ(first, b.get());
+    EXPECT_EQ(2, b->val);
+
+    // while it is live, another object gets new storage
+    std::shared_ptr<Obj> c = std::allocate_shared<Obj>(alloc, 3);
+    EXPECT_NE(b.get(), c.get());
+}
+
+TEST(FreeListAllocatorTest, ArraysBypassTheFreeList)
+{
+    FreeListAllocator<Obj> alloc;
+
+    Obj *single = alloc.allocate(1);
+    alloc.deallocate(single, 1);
+
+    Obj *array = alloc.allocate(4);
+    EXPECT_NE(single, array);
+    alloc.deallocate(array, 4);
+
+    EXPECT_EQ(single, alloc.allocate(1));
+    alloc.deallocate(single, 1);
+
+    // all allocators of a type share a free list
+    FreeListAllocator<Obj> other;
+    EXPECT_TRUE(alloc == other);
+    EXPECT_EQ(single, other.allocate(1));
+    other.deallocate(single, 1);
+}
+
+TEST(ObjectPoolTest, ReusesReleasedStorage)
+{
+    ObjectPool<Counted> pool;
+    auto ref = std::make_shared<int>(0);
+    EXPECT_TRUE(pool.empty());
+
+    Counted *a = pool.acquire(1, ref);
+    Counted *b = pool.acquire(2, ref);
+    EXPECT_EQ(2, Counted::live);
+    EXPECT_EQ(3, ref.use_count());
+
+    // releasing destroys the object, dropping its references
+    pool.release(a);
+    EXPECT_EQ(1, Counted::live);
+    EXPECT_EQ(2, ref.use_count());
+    EXPECT_FALSE(pool.empty());
+
+    // and the next acquire constructs a new object in its storage
+    Counted *c = pool.acquire(3, ref);
+    EXPECT_EQ(a, c);
+    EXPECT_EQ(3, c->val);
+    EXPECT_TRUE(pool.empty());
+
+    pool.release(b);
+    pool.release(c);
+    EXPECT_EQ(0, Counted::live);
+    EXPECT_EQ(1, ref.use_count());
+}
+
+TEST(ObjectPoolTest, AcceptsObjectsCreatedWithNew)
+{
+    ObjectPool<Counted> pool;
+    auto ref = std::make_shared<int>(0);
+
+    Counted *obj = new Counted(1, ref);
+    pool.release(obj);
+    EXPECT_EQ(0, Counted::live);
+
+    EXPECT_EQ(obj, pool.acquire(2, ref));
+    pool.release(obj);
+}
@@ -36,6 +36,8 @@
 
 #include "gpu-compute/compute_unit.hh"
 
+#include <algorithm>
+#include <cstring>
 #include <limits>
 
 #include "base/output.hh"
@@ -62,6 +64,7 @@
 #include "sim/sim_exit.hh"
 
 ComputeUnit::ComputeUnit(const Params *p) : MemObject(p),
+    dynInstDataPool(GPUDynInst::dataBufSize(p->wf_size)),
     numVectorGlobalMemUnits(p->num_global_mem_pipes),
     numVectorSharedMemUnits(p->num_shared_mem_pipes),
     numScalarMemUnits(p->num_scalar_mem_pipes),
@@ -74,6 +77,8 @@ ComputeUnit::ComputeUnit(const Params *p) : MemObject(p),
     globalMemoryPipe(p), localMemoryPipe(p), scalarMemoryPipe(p),
     tickEvent([this]{ exec(); }, "Compute unit tick event",
           false, Event::CPU_Tick_Pri),
+    functionalExecEvent([this]{ execFunctional(); },
+          "Compute unit functional execution event"),
     cu_id(p->cu_id),
     vrf(p->vector_register_file), srf(p->scalar_register_file),
     simdWidth(p->simd_width),
@@ -89,12 +94,15 @@ ComputeUnit::ComputeUnit(const Params *p) : MemObject(p),
     prefetchStride(p->prefetch_stride), prefetchType(p->prefetch_prev_type),
     debugSegFault(p->debugSegFault),
     functionalTLB(p->functionalTLB), localMemBarrier(p->localMemBarrier),
-    countPages(p->countPages), barrier_id(0),
+    idleCycleSkip(p->idle_cycle_skip),
+    coalesceVectorMem(p->coalesce_vector_mem), countPages(p->countPages),
+    barrier_id(0),
     req_tick_latency(p->mem_req_latency * p->clk_domain->clockPeriod()),
     resp_tick_latency(p->mem_resp_latency * p->clk_domain->clockPeriod()),
     _masterId(p->system->getMasterId(this, "ComputeUnit")),
     lds(*p->localDataStore), _cacheLineSize(p->system->cacheLineSize()),
-    globalSeqNum(0), wavefrontSize(p->wf_size)
+    globalSeqNum(0), wavefrontSize(p->wf_size), sleeping(false),
+    sleepCycle(0)
 {
     /**
      * This check is necessary because std::bitset only provides conversion
@@ -132,6 +140,7 @@ ComputeUnit::ComputeUnit(const Params *p) : MemObject(p),
 
             wfList[j].push_back(p->wavefronts[j * p->n_wf + i]);
             wfList[j][i]->setParent(this);
+            freeWfSlots.emplace(i, j);
 
             for (int k = 0; k < wfSize(); ++k) {
                 lastVaddrWF[j][i][k] = 0;
@@ -323,6 +332,7 @@ ComputeUnit::startWavefront(Wavefront *w, int waveId, LdsChunk *ldsChunk,
 
     w->kernId = task->dispatchId();
     w->wfId = waveId;
+    w->functionalMode = task->functional();
     w->initMask = init_mask.to_ullong();
 
     for (int k = 0; k < wfSize(); ++k) {
@@ -359,7 +369,7 @@ ComputeUnit::startWavefront(Wavefront *w, int waveId, LdsChunk *ldsChunk,
     w->ldsChunk = ldsChunk;
 
     int32_t refCount M5_VAR_USED =
-                lds.increaseRefCounter(w->dispatchId, w->wgId);
+                lds.increaseRefCounter(w->ldsChunk);
     DPRINTF(GPUDisp, "CU%d: increase ref ctr wg[%d] to [%d]\n",
                     cu_id, w->wgId, refCount);
 
@@ -375,6 +385,10 @@ ComputeUnit::startWavefront(Wavefront *w, int waveId, LdsChunk *ldsChunk,
     w->initRegState(task, w->actualWgSzTotal);
     w->start(_n_wave++, task->codeAddr());
 
+    if (shader->trace()) {
+        shader->trace()->record(GPUTrace::WF_DISPATCH, w);
+    }
+
     waveLevelParallelism.sample(activeWaves);
     activeWaves++;
 }
@@ -386,9 +400,14 @@ ComputeUnit::startWavefront(Wavefront *w, int waveId, LdsChunk *ldsChunk,
  */
 void
 ComputeUnit::doInvalidate(Request *req, int kernId){
+    // dynamic instructions do not own their static instruction, and
+    // the kernel launch instruction holds no per-launch state, so all
+    // launches share a single instance
+    static KernelLaunchStaticInst kernel_launch_inst;
+
     GPUDynInstPtr gpuDynInst
-        = std::make_shared<GPUDynInst>(this, nullptr,
-            new KernelLaunchStaticInst(), getAndIncSeqNum());
+        = GPUDynInst::create(this, nullptr, &kernel_launch_inst,
+                             getAndIncSeqNum());
 
     // kern_id will be used in inv responses
     gpuDynInst->kern_id = kernId;
@@ -412,7 +431,9 @@ void
 ComputeUnit::dispWorkgroup(HSAQueueEntry *task, bool startFromScheduler)
 {
     // If we aren't ticking, start it up!
-    if (!tickEvent.scheduled()) {
+    if (sleeping) {
+        wakeup();
+    } else if (!tickEvent.scheduled()) {
         DPRINTF(GPUDisp, "CU%d: Scheduling wakeup next cycle\n", cu_id);
         schedule(tickEvent, nextCycle());
     }
@@ -428,6 +449,7 @@ ComputeUnit::dispWorkgroup(HSAQueueEntry *task, bool startFromScheduler)
                                           task->ldsSize());
 
     panic_if(!ldsChunk, "was not able to reserve space for this WG");
+    ldsOccupancy.sample(lds.occupancy() * 100);
 
     // calculate the number of 32-bit vector registers required
     // by each work item
@@ -436,33 +458,102 @@ ComputeUnit::dispWorkgroup(HSAQueueEntry *task, bool startFromScheduler)
     int wave_id = 0;
 
     // Assign WFs according to numWfsToSched vector, which is computed by
-    // hasDispResources()
-    for (int j = 0; j < shader->n_wf; ++j) {
-        for (int i = 0; i < numVectorALUs; ++i) {
-            Wavefront *w = wfList[i][j];
-            // Check if this wavefront slot is available and there are WFs
-            // remaining to be dispatched to current SIMD:
-            // WF slot must be stopped and not waiting
-            // for a release to complete S_RETURNING
-            if (w->getStatus() == Wavefront::S_STOPPED &&
-                numWfsToSched[i] > 0) {
-                // decrement number of WFs awaiting dispatch to current SIMD
-                numWfsToSched[i] -= 1;
-
-                fillKernelState(w, task);
-
-                DPRINTF(GPURename, "SIMD[%d] wfSlotId[%d] WF[%d] "
-                    "vregDemand[%d] sregDemand[%d]\n", i, j, w->wfDynId,
-                    vregDemand, sregDemand);
-
-                registerManager.allocateRegisters(w, vregDemand, sregDemand);
-
-                startWavefront(w, wave_id, ldsChunk, task);
-                ++wave_id;
+    // hasDispResources(). Starting a WF removes its slot from
+    // freeWfSlots, so the iterator is advanced first
+    for (auto slot = freeWfSlots.begin(); slot != freeWfSlots.end();) {
+        int j = slot->first;
+        int i = slot->second;
+        Wavefront *w = wfList[i][j];
+        ++slot;
+
+        // Check if there are WFs remaining to be dispatched to
+        // current SIMD
+        assert(w->getStatus() == Wavefront::S_STOPPED);
+        if (numWfsToSched[i] > 0) {
+            // decrement number of WFs awaiting dispatch to current SIMD
+            numWfsToSched[i] -= 1;
+
+            fillKernelState(w, task);
+
+            DPRINTF(GPURename, "SIMD[%d] wfSlotId[%d] WF[%d] "
+                "vregDemand[%d] sregDemand[%d]\n", i, j, w->wfDynId,
+                vregDemand, sregDemand);
+
+            registerManager.allocateRegisters(w, vregDemand, sregDemand);
+
+            startWavefront(w, wave_id, ldsChunk, task);
+            ++wave_id;
+
+            if (task->functional()) {
+                functionalWfs.push_back(w);
             }
         }
     }
     ++barrier_id;
+
+    if (task->functional() && !functionalExecEvent.scheduled()) {
+        schedule(functionalExecEvent, nextCycle());
+    }
+}
+
+void
+ComputeUnit::execFunctional()
+{
+    // number of instructions a WF executes before it yields to the next
+    const int quantum = 1000;
+
+    while (!functionalWfs.empty()) {
+        bool progress = false;
+
+        for (auto *w : functionalWfs) {
+            if (w->getStatus() == Wavefront::S_STOPPED) {
+                continue;
+            }
+
+            if (w->stalledAtBarrier) {
+                if (!AllAtBarrier(w->barrierId, w->barrierCnt,
+                                  getRefCounter(w->ldsChunk))) {
+                    continue;
+                }
+
+                w->oldBarrierCnt = w->barrierCnt;
+                w->stalledAtBarrier = false;
+            }
+
+            for (int i = 0; i < quantum && !w->stalledAtBarrier &&
+                 w->getStatus() != Wavefront::S_STOPPED; ++i) {
+                w->execFunctional();
+            }
+
+            progress = true;
+        }
+
+        panic_if(!progress, "CU%d: functionally executed WFs are waiting "
+                 "at barriers that can not be satisfied\n", cu_id);
+
+        functionalWfs.erase(std::remove_if(functionalWfs.begin(),
+            functionalWfs.end(), [](Wavefront *w)
+            { return w->getStatus() == Wavefront::S_STOPPED; }),
+            functionalWfs.end());
+    }
+
+    // the CU may have gone to sleep while the WFs were pending, let it
+    // notice that it is done
+    wakeup();
+}
+
+void
+ComputeUnit::execFunctionalAccess(GPUDynInstPtr gpuDynInst)
+{
+    assert(gpuDynInst->wavefront()->functionalMode);
+
+    // functional accesses read and update every cached copy of the data,
+    // so there is nothing for a memory fence to do
+    if (!gpuDynInst->isMemSync()) {
+        gpuDynInst->initiateAcc(gpuDynInst);
+    }
+
+    gpuDynInst->completeAcc(gpuDynInst);
 }
 
 void
@@ -524,30 +615,33 @@ ComputeUnit::hasDispResources(HSAQueueEntry *task)
              "with %d SGPRs\n",
              numWfs, sregDemandPerWI, numScalarRegsPerSimd);
 
-    // number of WF slots that are not occupied
-    int freeWfSlots = 0;
     // number of Wfs from WG that were successfully mapped to a SIMD
     int numMappedWfs = 0;
     numWfsToSched.clear();
     numWfsToSched.resize(numVectorALUs, 0);
 
+    bool vregAvail = true;
+    bool sregAvail = true;
+
     // attempt to map WFs to the SIMDs, based on WF slot availability
-    // and register file availability
-    for (int j = 0; j < shader->n_wf; ++j) {
-        for (int i = 0; i < numVectorALUs; ++i) {
-            if (wfList[i][j]->getStatus() == Wavefront::S_STOPPED) {
-                ++freeWfSlots;
-                // check if current WF will fit onto current SIMD/VRF
-                // if all WFs have not yet been mapped to the SIMDs
-                if (numMappedWfs < numWfs &&
-                    registerManager.canAllocateSgprs(i, numWfsToSched[i] + 1,
-                                                      sregDemandPerWI) &&
-                    registerManager.canAllocateVgprs(i, numWfsToSched[i] + 1,
-                                                     vregDemandPerWI)) {
-                    numWfsToSched[i]++;
-                    numMappedWfs++;
-                }
-            }
+    // and register file availability. only the free slots are visited,
+    // in the order of their slot and SIMD IDs
+    for (auto slot = freeWfSlots.begin();
+         slot != freeWfSlots.end() && numMappedWfs < numWfs; ++slot) {
+        int i = slot->second;
+        // check if current WF will fit onto current SIMD/VRF
+        bool sregs = registerManager.
+            canAllocateSgprs(i, numWfsToSched[i] + 1, sregDemandPerWI);
+        bool vregs = registerManager.
+            canAllocateVgprs(i, numWfsToSched[i] + 1, vregDemandPerWI);
+        if (sregs && vregs) {
+            numWfsToSched[i]++;
+            numMappedWfs++;
+        } else {
+            // remember the resource that kept a WF from
+            // being mapped to a free slot
+            sregAvail &= sregs;
+            vregAvail &= vregs;
         }
     }
 
@@ -555,28 +649,18 @@ ComputeUnit::hasDispResources(HSAQueueEntry *task)
     // than the actual number of WFs
     assert(numMappedWfs <= numWfs);
 
-    bool vregAvail = true;
-    bool sregAvail = true;
-    // if a WF to SIMD mapping was not found, find the limiting resource
-    if (numMappedWfs < numWfs) {
-
-        for (int j = 0; j < numVectorALUs; ++j) {
-            // find if there are enough free VGPRs in the SIMD's VRF
-            // to accomodate the WFs of the new WG that would be mapped
-            // to this SIMD unit
-            vregAvail &= registerManager.
-                canAllocateVgprs(j, numWfsToSched[j], vregDemandPerWI);
-            // find if there are enough free SGPRs in the SIMD's SRF
-            // to accomodate the WFs of the new WG that would be mapped
-            // to this SIMD unit
-            sregAvail &= registerManager.
-                canAllocateSgprs(j, numWfsToSched[j], sregDemandPerWI);
-        }
+    // if a WF to SIMD mapping was not found, the registers only limited
+    // the mapping if there were free WF slots they did not fit in
+    if (numMappedWfs == numWfs) {
+        vregAvail = true;
+        sregAvail = true;
+    } else if (!vregAvail || !sregAvail) {
+        numWfsBlockedDueRegAlloc += numWfs - numMappedWfs;
     }
 
     DPRINTF(GPUDisp, "Free WF slots =  %d, Mapped WFs = %d, \
             VGPR Availability = %d, SGPR Availability = %d\n",
-            freeWfSlots, numMappedWfs, vregAvail, sregAvail);
+            freeWfSlots.size(), numMappedWfs, vregAvail, sregAvail);
 
     if (!vregAvail) {
         ++numTimesWgBlockedDueVgprAlloc;
@@ -591,6 +675,10 @@ ComputeUnit::hasDispResources(HSAQueueEntry *task)
     bool ldsAvail = lds.canReserve(task->ldsSize());
     if (!ldsAvail) {
         wgBlockedDueLdsAllocation++;
+        // enough bytes are free, but not in a single region
+        if (lds.freeBytes() >= task->ldsSize()) {
+            wgBlockedDueLdsFragmentation++;
+        }
     }
 
     // Return true if the following are all true:
@@ -603,6 +691,28 @@ ComputeUnit::hasDispResources(HSAQueueEntry *task)
     return can_dispatch;
 }
 
+void
+ComputeUnit::wfSlotOccupied(Wavefront *w)
+{
+    M5_VAR_USED auto erased = freeWfSlots.erase({w->wfSlotId, w->simdId});
+    assert(erased);
+
+    if (freeWfSlots.empty()) {
+        shader->updateFreeWfSlots(cu_id, false);
+    }
+}
+
+void
+ComputeUnit::wfSlotFreed(Wavefront *w)
+{
+    if (freeWfSlots.empty()) {
+        shader->updateFreeWfSlots(cu_id, true);
+    }
+
+    M5_VAR_USED auto inserted = freeWfSlots.emplace(w->wfSlotId, w->simdId);
+    assert(inserted.second);
+}
+
 int
 ComputeUnit::AllAtBarrier(uint32_t _barrier_id, uint32_t bcnt, uint32_t bslots)
 {
@@ -670,13 +780,50 @@ ComputeUnit::exec()
 
     // Put this CU to sleep if there is no more work to be done.
     if (!isDone()) {
-        schedule(tickEvent, nextCycle());
+        if (idleCycleSkip && isQuiescent()) {
+            // all resident waves are blocked on something outside of
+            // the CU, stop ticking until wakeup() is called
+            sleeping = true;
+            sleepCycle = curCycle();
+            ++numIdleSleeps;
+            DPRINTF(GPUExec, "CU%d: Quiescent, sleeping until an external "
+                    "event arrives\n", cu_id);
+        } else {
+            schedule(tickEvent, nextCycle());
+        }
     } else {
         shader->notifyCuSleep();
         DPRINTF(GPUDisp, "CU%d: Going to sleep\n", cu_id);
     }
 }
 
+void
+ComputeUnit::wakeup()
+{
+    if (!sleeping) {
+        return;
+    }
+
+    sleeping = false;
+
+    // the event becomes visible to the CU on the next clock edge, as it
+    // would have if we kept ticking. however, we may be woken up during
+    // the same cycle we went to sleep in, which must not be executed twice.
+    Cycles wake_cycle = curCycle();
+    if (wake_cycle <= sleepCycle) {
+        wake_cycle = sleepCycle + Cycles(1);
+    }
+
+    Cycles skipped = wake_cycle - sleepCycle - Cycles(1);
+    idleCyclesSkipped += skipped;
+    totalCycles += skipped;
+
+    DPRINTF(GPUExec, "CU%d: Waking up, skipped %d idle cycles\n", cu_id,
+            uint64_t(skipped));
+
+    schedule(tickEvent, clockEdge(wake_cycle - curCycle()));
+}
+
 void
 ComputeUnit::init()
 {
@@ -769,7 +916,7 @@ ComputeUnit::DataPort::recvTimingResp(PacketPtr pkt)
             // one D-Cache inv is done, decrement counter
             dispatcher.updateInvCounter(gpuDynInst->kern_id);
 
-            delete pkt->senderState;
+            computeUnit->dataSenderStatePool.release(sender_state);
             delete pkt->req;
             delete pkt;
             return true;
@@ -824,7 +971,7 @@ ComputeUnit::DataPort::recvTimingResp(PacketPtr pkt)
                 computeUnit->cu_id, gpuDynInst->simdId,
                 gpuDynInst->wfSlotId, w->barrierCnt);
 
-        delete pkt->senderState;
+        computeUnit->dataSenderStatePool.release(sender_state);
         delete pkt->req;
         delete pkt;
         return true;
@@ -851,7 +998,8 @@ ComputeUnit::DataPort::recvTimingResp(PacketPtr pkt)
                             gpuDynInst->wfSlotId);
         }
 
-        delete pkt->senderState;
+        // the coalescer allocated this sender state, the pool may reuse it
+        computeUnit->dataSenderStatePool.release(sender_state);
         delete pkt->req;
         delete pkt;
 
@@ -884,6 +1032,12 @@ ComputeUnit::ScalarDataPort::recvTimingResp(PacketPtr pkt)
     assert(pkt->isRead() || pkt->isWrite());
     assert(gpuDynInst->numScalarReqs > 0);
 
+    if (computeUnit->shader->trace()) {
+        computeUnit->shader->trace()->record(GPUTrace::MEM_RESP,
+            gpuDynInst->wavefront(), gpuDynInst->seqNum(),
+            pkt->req->getPaddr());
+    }
+
     gpuDynInst->numScalarReqs--;
 
     /**
@@ -902,6 +1056,8 @@ ComputeUnit::ScalarDataPort::recvTimingResp(PacketPtr pkt)
                 computeUnit->scalarMemoryPipe.getGMStRespFIFO().push(
                                 gpuDynInst);
         }
+
+        computeUnit->wakeup();
     }
 
     delete pkt->req;
@@ -986,6 +1142,9 @@ ComputeUnit::sendRequest(GPUDynInstPtr gpuDynInst, int index, PacketPtr pkt)
     // There must be a way around this check to do the globalMemStart...
     Addr tmp_vaddr = pkt->req->getVaddr();
 
+    // the lane's Packet and Request, and the atomic op of the Request
+    vmemReqHeapAllocs += pkt->req->hasAtomicOpFunctor() ? 3 : 2;
+
     updatePageDivergenceDist(tmp_vaddr);
 
     // set PC in request
@@ -996,6 +1155,11 @@ ComputeUnit::sendRequest(GPUDynInstPtr gpuDynInst, int index, PacketPtr pkt)
                       pkt->req->getPC());
     pkt->req->setReqInstSeqNum(gpuDynInst->seqNum());
 
+    if (shader->trace()) {
+        shader->trace()->record(GPUTrace::MEM_SEND, gpuDynInst->wavefront(),
+                                gpuDynInst->seqNum(), tmp_vaddr);
+    }
+
     // figure out the type of the request to set read/write
     BaseTLB::Mode TLB_mode;
     assert(pkt->isRead() || pkt->isWrite());
@@ -1018,7 +1182,7 @@ ComputeUnit::sendRequest(GPUDynInstPtr gpuDynInst, int index, PacketPtr pkt)
 
     int tlbPort_index = perLaneTLB ? index : 0;
 
-    if (shader->timingSim) {
+    if (shader->timingSim && !gpuDynInst->wavefront()->functionalMode) {
         if (debugSegFault) {
             Process *p = shader->gpuTc->getProcessPtr();
             Addr vaddr = pkt->req->getVaddr();
@@ -1039,12 +1203,14 @@ ComputeUnit::sendRequest(GPUDynInstPtr gpuDynInst, int index, PacketPtr pkt)
         }
 
         // This is the SenderState needed upon return
-        pkt->senderState = new DTLBPort::SenderState(gpuDynInst, index);
+        pkt->senderState = acquireSenderState(dtlbSenderStatePool,
+                                              gpuDynInst, index);
 
         // This is the senderState needed by the TLB hierarchy to function
         TheISA::GpuTLB::TranslationState *translation_state =
           new TheISA::GpuTLB::TranslationState(TLB_mode, shader->gpuTc, false,
                                                pkt->senderState);
+        vmemReqHeapAllocs++;
 
         pkt->senderState = translation_state;
 
@@ -1061,7 +1227,8 @@ ComputeUnit::sendRequest(GPUDynInstPtr gpuDynInst, int index, PacketPtr pkt)
                 safe_cast<X86ISA::GpuTLB::TranslationState*>(pkt->senderState);
 
             delete sender_state->tlbEntry;
-            delete sender_state->saved;
+            dtlbSenderStatePool.release(
+                safe_cast<DTLBPort::SenderState*>(sender_state->saved));
             delete sender_state;
 
             assert(pkt->req->hasPaddr());
@@ -1074,6 +1241,7 @@ ComputeUnit::sendRequest(GPUDynInstPtr gpuDynInst, int index, PacketPtr pkt)
             // and proper flags.
             PacketPtr oldPkt = pkt;
             pkt = new Packet(oldPkt->req, oldPkt->cmd);
+            vmemReqHeapAllocs++;
             if (isDataAccess) {
                 uint8_t *tmpData = oldPkt->getPtr<uint8_t>();
                 pkt->dataStatic(tmpData);
@@ -1082,9 +1250,8 @@ ComputeUnit::sendRequest(GPUDynInstPtr gpuDynInst, int index, PacketPtr pkt)
 
 
             // New SenderState for the memory access
-            pkt->senderState =
-                new ComputeUnit::DataPort::SenderState(gpuDynInst, index,
-                    nullptr);
+            pkt->senderState = acquireSenderState(dataSenderStatePool,
+                                                  gpuDynInst, index, nullptr);
 
             gpuDynInst->memStatusVector[pkt->getAddr()].push_back(index);
             gpuDynInst->tlbHitLevel[index] = hit_level;
@@ -1125,6 +1292,9 @@ ComputeUnit::sendRequest(GPUDynInstPtr gpuDynInst, int index, PacketPtr pkt)
                    cu_id, gpuDynInst->simdId, gpuDynInst->wfSlotId, tmp_vaddr);
         }
     } else {
+        // the translation completes immediately
+        tlbCycles += curTick();
+
         if (pkt->cmd == MemCmd::MemSyncReq) {
             gpuDynInst->resetEntireStatusVector();
         } else {
@@ -1137,6 +1307,7 @@ ComputeUnit::sendRequest(GPUDynInstPtr gpuDynInst, int index, PacketPtr pkt)
         // Because it's atomic operation, only need TLB translation state
         pkt->senderState = new TheISA::GpuTLB::TranslationState(TLB_mode,
                                                                 shader->gpuTc);
+        vmemReqHeapAllocs++;
 
         tlbPort[tlbPort_index]->sendFunctional(pkt);
 
@@ -1146,9 +1317,33 @@ ComputeUnit::sendRequest(GPUDynInstPtr gpuDynInst, int index, PacketPtr pkt)
         // address returned by the translation.
         PacketPtr new_pkt = new Packet(pkt->req, pkt->cmd);
         new_pkt->dataStatic(pkt->getPtr<uint8_t>());
+        vmemReqHeapAllocs++;
 
         // Translation is done. It is safe to send the packet to memory.
-        memPort[0]->sendFunctional(new_pkt);
+        if (new_pkt->isAtomicOp()) {
+            // functional accesses can not perform the atomic operation,
+            // so read the old value, which is also the value returned by
+            // the atomic, apply the operation to it and write it back.
+            unsigned size = new_pkt->getSize();
+            std::vector<uint8_t> mem_data(size);
+
+            Packet read_pkt(new_pkt->req, MemCmd::ReadReq);
+            read_pkt.dataStatic(mem_data.data());
+            memPort[0]->sendFunctional(&read_pkt);
+
+            std::memcpy(new_pkt->getPtr<uint8_t>(), mem_data.data(), size);
+            (*new_pkt->getAtomicOp())(mem_data.data());
+
+            Packet write_pkt(new_pkt->req, MemCmd::WriteReq);
+            write_pkt.dataStatic(mem_data.data());
+            memPort[0]->sendFunctional(&write_pkt);
+        } else {
+            memPort[0]->sendFunctional(new_pkt);
+        }
+
+        if (new_pkt->isRead()) {
+            gpuDynInst->scatterCoalescedData(index);
+        }
 
         DPRINTF(GPUMem, "Functional sendRequest\n");
         DPRINTF(GPUMem, "CU%d: WF[%d][%d]: index %d: addr %#x\n", cu_id,
@@ -1174,6 +1369,35 @@ ComputeUnit::sendScalarRequest(GPUDynInstPtr gpuDynInst, PacketPtr pkt)
 
     BaseTLB::Mode tlb_mode = pkt->isRead() ? BaseTLB::Read : BaseTLB::Write;
 
+    if (shader->trace()) {
+        shader->trace()->record(GPUTrace::MEM_SEND, gpuDynInst->wavefront(),
+                                gpuDynInst->seqNum(), pkt->req->getVaddr());
+    }
+
+    if (gpuDynInst->wavefront()->functionalMode) {
+        pkt->senderState =
+            new TheISA::GpuTLB::TranslationState(tlb_mode, shader->gpuTc);
+
+        scalarDTLBPort->sendFunctional(pkt);
+
+        TheISA::GpuTLB::TranslationState *sender_state =
+             safe_cast<TheISA::GpuTLB::TranslationState*>(pkt->senderState);
+
+        delete sender_state->tlbEntry;
+        delete sender_state;
+
+        // as in sendRequest(), the translated request needs a new packet
+        PacketPtr new_pkt = new Packet(pkt->req, pkt->cmd);
+        new_pkt->dataStatic(pkt->getPtr<uint8_t>());
+        scalarDataPort->sendFunctional(new_pkt);
+
+        delete new_pkt;
+        delete pkt->req;
+        delete pkt;
+
+        return;
+    }
+
     pkt->senderState =
         new ComputeUnit::ScalarDTLBPort::SenderState(gpuDynInst);
 
@@ -1218,7 +1442,7 @@ ComputeUnit::injectGlobalMemFence(GPUDynInstPtr gpuDynInst,
             req->setFlags(Request::KERNEL);
             pkt = new Packet(req, MemCmd::MemSyncReq);
             pkt->pushSenderState(
-               new ComputeUnit::DataPort::SenderState(gpuDynInst, 0, nullptr));
+               dataSenderStatePool.acquire(gpuDynInst, 0, nullptr));
 
             EventFunctionWrapper *mem_req_event =
               memPort[0]->createMemReqEvent(pkt);
@@ -1238,7 +1462,7 @@ ComputeUnit::injectGlobalMemFence(GPUDynInstPtr gpuDynInst,
           req->setFlags(Request::KERNEL);
           pkt = new Packet(req, MemCmd::MemSyncReq);
           pkt->pushSenderState(
-             new ComputeUnit::DataPort::SenderState(gpuDynInst, 0, nullptr));
+             dataSenderStatePool.acquire(gpuDynInst, 0, nullptr));
 
           EventFunctionWrapper *mem_req_event =
             memPort[0]->createMemReqEvent(pkt);
@@ -1256,7 +1480,7 @@ ComputeUnit::injectGlobalMemFence(GPUDynInstPtr gpuDynInst,
 
         pkt = new Packet(req, MemCmd::MemSyncReq);
         pkt->pushSenderState(
-            new ComputeUnit::DataPort::SenderState(gpuDynInst, 0, nullptr));
+            dataSenderStatePool.acquire(gpuDynInst, 0, nullptr));
 
         EventFunctionWrapper *mem_req_event =
           memPort[0]->createMemReqEvent(pkt);
@@ -1287,6 +1511,11 @@ ComputeUnit::DataPort::processMemRespEvent(PacketPtr pkt)
 
     Addr paddr = pkt->req->getPaddr();
 
+    if (compute_unit->shader->trace()) {
+        compute_unit->shader->trace()->record(GPUTrace::MEM_RESP,
+            gpuDynInst->wavefront(), gpuDynInst->seqNum(), paddr);
+    }
+
     // mem sync resp and write-complete callback must be handled already in
     // DataPort::recvTimingResp
     assert(pkt->cmd != MemCmd::MemSyncResp);
@@ -1301,6 +1530,10 @@ ComputeUnit::DataPort::processMemRespEvent(PacketPtr pkt)
     gpuDynInst->memStatusVector[paddr].pop_back();
     gpuDynInst->pAddr = pkt->req->getPaddr();
 
+    if (pkt->isRead()) {
+        gpuDynInst->scatterCoalescedData(index);
+    }
+
     gpuDynInst->decrementStatusVector(index);
     DPRINTF(GPUMem, "bitvector is now %s\n", gpuDynInst->printStatusVector());
 
@@ -1342,7 +1575,7 @@ ComputeUnit::DataPort::processMemRespEvent(PacketPtr pkt)
         }
     }
 
-    delete pkt->senderState;
+    compute_unit->dataSenderStatePool.release(sender_state);
     delete pkt->req;
     delete pkt;
 }
@@ -1499,13 +1732,14 @@ ComputeUnit::DTLBPort::recvTimingResp(PacketPtr pkt)
     // the request can be sent through the cu's master port
     PacketPtr new_pkt = new Packet(pkt->req, requestCmd);
     new_pkt->dataStatic(pkt->getPtr<uint8_t>());
-    delete pkt->senderState;
+    computeUnit->vmemReqHeapAllocs++;
+    computeUnit->dtlbSenderStatePool.release(sender_state);
     delete pkt;
 
     // New SenderState for the memory access
     new_pkt->senderState =
-            new ComputeUnit::DataPort::SenderState(gpuDynInst, mp_index,
-                                                   nullptr);
+        computeUnit->acquireSenderState(computeUnit->dataSenderStatePool,
+                                        gpuDynInst, mp_index, nullptr);
 
     // translation is done. Schedule the mem_req_event at the appropriate
     // cycle to send the timing memory request to ruby
@@ -1731,6 +1965,7 @@ ComputeUnit::ITLBPort::recvTimingResp(PacketPtr pkt)
         }
 
         wavefront->pendingFetch = 0;
+        computeUnit->wakeup();
     }
 
     return true;
@@ -1918,6 +2153,39 @@ ComputeUnit::regStats()
     scalarMemInstsPerKiloInst =
         ((scalarMemReads + scalarMemWrites) / numInstrExecuted) * 1000;
 
+    dynInstBufReuses
+        .name(name() + ".dyn_inst_buf_reuses")
+        .desc("Number of GPUDynInst data buffers reused from the pool")
+        ;
+    dynInstBufHeapAllocs
+        .name(name() + ".dyn_inst_buf_heap_allocs")
+        .desc("Number of GPUDynInst data buffers allocated on the heap")
+        ;
+    vmemReqHeapAllocs
+        .name(name() + ".vmem_req_heap_allocs")
+        .desc("Number of Request, Packet, AtomicOpFunctor and TLB "
+              "TranslationState objects allocated for vector memory insts")
+        ;
+    vmemSenderStateReuses
+        .name(name() + ".vmem_sender_state_reuses")
+        .desc("Number of vector memory packet sender states reused from "
+              "the pool")
+        ;
+    vmemSenderStateHeapAllocs
+        .name(name() + ".vmem_sender_state_heap_allocs")
+        .desc("Number of vector memory packet sender states allocated on "
+              "the heap")
+        ;
+    vmemHeapAllocsPerVMemInst
+        .name(name() + ".vmem_heap_allocs_per_vmem_inst")
+        .desc("Number of heap allocations per vector memory inst "
+              "(including FLAT insts), counting GPUDynInst data buffers "
+              "and the objects of each lane's packets")
+        ;
+    vmemHeapAllocsPerVMemInst = (dynInstBufHeapAllocs + vmemReqHeapAllocs +
+        vmemSenderStateHeapAllocs) /
+        (vectorMemReads + vectorMemWrites + flatVMemInsts);
+
     instCyclesVMemPerSimd
        .init(numVectorALUs)
        .name(name() + ".inst_cycles_vector_memory")
@@ -2075,6 +2343,18 @@ ComputeUnit::regStats()
        .desc("Number of bank conflicts per LDS memory packet")
        ;
 
+    ldsBankConflictsPerKernel
+        .init(0)
+        .name(name() + ".lds_bank_conflicts_per_kernel")
+        .desc("Cycles lost to LDS bank conflicts by kernel dispatch ID")
+        ;
+
+    ldsBankConflictsPerPc
+        .init(0)
+        .name(name() + ".lds_bank_conflicts_per_pc")
+        .desc("Cycles lost to LDS bank conflicts by instruction PC")
+        ;
+
     ldsBankAccesses
         .name(name() + ".lds_bank_access_cnt")
         .desc("Total number of LDS bank accesses")
@@ -2101,6 +2381,16 @@ ComputeUnit::regStats()
         .desc("number of active lanes per global memory instruction")
         ;
 
+    coalescedMemReqs
+        .name(name() + ".coalesced_mem_reqs")
+        .desc("number of vector memory requests issued for several lanes")
+        ;
+
+    coalescedLaneReqs
+        .name(name() + ".coalesced_lane_reqs")
+        .desc("number of lane requests merged into coalesced requests")
+        ;
+
     activeLanesPerLMemInstrDist
         .init(1, wfSize(), 4)
         .name(name() + ".lmem_lanes_execution_dist")
@@ -2112,6 +2402,23 @@ ComputeUnit::regStats()
         .desc("number of instructions executed")
         ;
 
+    numFunctionalInstExecuted
+        .name(name() + ".num_functional_instr_executed")
+        .desc("number of instructions executed functionally")
+        ;
+
+    vectorInstSrcOperand
+        .init(4)
+        .name(name() + ".vec_inst_src_operand")
+        .desc("vector instruction source operand distribution")
+        ;
+
+    vectorInstDstOperand
+        .init(4)
+        .name(name() + ".vec_inst_dst_operand")
+        .desc("vector instruction destination operand distribution")
+        ;
+
     numVecOpsExecuted
         .name(name() + ".num_vec_ops_executed")
         .desc("number of vec ops executed (e.g. WF size/inst)")
@@ -2187,6 +2494,17 @@ ComputeUnit::regStats()
         .desc("number of cycles the CU ran for")
         ;
 
+    idleCyclesSkipped
+        .name(name() + ".idle_cycles_skipped")
+        .desc("number of cycles the CU did not tick because all of its "
+              "waves were blocked on external events")
+        ;
+
+    numIdleSleeps
+        .name(name() + ".num_idle_sleeps")
+        .desc("number of times the CU stopped ticking with active waves")
+        ;
+
     ipc
         .name(name() + ".ipc")
         .desc("Instructions per cycle (this CU only)")
@@ -2222,6 +2540,19 @@ ComputeUnit::regStats()
         .desc("Workgroup blocked due to LDS capacity")
         ;
 
+    wgBlockedDueLdsFragmentation
+        .name(name() + ".wg_blocked_due_lds_frag")
+        .desc("Workgroup blocked due to LDS fragmentation, i.e., enough "
+              "LDS space was free but not contiguous")
+        ;
+
+    ldsOccupancy
+        .init(0, 100, 10)
+        .name(name() + ".lds_occupancy")
+        .desc("Percent of the LDS allocated to workgroups, sampled at each "
+              "workgroup dispatch")
+        ;
+
     ipc = numInstrExecuted / totalCycles;
     vpc = numVecOpsExecuted / totalCycles;
     vpc_f16 = numVecOpsExecutedF16 / totalCycles;
@@ -2240,6 +2571,13 @@ ComputeUnit::regStats()
               "SIMD")
         ;
 
+    numWfsBlockedDueRegAlloc
+        .name(name() + ".wfs_blocked_due_reg_alloc")
+        .desc("Number of WFs that could not be mapped to a free WF slot "
+              "due to VGPR or SGPR allocation, summed over dispatch "
+              "attempts")
+        ;
+
     dynamicGMemInstrCnt
         .name(name() + ".global_mem_instr_cnt")
         .desc("dynamic non-flat global memory instruction count")
@@ -2325,8 +2663,7 @@ ComputeUnit::updateInstStats(GPUDynInstPtr gpuDynInst)
         }
     } else {
         if (gpuDynInst->isALU()) {
-            shader->total_valu_insts++;
-            if (shader->total_valu_insts == shader->max_valu_insts) {
+            if (++shader->total_valu_insts == shader->max_valu_insts) {
                 exitSimLoop("max vALU insts");
             }
             vALUInsts++;
@@ -2475,11 +2812,26 @@ ComputeUnit::isDone() const
     return true;
 }
 
+bool
+ComputeUnit::isQuiescent() const
+{
+    // the SCB stage runs after the SCH stage, so the ready lists hold the
+    // waves that will be considered for scheduling next cycle
+    for (const auto &ready_list : readyList) {
+        if (!ready_list.empty()) {
+            return false;
+        }
+    }
+
+    return scheduleStage.isQuiescent() && fetchStage.isQuiescent() &&
+        globalMemoryPipe.isQuiescent() && localMemoryPipe.isQuiescent() &&
+        scalarMemoryPipe.isQuiescent();
+}
+
 int32_t
-ComputeUnit::getRefCounter(const uint32_t dispatchId,
-    const uint32_t wgId) const
+ComputeUnit::getRefCounter(const LdsChunk *ldsChunk) const
 {
-    return lds.getRefCounter(dispatchId, wgId);
+    return lds.getRefCounter(ldsChunk);
 }
 
 bool
@@ -2536,6 +2888,7 @@ ComputeUnit::LDSPort::recvTimingResp(PacketPtr packet)
     delete packet;
 
     computeUnit->localMemoryPipe.getLMRespFIFO().push(gpuDynInst);
+    computeUnit->wakeup();
     return true;
 }
 
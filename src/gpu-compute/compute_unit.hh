@@ -39,7 +39,9 @@
 
 #include <deque>
 #include <map>
+#include <set>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
 #include "base/callback.hh"
@@ -52,6 +54,7 @@
 #include "gpu-compute/global_memory_pipeline.hh"
 #include "gpu-compute/hsa_queue_entry.hh"
 #include "gpu-compute/local_memory_pipeline.hh"
+#include "gpu-compute/misc.hh"
 #include "gpu-compute/register_manager.hh"
 #include "gpu-compute/scalar_memory_pipeline.hh"
 #include "gpu-compute/schedule_stage.hh"
@@ -85,7 +88,10 @@ enum TLB_CACHE
 class ComputeUnit : public MemObject
 {
   public:
-
+    // Recycled per-lane data buffers of this CU's GPUDynInsts. This is
+    // declared first so that it outlives the pipeline structures that
+    // hold instructions.
+    BufferPool dynInstDataPool;
 
     // Execution resources
     //
@@ -204,6 +210,11 @@ class ComputeUnit : public MemObject
     ScalarMemPipeline scalarMemoryPipe;
 
     EventFunctionWrapper tickEvent;
+    // executes the WFs of functionally executed kernels, see
+    // execFunctional()
+    EventFunctionWrapper functionalExecEvent;
+    std::vector<Wavefront*> functionalWfs;
+    TheGpuISA::Decoder functionalDecoder;
 
     typedef ComputeUnitParams Params;
     std::vector<std::vector<Wavefront*>> wfList;
@@ -268,6 +279,12 @@ class ComputeUnit : public MemObject
     int idleWfs;
     bool functionalTLB;
     bool localMemBarrier;
+    // if set, the CU stops ticking while no stage can make progress
+    // without an external event, see isQuiescent()
+    bool idleCycleSkip;
+    // if set, per-lane accesses to the same cache line are merged into
+    // a single request, see initMemReqHelper()
+    bool coalesceVectorMem;
 
     /*
      * for Counting page accesses
@@ -293,6 +310,14 @@ class ComputeUnit : public MemObject
      */
     std::vector<int> numWfsToSched;
 
+    /**
+     * The free WF slots as (WF slot ID, SIMD ID) pairs. The set is
+     * ordered as the slots are searched when a WG is dispatched, so it
+     * is only walked over the slots that can take a WF. It is updated
+     * when WFs start and stop, see wfSlotOccupied() and wfSlotFreed().
+     */
+    std::set<std::pair<int, int>> freeWfSlots;
+
     // number of currently reserved vector registers per SIMD unit
     std::vector<int> vectorRegsReserved;
     // number of currently reserved scalar registers per SIMD unit
@@ -326,6 +351,15 @@ class ComputeUnit : public MemObject
     int wfSize() const { return wavefrontSize; }
 
     void exec();
+    /**
+     * Resume ticking a CU that went to sleep because it was quiescent.
+     * Called by every path that delivers new work to the CU from outside
+     * of its tick (memory and fetch responses, register file events,
+     * scheduled counter updates and workgroup dispatch). Does nothing if
+     * the CU is not sleeping.
+     */
+    void wakeup();
+    bool isSleeping() const { return sleeping; }
     void initiateFetch(Wavefront *wavefront);
     void fetch(PacketPtr pkt, Wavefront *wavefront);
     void fillKernelState(Wavefront *w, HSAQueueEntry *task);
@@ -338,6 +372,23 @@ class ComputeUnit : public MemObject
 
     void dispWorkgroup(HSAQueueEntry *task, bool startFromScheduler=false);
     bool hasDispResources(HSAQueueEntry *task);
+    void wfSlotOccupied(Wavefront *w);
+    void wfSlotFreed(Wavefront *w);
+
+    /**
+     * Run the WFs of the functionally executed workgroups dispatched to
+     * this CU to completion, in zero time. The WFs take turns, so those
+     * waiting at a barrier, or spinning on a value written by another
+     * WF, let the others make progress.
+     */
+    void execFunctional();
+    /**
+     * Perform the memory access of an instruction executed by
+     * Wavefront::execFunctional(). The memory pipelines call this in
+     * place of queuing the instruction, and the access has completed,
+     * including the register writes, when it returns.
+     */
+    void execFunctionalAccess(GPUDynInstPtr gpuDynInst);
 
     int cacheLineSize() const { return _cacheLineSize; }
     int getCacheLineBits() const { return cacheLineBits; }
@@ -367,6 +418,13 @@ class ComputeUnit : public MemObject
     MasterID masterId() { return _masterId; }
 
     bool isDone() const;
+    /**
+     * True if no pipeline stage can make progress until an external
+     * event arrives, i.e., there are no ready waves, the schedule stage
+     * and memory pipelines are empty, and the fetch units have nothing
+     * to fetch or decode.
+     */
+    bool isQuiescent() const;
     bool isVectorAluIdle(uint32_t simdId) const;
 
   protected:
@@ -405,6 +463,15 @@ class ComputeUnit : public MemObject
     Stats::Formula scalarMemWritesPerKiloInst;
     Stats::Formula scalarMemInstsPerKiloInst;
 
+    // where the data buffers of new GPUDynInsts came from
+    Stats::Scalar dynInstBufReuses;
+    Stats::Scalar dynInstBufHeapAllocs;
+    // objects allocated for the per-lane packets of vector memory insts
+    Stats::Scalar vmemReqHeapAllocs;
+    Stats::Scalar vmemSenderStateReuses;
+    Stats::Scalar vmemSenderStateHeapAllocs;
+    Stats::Formula vmemHeapAllocsPerVMemInst;
+
     // Cycles required to send register source (addr and data) from
     // register files to memory pipeline, per SIMD.
     Stats::Vector instCyclesVMemPerSimd;
@@ -448,6 +515,10 @@ class ComputeUnit : public MemObject
 
     Stats::Scalar ldsBankAccesses;
     Stats::Distribution ldsBankConflictDist;
+    // cycles lost to LDS bank conflicts by kernel (dispatch ID) and by
+    // instruction (its PC)
+    Stats::SparseHistogram ldsBankConflictsPerKernel;
+    Stats::SparseHistogram ldsBankConflictsPerPc;
 
     // over all memory instructions executed over all wavefronts
     // how many touched 0-4 pages, 4-8, ..., 60-64 pages
@@ -459,10 +530,19 @@ class ComputeUnit : public MemObject
     Stats::Scalar dynamicLMemInstrCnt;
 
     Stats::Scalar wgBlockedDueLdsAllocation;
+    Stats::Scalar wgBlockedDueLdsFragmentation;
+    Stats::Distribution ldsOccupancy;
     // Number of instructions executed, i.e. if 64 (or 32 or 7) lanes are
     // active when the instruction is committed, this number is still
     // incremented by 1
     Stats::Scalar numInstrExecuted;
+    // number of instructions executed functionally, these are not
+    // included in any of the other instruction counts
+    Stats::Scalar numFunctionalInstExecuted;
+    // vector operand counts of executed instructions, summed across all
+    // CUs by the shader
+    Stats::Vector vectorInstSrcOperand;
+    Stats::Vector vectorInstDstOperand;
     // Number of cycles among successive instruction executions across all
     // wavefronts of the same CU
     Stats::Distribution execRateDist;
@@ -490,6 +570,11 @@ class ComputeUnit : public MemObject
     Stats::Scalar numVecOpsExecutedTwoOpFP;
     // Total cycles that something is running on the GPU
     Stats::Scalar totalCycles;
+    // Cycles the CU did not tick because it was quiescent. These are
+    // included in totalCycles.
+    Stats::Scalar idleCyclesSkipped;
+    // Number of times the CU went to sleep while it had active waves
+    Stats::Scalar numIdleSleeps;
     Stats::Formula vpc; // vector ops per cycle
     Stats::Formula vpc_f16; // vector ops per cycle
     Stats::Formula vpc_f32; // vector ops per cycle
@@ -497,6 +582,10 @@ class ComputeUnit : public MemObject
     Stats::Formula ipc; // vector instructions per cycle
     Stats::Distribution controlFlowDivergenceDist;
     Stats::Distribution activeLanesPerGMemInstrDist;
+    // number of requests issued on behalf of several lanes, and the number
+    // of lane requests they replaced
+    Stats::Scalar coalescedMemReqs;
+    Stats::Scalar coalescedLaneReqs;
     Stats::Distribution activeLanesPerLMemInstrDist;
     // number of vector ALU instructions received
     Stats::Formula numALUInstsExecuted;
@@ -504,6 +593,9 @@ class ComputeUnit : public MemObject
     Stats::Scalar numTimesWgBlockedDueVgprAlloc;
     // number of times a WG can not start due to lack of free SGPRs in SIMDs
     Stats::Scalar numTimesWgBlockedDueSgprAlloc;
+    // number of WFs of the WGs that can not start due to lack of free
+    // VGPRs or SGPRs in SIMDs
+    Stats::Scalar numWfsBlockedDueRegAlloc;
     Stats::Scalar numCASOps;
     Stats::Scalar numFailedCASOps;
     Stats::Scalar completedWfs;
@@ -523,7 +615,7 @@ class ComputeUnit : public MemObject
     }
 
     int32_t
-    getRefCounter(const uint32_t dispatchId, const uint32_t wgId) const;
+    getRefCounter(const LdsChunk *ldsChunk) const;
 
     bool
     sendToLds(GPUDynInstPtr gpuDynInst) __attribute__((warn_unused_result));
@@ -910,6 +1002,9 @@ class ComputeUnit : public MemObject
     std::vector<DataPort*> memPort;
     // port to the TLB hierarchy (i.e., the L1 TLB)
     std::vector<DTLBPort*> tlbPort;
+    // recycled sender states of the per-lane vector memory packets
+    ObjectPool<DTLBPort::SenderState> dtlbSenderStatePool;
+    ObjectPool<DataPort::SenderState> dataSenderStatePool;
     // port to the scalar data cache
     ScalarDataPort *scalarDataPort;
     // port to the scalar data TLB
@@ -958,12 +1053,32 @@ class ComputeUnit : public MemObject
 
     InstSeqNum getAndIncSeqNum() { return globalSeqNum++; }
 
+    // take a sender state for a vector memory packet from one of the
+    // pools above, counting whether it had to be allocated
+    template<typename T, typename... Args>
+    T*
+    acquireSenderState(ObjectPool<T> &pool, Args&&... args)
+    {
+        if (pool.empty()) {
+            vmemSenderStateHeapAllocs++;
+        } else {
+            vmemSenderStateReuses++;
+        }
+
+        return pool.acquire(std::forward<Args>(args)...);
+    }
+
   private:
     const int _cacheLineSize;
     int cacheLineBits;
     InstSeqNum globalSeqNum;
     int wavefrontSize;
 
+    // true while the CU is not ticking because it is quiescent
+    bool sleeping;
+    // cycle of the last exec() before the CU went to sleep
+    Cycles sleepCycle;
+
     // hold the time of the arrival of the first cache block related to
     // a particular GPUDynInst. This is used to calculate the difference
     // between the first and last chace block arrival times.
@@ -38,6 +38,13 @@
 
 #include "gpu-compute/dispatcher.hh"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "base/callback.hh"
+#include "base/output.hh"
+#include "debug/Drain.hh"
 #include "debug/GPUDisp.hh"
 #include "debug/GPUKernelInfo.hh"
 #include "debug/GPUWgLatency.hh"
@@ -45,6 +52,7 @@
 #include "gpu-compute/hsa_queue_entry.hh"
 #include "gpu-compute/shader.hh"
 #include "gpu-compute/wavefront.hh"
+#include "sim/sim_exit.hh"
 #include "sim/syscall_emul_buf.hh"
 #include "sim/system.hh"
 
@@ -52,9 +60,20 @@ GPUDispatcher::GPUDispatcher(const Params *p)
     : SimObject(p), shader(nullptr), gpuCmdProc(nullptr),
       tickEvent([this]{ exec(); },
           "GPU Dispatcher tick", false, Event::CPU_Tick_Pri),
-      dispatchActive(false)
+      nextExecQueue(0), dispatchActive(false),
+      functionalKernels(p->functional_kernels.begin(),
+                        p->functional_kernels.end()),
+      functionalKernelNames(p->functional_kernel_names.begin(),
+                            p->functional_kernel_names.end()),
+      fastForwardKernels(p->fast_forward_kernels),
+      samplePeriod(p->sample_period), sampleFile(p->sample_file)
 {
     schedule(&tickEvent, 0);
+
+    if (samplePeriod) {
+        registerExitCallback(new MakeCallback<GPUDispatcher,
+            &GPUDispatcher::dumpKernelSamples>(this, true));
+    }
 }
 
 GPUDispatcher::~GPUDispatcher()
@@ -69,11 +88,42 @@ GPUDispatcher::regStats()
     .desc("number of kernel launched")
     ;
 
+    numFunctionalKernels
+    .name(name() + ".num_functional_kernels")
+    .desc("number of kernels executed functionally")
+    ;
+
     cyclesWaitingForDispatch
     .name(name() + ".cycles_wait_dispatch")
     .desc("number of cycles with outstanding wavefronts "
           "that are waiting to be dispatched")
     ;
+
+    queueKernelsCompleted
+        .init(0)
+        .name(name() + ".queue_kernels_completed")
+        .desc("number of kernels completed by HSA queue ID")
+        ;
+
+    queueWgsCompleted
+        .init(0)
+        .name(name() + ".queue_wgs_completed")
+        .desc("number of WGs completed by HSA queue ID")
+        ;
+
+    queueKernelTicks
+        .init(0)
+        .name(name() + ".queue_kernel_ticks")
+        .desc("total ticks from launch to completion of the kernels "
+              "by HSA queue ID")
+        ;
+
+    queueDispatchWaitTicks
+        .init(0)
+        .name(name() + ".queue_dispatch_wait_ticks")
+        .desc("total ticks from launch to the dispatch of the first WG "
+              "of the kernels by HSA queue ID")
+        ;
 }
 
 HSAQueueEntry*
@@ -104,6 +154,44 @@ GPUDispatcher::serialize(CheckpointOut &cp) const
         event_tick = tickEvent.when();
 
     SERIALIZE_SCALAR(event_tick);
+    SERIALIZE_SCALAR(dispatchActive);
+
+    // the kernels to launch are restored to the queues of their tasks
+    std::vector<int> exec_ids;
+
+    for (const auto &queue : execIds) {
+        exec_ids.insert(exec_ids.end(), queue.second.begin(),
+                        queue.second.end());
+    }
+
+    SERIALIZE_CONTAINER(exec_ids);
+    SERIALIZE_SCALAR(nextExecQueue);
+
+    // save the kernels in execution along with their progress, and
+    // the location of their dispatch packets in the AQL buffers
+    std::vector<int> task_ids;
+    std::vector<uint32_t> task_pkt_idx;
+    std::vector<Tick> task_launch_ticks;
+
+    for (const auto &entry : hsaQueueEntries) {
+        HSAQueueEntry *task = entry.second;
+
+        if (task->numWgCompleted() == task->numWgTotal()) {
+            continue;
+        }
+
+        auto aql_buf = gpuCmdProc->hsaPacketProc()
+            .getRegdListEntry(task->queueId())->qCntxt.aqlBuf;
+
+        task_ids.push_back(entry.first);
+        task_pkt_idx.push_back(aql_buf->pktIdx(task->dispPktPtr()));
+        task_launch_ticks.push_back(launchTicks.at(entry.first));
+        task->serializeSection(cp, csprintf("task%d", entry.first));
+    }
+
+    SERIALIZE_CONTAINER(task_ids);
+    SERIALIZE_CONTAINER(task_pkt_idx);
+    SERIALIZE_CONTAINER(task_launch_ticks);
 }
 
 void
@@ -115,10 +203,94 @@ GPUDispatcher::unserialize(CheckpointIn &cp)
         deschedule(&tickEvent);
 
     UNSERIALIZE_SCALAR(event_tick);
+    UNSERIALIZE_SCALAR(dispatchActive);
 
     if (event_tick) {
         schedule(&tickEvent, event_tick);
     }
+
+    std::vector<int> exec_ids;
+
+    UNSERIALIZE_CONTAINER(exec_ids);
+    UNSERIALIZE_SCALAR(nextExecQueue);
+
+    std::vector<int> task_ids;
+    std::vector<uint32_t> task_pkt_idx;
+    std::vector<Tick> task_launch_ticks;
+
+    UNSERIALIZE_CONTAINER(task_ids);
+    UNSERIALIZE_CONTAINER(task_pkt_idx);
+    UNSERIALIZE_CONTAINER(task_launch_ticks);
+
+    for (int i = 0; i < task_ids.size(); ++i) {
+        HSAQueueEntry *task = new HSAQueueEntry();
+        task->unserializeSection(cp, csprintf("task%d", task_ids[i]));
+
+        hsaQueueEntries.emplace(task_ids[i], task);
+        restoredPktIdx[task_ids[i]] = task_pkt_idx[i];
+        launchTicks[task_ids[i]] = task_launch_ticks[i];
+    }
+
+    for (auto exec_id : exec_ids) {
+        execIds[hsaQueueEntries.at(exec_id)->hsaQueueId()]
+            .push_back(exec_id);
+    }
+}
+
+void
+GPUDispatcher::startup()
+{
+    for (const auto &entry : restoredPktIdx) {
+        HSAQueueEntry *task = hsaQueueEntries.at(entry.first);
+        auto aql_buf = gpuCmdProc->hsaPacketProc()
+            .getRegdListEntry(task->queueId())->qCntxt.aqlBuf;
+
+        panic_if(!aql_buf, "Queue %d of restored kernel %d is not mapped\n",
+                 task->queueId(), entry.first);
+
+        task->dispPktPtr(aql_buf->ptr(entry.second));
+    }
+
+    restoredPktIdx.clear();
+}
+
+bool
+GPUDispatcher::isDrained() const
+{
+    for (const auto &entry : hsaQueueEntries) {
+        HSAQueueEntry *task = entry.second;
+
+        if (task->globalWgId() != task->numWgCompleted() ||
+            task->outstandingInvs() > 0 || task->outstandingWbs()) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void
+GPUDispatcher::checkDrain()
+{
+    if (drainState() == DrainState::Draining && isDrained()) {
+        DPRINTF(Drain, "GPUDispatcher done draining\n");
+        signalDrainDone();
+    }
+}
+
+DrainState
+GPUDispatcher::drain()
+{
+    return isDrained() ? DrainState::Drained : DrainState::Draining;
+}
+
+void
+GPUDispatcher::drainResume()
+{
+    // WGs are not dispatched while draining, so restart dispatch
+    if (!execIds.empty() && !tickEvent.scheduled()) {
+        schedule(&tickEvent, curTick() + shader->clockPeriod());
+    }
 }
 
 /**
@@ -135,7 +307,41 @@ GPUDispatcher::dispatch(HSAQueueEntry *task)
     DPRINTF(GPUDisp, "launching kernel: %s, dispatch ID: %d\n",
             task->kernelName(), task->dispatchId());
 
-    execIds.push(task->dispatchId());
+    KernelSamples &samples = kernelSamples[task->kernelName()];
+
+    // when sampling, only the first of every samplePeriod launches of
+    // each kernel is executed in detail
+    bool skip_sample = samplePeriod && samples.launches % samplePeriod;
+    ++samples.launches;
+    launchTicks[task->dispatchId()] = curTick();
+
+    if (isFunctional(task) || skip_sample) {
+        DPRINTF(GPUDisp, "kernel %d will be executed functionally\n",
+                task->dispatchId());
+        task->setFunctional(true);
+        ++numFunctionalKernels;
+    } else {
+        if (shader->instProfiler()) {
+            shader->instProfiler()->beginKernel(task->dispatchId(),
+                                                task->kernelName());
+        }
+        if (shader->trace()) {
+            shader->trace()->kernelLaunch(task->dispatchId(),
+                                          task->kernelName());
+        }
+    }
+
+    bool cu_enabled = false;
+
+    for (int cu = 0; cu < shader->n_cu; ++cu) {
+        cu_enabled |= task->cuEnabled(cu);
+    }
+
+    fatal_if(!cu_enabled, "The CU mask of HSA queue %d enables no CU, "
+             "kernel %d cannot be dispatched\n", task->hsaQueueId(),
+             task->dispatchId());
+
+    execIds[task->hsaQueueId()].push_back(task->dispatchId());
     dispatchActive = true;
     hsaQueueEntries.emplace(task->dispatchId(), task);
 
@@ -147,81 +353,67 @@ GPUDispatcher::dispatch(HSAQueueEntry *task)
 void
 GPUDispatcher::exec()
 {
-    int fail_count(0);
+    // no WG is dispatched while draining, see drainResume()
+    if (drainState() == DrainState::Draining) {
+        return;
+    }
 
     /**
      * There are potentially multiple outstanding kernel launches.
      * It is possible that the workgroups in a different kernel
      * can fit on the GPU even if another kernel's workgroups cannot
      */
-    DPRINTF(GPUDisp, "Launching %d Kernels\n", execIds.size());
+    int num_kernels = 0;
+    std::vector<uint32_t> queue_ids;
+
+    for (const auto &queue : execIds) {
+        num_kernels += queue.second.size();
+        queue_ids.push_back(queue.first);
+    }
 
-    if (execIds.size() > 0) {
+    DPRINTF(GPUDisp, "Launching %d Kernels\n", num_kernels);
+
+    if (num_kernels > 0) {
         ++cyclesWaitingForDispatch;
     }
 
     /**
-     * dispatch work cannot start until the kernel's invalidate is
-     * completely finished; hence, kernel will always initiates
-     * invalidate first and keeps waiting until inv done
+     * the HSA queues are served in order of their priority, and
+     * round robin among queues of the same priority, so that the
+     * first queue served gets its turn last the next time. all
+     * kernels are tried, even if an earlier one cannot dispatch a
+     * WG, as their WGs may be smaller or go to other CUs
      */
-    while (execIds.size() > fail_count) {
-        int exec_id = execIds.front();
-        auto task = hsaQueueEntries[exec_id];
-        bool launched(false);
-
-        // acq is needed before starting dispatch
-        if (shader->impl_kern_launch_acq) {
-            // try to invalidate cache
-            shader->prepareInvalidate(task);
-        } else {
-            // kern launch acquire is not set, skip invalidate
-            task->markInvDone();
-        }
-
-        /**
-         * invalidate is still ongoing, put the kernel on the queue to
-         * retry later
-         */
-        if (!task->isInvDone()){
-            execIds.push(exec_id);
-            ++fail_count;
-
-            DPRINTF(GPUDisp, "kernel %d failed to launch, due to [%d] pending"
-                " invalidate requests\n", exec_id, task->outstandingInvs());
+    std::rotate(queue_ids.begin(),
+                std::lower_bound(queue_ids.begin(), queue_ids.end(),
+                                 nextExecQueue),
+                queue_ids.end());
+    std::stable_sort(queue_ids.begin(), queue_ids.end(),
+        [this](uint32_t a, uint32_t b)
+        {
+            return hsaQueueEntries.at(execIds.at(a).front())->priority() >
+                hsaQueueEntries.at(execIds.at(b).front())->priority();
+        });
+
+    if (!queue_ids.empty()) {
+        nextExecQueue = queue_ids.front() + 1;
+    }
 
-            // try the next kernel_id
-            execIds.pop();
-            continue;
-        }
+    for (auto queue_id : queue_ids) {
+        std::deque<int> &exec_ids = execIds.at(queue_id);
 
-        // kernel invalidate is done, start workgroup dispatch
-        while (!task->dispComplete()) {
-            // update the thread context
-            shader->updateContext(task->contextId());
-
-            // attempt to dispatch workgroup
-            DPRINTF(GPUWgLatency, "Attempt Kernel Launch cycle:%d kernel:%d\n",
-                curTick(), exec_id);
-
-            if (!shader->dispatchWorkgroups(task)) {
-                /**
-                 * if we failed try the next kernel,
-                 * it may have smaller workgroups.
-                 * put it on the queue to rety latter
-                 */
-                DPRINTF(GPUDisp, "kernel %d failed to launch\n", exec_id);
-                execIds.push(exec_id);
-                ++fail_count;
-                break;
-            } else if (!launched) {
-                launched = true;
-                DPRINTF(GPUKernelInfo, "Launched kernel %d\n", exec_id);
+        // the kernels of a queue are tried in submission order
+        for (auto exec_id = exec_ids.begin(); exec_id != exec_ids.end();) {
+            if (dispatchKernel(*exec_id)) {
+                exec_id = exec_ids.erase(exec_id);
+            } else {
+                ++exec_id;
             }
         }
 
-        // try the next kernel_id
-        execIds.pop();
+        if (exec_ids.empty()) {
+            execIds.erase(queue_id);
+        }
     }
 
     DPRINTF(GPUDisp, "Returning %d Kernels\n", doneIds.size());
@@ -232,9 +424,84 @@ GPUDispatcher::exec()
     }
 }
 
+bool
+GPUDispatcher::dispatchKernel(int exec_id)
+{
+    auto task = hsaQueueEntries[exec_id];
+    bool launched(false);
+
+    /**
+     * dispatch work cannot start until the kernel's invalidate is
+     * completely finished; hence, kernel will always initiates
+     * invalidate first and keeps waiting until inv done
+     */
+    // acq is needed before starting dispatch, functional kernels
+    // do not access the caches and need no acquire
+    if (shader->impl_kern_launch_acq && !task->functional()) {
+        // try to invalidate cache
+        shader->prepareInvalidate(task);
+    } else {
+        // kern launch acquire is not set, skip invalidate
+        task->markInvDone();
+    }
+
+    /**
+     * invalidate is still ongoing, leave the kernel on its queue to
+     * retry later
+     */
+    if (!task->isInvDone()){
+        DPRINTF(GPUDisp, "kernel %d failed to launch, due to [%d] pending"
+            " invalidate requests\n", exec_id, task->outstandingInvs());
+        return false;
+    }
+
+    // kernel invalidate is done, start workgroup dispatch
+    while (!task->dispComplete()) {
+        // update the thread context
+        shader->updateContext(task->contextId());
+
+        // attempt to dispatch workgroup
+        DPRINTF(GPUWgLatency, "Attempt Kernel Launch cycle:%d kernel:%d\n",
+            curTick(), exec_id);
+
+        bool first_wg = task->globalWgId() == 0;
+
+        if (!shader->dispatchWorkgroups(task)) {
+            /**
+             * if we failed try the next kernel,
+             * it may have smaller workgroups.
+             * leave it on its queue to rety latter
+             */
+            DPRINTF(GPUDisp, "kernel %d failed to launch\n", exec_id);
+            return false;
+        }
+
+        if (first_wg) {
+            queueDispatchWaitTicks.sample(task->hsaQueueId(),
+                                          curTick() - launchTicks[exec_id]);
+        }
+
+        if (!launched) {
+            launched = true;
+            DPRINTF(GPUKernelInfo, "Launched kernel %d\n", exec_id);
+        }
+    }
+
+    return true;
+}
+
+bool
+GPUDispatcher::isFunctional(HSAQueueEntry *task) const
+{
+    return task->dispatchId() < fastForwardKernels ||
+        functionalKernels.count(task->dispatchId()) ||
+        functionalKernelNames.count(task->kernelName());
+}
+
 bool
 GPUDispatcher::isReachingKernelEnd(Wavefront *wf)
 {
+    EventQueue::ScopedMigration migrate(eventQueue());
     int kern_id = wf->kernId;
     assert(hsaQueueEntries.find(kern_id) != hsaQueueEntries.end());
     auto task = hsaQueueEntries[kern_id];
@@ -254,6 +521,7 @@ GPUDispatcher::isReachingKernelEnd(Wavefront *wf)
  */
 void
 GPUDispatcher::updateInvCounter(int kern_id, int val) {
+    EventQueue::ScopedMigration migrate(eventQueue());
     assert(val == -1 || val == 1);
 
     auto task = hsaQueueEntries[kern_id];
@@ -263,6 +531,8 @@ GPUDispatcher::updateInvCounter(int kern_id, int val) {
     if (task->isInvDone() && !tickEvent.scheduled()) {
         schedule(&tickEvent, curTick() + shader->clockPeriod());
     }
+
+    checkDrain();
 }
 
 /**
@@ -274,10 +544,12 @@ GPUDispatcher::updateInvCounter(int kern_id, int val) {
  */
 bool
 GPUDispatcher::updateWbCounter(int kern_id, int val) {
+    EventQueue::ScopedMigration migrate(eventQueue());
     assert(val == -1 || val == 1);
 
     auto task = hsaQueueEntries[kern_id];
     task->updateOutstandingWbs(val);
+    checkDrain();
 
     // true: WB is done, false: WB is still ongoing
     return (task->outstandingWbs() == 0);
@@ -288,6 +560,7 @@ GPUDispatcher::updateWbCounter(int kern_id, int val) {
  */
 int
 GPUDispatcher::getOutstandingWbs(int kernId) {
+    EventQueue::ScopedMigration migrate(eventQueue());
     auto task = hsaQueueEntries[kernId];
 
     return task->outstandingWbs();
@@ -304,11 +577,18 @@ GPUDispatcher::getOutstandingWbs(int kernId) {
 void
 GPUDispatcher::notifyWgCompl(Wavefront *wf)
 {
+    EventQueue::ScopedMigration migrate(eventQueue());
     int kern_id = wf->kernId;
     DPRINTF(GPUDisp, "notify WgCompl %d\n", wf->wgId);
     auto task = hsaQueueEntries[kern_id];
     assert(task->dispatchId() == kern_id);
     task->notifyWgCompleted();
+    queueWgsCompleted.sample(task->hsaQueueId());
+
+    if (shader->trace() && !task->functional()) {
+        shader->trace()->wgComplete(wf->computeUnit->cu_id, kern_id,
+                                    wf->wgId);
+    }
 
     DPRINTF(GPUWgLatency, "WG Complete cycle:%d wg:%d kernel:%d cu:%d\n",
         curTick(), wf->wgId, kern_id, wf->computeUnit->cu_id);
@@ -349,6 +629,30 @@ GPUDispatcher::notifyWgCompl(Wavefront *wf)
                 "signal\n");
         }
 
+        if (!task->functional()) {
+            // update the run time statistics of the kernel's sampled
+            // launches, using Welford's algorithm
+            KernelSamples &samples = kernelSamples[task->kernelName()];
+            double ticks = curTick() - launchTicks[kern_id];
+            double delta = ticks - samples.meanTicks;
+
+            ++samples.samples;
+            samples.meanTicks += delta / samples.samples;
+            samples.m2Ticks += delta * (ticks - samples.meanTicks);
+
+            if (shader->instProfiler()) {
+                shader->instProfiler()->endKernel(kern_id);
+            }
+            if (shader->trace()) {
+                shader->trace()->kernelEnd(kern_id);
+            }
+        }
+
+        queueKernelsCompleted.sample(task->hsaQueueId());
+        queueKernelTicks.sample(task->hsaQueueId(),
+                                curTick() - launchTicks[kern_id]);
+        launchTicks.erase(kern_id);
+
         DPRINTF(GPUWgLatency, "Kernel Complete ticks:%d kernel:%d\n",
                 curTick(), kern_id);
         DPRINTF(GPUKernelInfo, "Completed kernel %d\n", kern_id);
@@ -357,16 +661,61 @@ GPUDispatcher::notifyWgCompl(Wavefront *wf)
     if (!tickEvent.scheduled()) {
         schedule(&tickEvent, curTick() + shader->clockPeriod());
     }
+
+    checkDrain();
 }
 
 void
 GPUDispatcher::scheduleDispatch()
 {
+    EventQueue::ScopedMigration migrate(eventQueue());
     if (!tickEvent.scheduled()) {
         schedule(&tickEvent, curTick() + shader->clockPeriod());
     }
 }
 
+void
+GPUDispatcher::dumpKernelSamples()
+{
+    std::ostream *os = simout.create(sampleFile)->stream();
+
+    *os << "kernel, launches, sampled launches, mean ticks, stddev ticks, "
+        "estimated ticks, 95% confidence interval (+/- ticks), "
+        "stats scale" << std::endl;
+
+    for (const auto &entry : kernelSamples) {
+        const KernelSamples &samples = entry.second;
+        double n = samples.samples;
+        double total = samples.launches;
+
+        double stddev = samples.samples > 1 ?
+            std::sqrt(samples.m2Ticks / (n - 1)) : 0;
+        double estimate = samples.meanTicks * total;
+
+        /**
+         * normal approximation of the 95% confidence interval of the
+         * estimate, with the finite population correction because the
+         * run times of the sampled launches are known exactly. with a
+         * single sample the interval is unknown, unless it is the only
+         * launch.
+         */
+        double interval = n == total ? 0 :
+            samples.samples > 1 ?
+            1.96 * total * stddev / std::sqrt(n) * std::sqrt(1 - n / total) :
+            std::numeric_limits<double>::quiet_NaN();
+
+        // factor to scale the detailed statistics, which only cover the
+        // sampled launches, by to estimate those of all launches
+        double scale = n ? total / n : 0;
+
+        // kernel names may contain commas, so quote them
+        *os << "\"" << entry.first << "\", " << samples.launches << ", "
+            << samples.samples << ", " << samples.meanTicks << ", "
+            << stddev << ", " << estimate << ", " << interval << ", "
+            << scale << std::endl;
+    }
+}
+
 GPUDispatcher *GPUDispatcherParams::create()
 {
     return new GPUDispatcher(this);
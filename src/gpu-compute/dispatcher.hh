@@ -41,14 +41,24 @@
  * for creating and dispatching WGs to the compute units. If all WGs in
  * a kernel cannot be dispatched simultaneously, then the dispatcher will
  * keep track of all pending WGs and dispatch them as resources become
- * available.
+ * available. The methods called by the CUs migrate to the dispatcher's
+ * event queue, so they are safe to use from CUs that are simulated on
+ * other queues.
+ *
+ * The dispatcher drains at WG boundaries: while draining it stops
+ * dispatching WGs and waits for the WGs in flight to complete, so the
+ * in-flight kernels can be checkpointed without any CU state.
  */
 
 #ifndef __GPU_COMPUTE_DISPATCHER_HH__
 #define __GPU_COMPUTE_DISPATCHER_HH__
 
+#include <deque>
+#include <map>
 #include <queue>
+#include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include "base/statistics.hh"
@@ -71,6 +81,9 @@ class GPUDispatcher : public SimObject
 
     void serialize(CheckpointOut &cp) const override;
     void unserialize(CheckpointIn &cp) override;
+    void startup() override;
+    DrainState drain() override;
+    void drainResume() override;
     void regStats() override;
     void setCommandProcessor(GPUCommandProcessor *gpu_cmd_proc);
     void setShader(Shader *new_shader);
@@ -83,21 +96,87 @@ class GPUDispatcher : public SimObject
     void scheduleDispatch();
     void dispatch(HSAQueueEntry *task);
     HSAQueueEntry* hsaTask(int disp_id);
+    /**
+     * Write the run time of each kernel, extrapolated from its launches
+     * that were executed in detail, to the sample file. Called on exit
+     * when sampling is enabled.
+     */
+    void dumpKernelSamples();
 
   private:
+    /**
+     * Launch and run time statistics of one kernel. The run time of a
+     * launch is measured from its dispatch to its completion, and only
+     * known for the launches executed in detail.
+     */
+    struct KernelSamples
+    {
+        // number of launches of the kernel
+        int launches = 0;
+        // number of completed launches executed in detail, and the mean
+        // and sum of squared deviations of their run times in ticks
+        int samples = 0;
+        double meanTicks = 0;
+        double m2Ticks = 0;
+    };
+
+    /**
+     * Whether the given kernel is executed functionally. Kernels are
+     * selected by their launch index or name, or because they are
+     * launched before fast-forwarding ends.
+     */
+    bool isFunctional(HSAQueueEntry *task) const;
+
+    /**
+     * Dispatch as many WGs of the given kernel as the CUs in its CU
+     * mask can accept, once its launch acquire is done. Returns true
+     * when all of its WGs are dispatched.
+     */
+    bool dispatchKernel(int exec_id);
+
+    /**
+     * Whether no WG is in flight and no kernel is waiting for its
+     * cache invalidates or writebacks to complete.
+     */
+    bool isDrained() const;
+    void checkDrain();
+
     Shader *shader;
     GPUCommandProcessor *gpuCmdProc;
     EventFunctionWrapper tickEvent;
     std::unordered_map<int, HSAQueueEntry*> hsaQueueEntries;
-    // list of kernel_ids to launch
-    std::queue<int> execIds;
+    // kernel_ids to launch of each HSA queue, in submission order
+    std::map<uint32_t, std::deque<int>> execIds;
+    // HSA queue served first among the queues of the highest priority
+    uint32_t nextExecQueue;
     // list of kernel_ids that have finished
     std::queue<int> doneIds;
     // is there a kernel in execution?
     bool dispatchActive;
+    // kernels to execute functionally, see isFunctional()
+    std::unordered_set<int> functionalKernels;
+    std::unordered_set<std::string> functionalKernelNames;
+    int fastForwardKernels;
+    // execute only one of every samplePeriod launches of a kernel in
+    // detail, 0 if sampling is disabled
+    int samplePeriod;
+    std::string sampleFile;
+    std::map<std::string, KernelSamples> kernelSamples;
+    // tick at which each kernel in execution was launched
+    std::unordered_map<int, Tick> launchTicks;
+    // index of the dispatch packet of each kernel restored from a
+    // checkpoint in its AQL buffer, the packet pointers are set in
+    // startup() once the AQL buffers are restored
+    std::unordered_map<int, uint32_t> restoredPktIdx;
     /*statistics*/
     Stats::Scalar numKernelLaunched;
+    Stats::Scalar numFunctionalKernels;
     Stats::Scalar cyclesWaitingForDispatch;
+    // per-HSA queue throughput and latency
+    Stats::SparseHistogram queueKernelsCompleted;
+    Stats::SparseHistogram queueWgsCompleted;
+    Stats::SparseHistogram queueKernelTicks;
+    Stats::SparseHistogram queueDispatchWaitTicks;
 };
 
 #endif // __GPU_COMPUTE_DISPATCHER_HH__
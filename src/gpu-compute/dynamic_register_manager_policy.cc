@@ -0,0 +1,239 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "gpu-compute/dynamic_register_manager_policy.hh"
+
+#include "base/intmath.hh"
+#include "debug/GPURename.hh"
+#include "gpu-compute/compute_unit.hh"
+#include "gpu-compute/pool_manager.hh"
+#include "gpu-compute/register_manager.hh"
+#include "gpu-compute/scalar_register_file.hh"
+#include "gpu-compute/vector_register_file.hh"
+#include "gpu-compute/wavefront.hh"
+
+DynamicRegisterManagerPolicy::DynamicRegisterManagerPolicy()
+{
+}
+
+void
+DynamicRegisterManagerPolicy::setParent(ComputeUnit *_cu)
+{
+    RegisterManagerPolicy::setParent(_cu);
+
+    RegisterManager &reg_mgr = cu->registerManager;
+
+    vrfPools.resize(reg_mgr.vrfPoolMgrs.size());
+    for (int i = 0; i < vrfPools.size(); ++i) {
+        vrfPools[i].init(reg_mgr.vrfPoolMgrs[i]->minAllocation(),
+                         cu->vrf[i]->numRegs());
+    }
+
+    srfPools.resize(reg_mgr.srfPoolMgrs.size());
+    for (int i = 0; i < srfPools.size(); ++i) {
+        srfPools[i].init(reg_mgr.srfPoolMgrs[i]->minAllocation(),
+                         cu->srf[i]->numRegs());
+    }
+}
+
+void
+DynamicRegisterManagerPolicy::exec()
+{
+}
+
+void
+DynamicRegisterManagerPolicy::ChunkPool::init(int chunk_size, int num_regs)
+{
+    chunkSize = chunk_size;
+
+    // the chunks are handed out from the back, so start with the lowest
+    freeChunks.clear();
+    for (int chunk = num_regs / chunkSize - 1; chunk >= 0; --chunk) {
+        freeChunks.push_back(chunk);
+    }
+}
+
+bool
+DynamicRegisterManagerPolicy::ChunkPool::canAllocate(int nWfs,
+                                                     int demandPerWf) const
+{
+    return nWfs * divCeil(demandPerWf, chunkSize) <= freeChunks.size();
+}
+
+bool
+DynamicRegisterManagerPolicy::ChunkPool::allocate(int demand,
+                                                  std::vector<int> &chunks)
+{
+    int num_chunks = divCeil(demand, chunkSize);
+    panic_if(num_chunks > freeChunks.size(), "cannot allocate %d registers, "
+             "only %d are free\n", demand, freeChunks.size() * chunkSize);
+
+    bool contiguous = true;
+    chunks.clear();
+    for (int i = 0; i < num_chunks; ++i) {
+        chunks.push_back(freeChunks.back());
+        freeChunks.pop_back();
+        if (i && chunks[i] != chunks[i - 1] + 1) {
+            contiguous = false;
+        }
+    }
+
+    return contiguous;
+}
+
+void
+DynamicRegisterManagerPolicy::ChunkPool::free(std::vector<int> &chunks)
+{
+    // return the chunks in reverse, so that the same ones are handed out
+    // again in the same order if possible
+    for (auto it = chunks.rbegin(); it != chunks.rend(); ++it) {
+        freeChunks.push_back(*it);
+    }
+    chunks.clear();
+}
+
+int
+DynamicRegisterManagerPolicy::mapVgpr(Wavefront* w, int vgprIndex)
+{
+    panic_if((vgprIndex >= w->reservedVectorRegs)
+             || (w->reservedVectorRegs < 0),
+             "VGPR index %d is out of range: VGPR range=[0,%d]",
+             vgprIndex, w->reservedVectorRegs);
+
+    int chunk_size = vrfPools[w->simdId].chunkSize;
+    return w->vgprChunks[vgprIndex / chunk_size] * chunk_size +
+        vgprIndex % chunk_size;
+}
+
+int
+DynamicRegisterManagerPolicy::mapSgpr(Wavefront* w, int sgprIndex)
+{
+    panic_if(!((sgprIndex < w->reservedScalarRegs)
+             && (w->reservedScalarRegs > 0)),
+             "SGPR index %d is out of range: SGPR range=[0,%d]\n",
+             sgprIndex, w->reservedScalarRegs);
+
+    int chunk_size = srfPools[w->simdId].chunkSize;
+    return w->sgprChunks[sgprIndex / chunk_size] * chunk_size +
+        sgprIndex % chunk_size;
+}
+
+bool
+DynamicRegisterManagerPolicy::canAllocateVgprs(int simdId, int nWfs,
+                                               int demandPerWf)
+{
+    return vrfPools[simdId].canAllocate(nWfs, demandPerWf);
+}
+
+bool
+DynamicRegisterManagerPolicy::canAllocateSgprs(int simdId, int nWfs,
+                                               int demandPerWf)
+{
+    return srfPools[simdId].canAllocate(nWfs, demandPerWf);
+}
+
+void
+DynamicRegisterManagerPolicy::allocateRegisters(Wavefront *w,
+                                                int vectorDemand,
+                                                int scalarDemand)
+{
+    ChunkPool &vrf_pool = vrfPools[w->simdId];
+    if (!vrf_pool.allocate(vectorDemand, w->vgprChunks)) {
+        ++vgprNonContiguousAllocs;
+    }
+    w->reservedVectorRegs = w->vgprChunks.size() * vrf_pool.chunkSize;
+    cu->vectorRegsReserved[w->simdId] += w->reservedVectorRegs;
+    panic_if(cu->vectorRegsReserved[w->simdId] > cu->numVecRegsPerSimd,
+             "VRF[%d] has been overallocated %d > %d\n",
+             w->simdId, cu->vectorRegsReserved[w->simdId],
+             cu->numVecRegsPerSimd);
+
+    if (scalarDemand) {
+        ChunkPool &srf_pool = srfPools[w->simdId];
+        if (!srf_pool.allocate(scalarDemand, w->sgprChunks)) {
+            ++sgprNonContiguousAllocs;
+        }
+        w->reservedScalarRegs = w->sgprChunks.size() * srf_pool.chunkSize;
+        cu->scalarRegsReserved[w->simdId] += w->reservedScalarRegs;
+        panic_if(cu->scalarRegsReserved[w->simdId] > cu->numScalarRegsPerSimd,
+                 "SRF[%d] has been overallocated %d > %d\n",
+                 w->simdId, cu->scalarRegsReserved[w->simdId],
+                 cu->numScalarRegsPerSimd);
+    }
+
+    DPRINTF(GPURename, "CU%d: WF[%d][%d]: allocated %d VGPRs in %d chunks "
+            "and %d SGPRs in %d chunks\n", cu->cu_id, w->simdId,
+            w->wfSlotId, w->reservedVectorRegs, w->vgprChunks.size(),
+            w->reservedScalarRegs, w->sgprChunks.size());
+}
+
+void
+DynamicRegisterManagerPolicy::freeRegisters(Wavefront *w)
+{
+    // free the vector registers of the completed wavefront
+    cu->vectorRegsReserved[w->simdId] -= w->reservedVectorRegs;
+    // free the scalar registers of the completed wavefront
+    cu->scalarRegsReserved[w->simdId] -= w->reservedScalarRegs;
+
+    panic_if(cu->vectorRegsReserved[w->simdId] < 0,
+             "Freeing VRF[%d] registers left %d registers reserved\n",
+             w->simdId, cu->vectorRegsReserved[w->simdId]);
+    panic_if(cu->scalarRegsReserved[w->simdId] < 0,
+             "Freeing SRF[%d] registers left %d registers reserved\n",
+             w->simdId, cu->scalarRegsReserved[w->simdId]);
+
+    // mark/pre-mark all registers as not busy
+    for (int i = 0; i < w->reservedVectorRegs; i++) {
+        cu->vrf[w->simdId]->markReg(mapVgpr(w, i), false);
+    }
+    for (int i = 0; i < w->reservedScalarRegs; i++) {
+        cu->srf[w->simdId]->markReg(mapSgpr(w, i), false);
+    }
+
+    vrfPools[w->simdId].free(w->vgprChunks);
+    srfPools[w->simdId].free(w->sgprChunks);
+
+    w->reservedVectorRegs = 0;
+    w->reservedScalarRegs = 0;
+}
+
+void
+DynamicRegisterManagerPolicy::regStats()
+{
+    vgprNonContiguousAllocs
+        .name(cu->registerManager.name() + ".vgpr_non_contiguous_allocs")
+        .desc("Number of WFs whose VGPRs were allocated in non-contiguous "
+              "chunks")
+        ;
+
+    sgprNonContiguousAllocs
+        .name(cu->registerManager.name() + ".sgpr_non_contiguous_allocs")
+        .desc("Number of WFs whose SGPRs were allocated in non-contiguous "
+              "chunks")
+        ;
+}
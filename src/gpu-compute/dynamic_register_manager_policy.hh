@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __DYNAMIC_REGISTER_MANAGER_POLICY_HH__
+#define __DYNAMIC_REGISTER_MANAGER_POLICY_HH__
+
+#include <vector>
+
+#include "gpu-compute/register_manager_policy.hh"
+#include "sim/stats.hh"
+
+class HSAQueueEntry;
+
+/**
+ * A register manager policy that allocates the registers of a wavefront
+ * as a list of fixed-size chunks, which need not be contiguous in the
+ * register file. The chunk size is the minimum allocation of the SIMD's
+ * pool manager. Because any free chunk can satisfy any request, the
+ * register file never fragments: a wavefront can be dispatched as long
+ * as enough registers are free in total, which lets occupancy-sensitive
+ * kernels keep more wavefronts resident than with the static policy.
+ */
+class DynamicRegisterManagerPolicy : public RegisterManagerPolicy
+{
+  public:
+
+    DynamicRegisterManagerPolicy();
+
+    void setParent(ComputeUnit *_cu) override;
+
+    void exec() override;
+
+    int mapVgpr(Wavefront* w, int vgprIndex) override;
+    int mapSgpr(Wavefront* w, int sgprIndex) override;
+
+    bool canAllocateVgprs(int simdId, int nWfs, int demandPerWf) override;
+    bool canAllocateSgprs(int simdId, int nWfs, int demandPerWf) override;
+
+    void allocateRegisters(Wavefront *w, int vectorDemand,
+        int scalarDemand) override;
+
+    void freeRegisters(Wavefront *w) override;
+
+    void regStats() override;
+
+  private:
+    // the chunks of a register file that are not allocated to any WF
+    struct ChunkPool
+    {
+        int chunkSize;
+        std::vector<int> freeChunks;
+
+        void init(int chunk_size, int num_regs);
+        bool canAllocate(int nWfs, int demandPerWf) const;
+        // allocate the chunks for demand registers, returns true if they
+        // are contiguous
+        bool allocate(int demand, std::vector<int> &chunks);
+        void free(std::vector<int> &chunks);
+    };
+
+    std::vector<ChunkPool> vrfPools;
+    std::vector<ChunkPool> srfPools;
+
+    // number of WFs whose registers were not contiguous, i.e., that the
+    // static policy could not have allocated without compaction
+    Stats::Scalar vgprNonContiguousAllocs;
+    Stats::Scalar sgprNonContiguousAllocs;
+};
+
+#endif // __DYNAMIC_REGISTER_MANAGER_POLICY_HH__
@@ -67,6 +67,17 @@ class FetchStage
     Stats::Distribution instFetchInstReturned;
     FetchUnit &fetchUnit(int simdId) { return _fetchUnit.at(simdId); }
 
+    bool
+    isQuiescent() const
+    {
+        for (const auto &fetch_unit : _fetchUnit) {
+            if (!fetch_unit.isQuiescent()) {
+                return false;
+            }
+        }
+        return true;
+    }
+
   private:
     int numVectorALUs;
     ComputeUnit *computeUnit;
@@ -133,6 +133,33 @@ FetchUnit::exec()
     }
 }
 
+bool
+FetchUnit::isQuiescent() const
+{
+    if (!fetchQueue.empty()) {
+        return false;
+    }
+
+    for (int j = 0; j < computeUnit->shader->n_wf; ++j) {
+        Wavefront *curWave = fetchStatusQueue[j].first;
+
+        if (fetchBuf[j].hasFetchDataToProcess() &&
+            curWave->instructionBuffer.size() < curWave->maxIbSize) {
+            return false;
+        }
+
+        if ((curWave->getStatus() == Wavefront::S_RUNNING ||
+            curWave->getStatus() == Wavefront::S_WAITCNT) &&
+            fetchBuf[j].hasFreeSpace() &&
+            !curWave->stopFetch() &&
+            !curWave->pendingFetch) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
 void
 FetchUnit::initiateFetch(Wavefront *wavefront)
 {
@@ -290,6 +317,7 @@ FetchUnit::processFetchReturn(PacketPtr pkt)
     }
 
     wavefront->pendingFetch = false;
+    computeUnit->wakeup();
 
     delete pkt->senderState;
     delete pkt->req;
@@ -539,16 +567,18 @@ FetchUnit::FetchBufDesc::decodeInsts()
         } else {
             TheGpuISA::MachInst mach_inst
                 = reinterpret_cast<TheGpuISA::MachInst>(readPtr);
-            GPUStaticInst *gpu_static_inst = _decoder->decode(mach_inst);
+            GPUStaticInst *gpu_static_inst
+                = wavefront->computeUnit->shader->decodeCache().decode(
+                    *_decoder, readPtrAddr(), mach_inst);
             readPtr += gpu_static_inst->instSize();
 
             assert(readPtr <= bufEnd);
 
             GPUDynInstPtr gpu_dyn_inst
-                = std::make_shared<GPUDynInst>(wavefront->computeUnit,
-                                               wavefront, gpu_static_inst,
-                                               wavefront->computeUnit->
-                                                   getAndIncSeqNum());
+                = GPUDynInst::create(wavefront->computeUnit, wavefront,
+                                     gpu_static_inst,
+                                     wavefront->computeUnit->
+                                         getAndIncSeqNum());
             wavefront->instructionBuffer.push_back(gpu_dyn_inst);
 
             DPRINTF(GPUFetch, "WF[%d][%d]: Id%ld decoded %s (%d bytes). "
@@ -567,6 +597,7 @@ FetchUnit::FetchBufDesc::decodeSplitInst()
     TheGpuISA::RawMachInst split_inst = 0;
     int dword_size = sizeof(uint32_t);
     int num_dwords = sizeof(TheGpuISA::RawMachInst) / dword_size;
+    Addr split_inst_addr = readPtrAddr();
 
     for (int i = 0; i < num_dwords; ++i) {
         ((uint32_t*)(&split_inst))[i] = *reinterpret_cast<uint32_t*>(readPtr);
@@ -579,15 +610,16 @@ FetchUnit::FetchBufDesc::decodeSplitInst()
 
     TheGpuISA::MachInst mach_inst
         = reinterpret_cast<TheGpuISA::MachInst>(&split_inst);
-    GPUStaticInst *gpu_static_inst = _decoder->decode(mach_inst);
+    GPUStaticInst *gpu_static_inst
+        = wavefront->computeUnit->shader->decodeCache().decode(
+            *_decoder, split_inst_addr, mach_inst);
     readPtr += (gpu_static_inst->instSize() - dword_size);
     assert(readPtr < bufEnd);
 
     GPUDynInstPtr gpu_dyn_inst
-        = std::make_shared<GPUDynInst>(wavefront->computeUnit,
-                                       wavefront, gpu_static_inst,
-                                       wavefront->computeUnit->
-                                           getAndIncSeqNum());
+        = GPUDynInst::create(wavefront->computeUnit, wavefront,
+                             gpu_static_inst,
+                             wavefront->computeUnit->getAndIncSeqNum());
     wavefront->instructionBuffer.push_back(gpu_dyn_inst);
 
     DPRINTF(GPUFetch, "WF[%d][%d]: Id%d decoded split inst %s (%#x) "
@@ -598,6 +630,21 @@ FetchUnit::FetchBufDesc::decodeSplitInst()
             bufferedLines());
 }
 
+Addr
+FetchUnit::FetchBufDesc::readPtrAddr() const
+{
+    for (const auto &buffered_pc : bufferedPCs) {
+        uint8_t *line_start = buffered_pc.second;
+        if (readPtr >= line_start && readPtr < line_start + cacheLineSize) {
+            return buffered_pc.first + (readPtr - line_start);
+        }
+    }
+
+    panic("WF[%d][%d]: Id%d fetch buffer read pointer does not point "
+          "to a buffered line\n", wavefront->simdId, wavefront->wfSlotId,
+          wavefront->wfDynId);
+}
+
 bool
 FetchUnit::FetchBufDesc::splitDecode() const
 {
@@ -62,6 +62,11 @@ class FetchUnit
     void fetch(PacketPtr pkt, Wavefront *wavefront);
     void processFetchReturn(PacketPtr pkt);
     void flushBuf(int wfSlotId);
+    /**
+     * true if exec() would neither decode buffered instruction
+     * data nor initiate a new fetch for any of our waves.
+     */
+    bool isQuiescent() const;
     static uint32_t globalFetchUnitID;
 
   private:
@@ -174,6 +179,12 @@ class FetchUnit
       private:
         void decodeSplitInst();
 
+        /**
+         * the address of the instruction data pointed to by readPtr,
+         * used to look the instruction up in the decode cache.
+         */
+        Addr readPtrAddr() const;
+
         /**
          * check if the next instruction to be processed out of
          * the fetch buffer is split across the end/beginning of
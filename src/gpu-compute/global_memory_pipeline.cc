@@ -134,6 +134,11 @@ GlobalMemPipeline::exec()
                 m->cu_id, m->simdId, m->wfSlotId, m->disassemble());
         m->completeAcc(m);
 
+        if (computeUnit->shader->trace()) {
+            computeUnit->shader->trace()->record(GPUTrace::INST_COMPLETE,
+                                                 w, m->seqNum());
+        }
+
         if (m->isLoad() || m->isAtomicRet()) {
             w->computeUnit->vrf[w->simdId]->
             scheduleWriteOperandsFromLoad(w, m);
@@ -254,6 +259,11 @@ GlobalMemPipeline::completeRequest(GPUDynInstPtr gpuDynInst)
 void
 GlobalMemPipeline::issueRequest(GPUDynInstPtr gpuDynInst)
 {
+    if (gpuDynInst->wavefront()->functionalMode) {
+        computeUnit->execFunctionalAccess(gpuDynInst);
+        return;
+    }
+
     gpuDynInst->setAccessTime(curTick());
     gpuDynInst->profileRoundTripTime(curTick(), InstMemoryHop::Initiate);
     gmIssuedRequests.push(gpuDynInst);
@@ -268,6 +278,7 @@ GlobalMemPipeline::handleResponse(GPUDynInstPtr gpuDynInst)
     // buffer
     assert(mem_req != gmOrderedRespBuffer.end());
     mem_req->second.second = true;
+    computeUnit->wakeup();
 }
 
 void
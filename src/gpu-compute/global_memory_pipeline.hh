@@ -105,6 +105,18 @@ class GlobalMemPipeline
         loadVrfBankConflictCycles += num_cycles;
     }
 
+    /**
+     * The pipeline is quiescent if it has no requests waiting to be
+     * issued and the oldest in-flight request has not returned yet, i.e.,
+     * it can only make progress once a response arrives.
+     */
+    bool
+    isQuiescent() const
+    {
+        return gmIssuedRequests.empty() && (gmOrderedRespBuffer.empty() ||
+               !gmOrderedRespBuffer.begin()->second.second);
+    }
+
     bool coalescerReady(GPUDynInstPtr mp) const;
     bool outstandingReqsCheck(GPUDynInstPtr mp) const;
 
@@ -42,7 +42,7 @@
 #include "sim/process.hh"
 
 GPUCommandProcessor::GPUCommandProcessor(const Params *p)
-    : HSADevice(p), dispatcher(*p->dispatcher)
+    : HSADevice(p), dispatcher(*p->dispatcher), dynamicTaskId(0)
 {
     dispatcher.setCommandProcessor(this);
 }
@@ -68,7 +68,6 @@ void
 GPUCommandProcessor::submitDispatchPkt(void *raw_pkt, uint32_t queue_id,
                                        Addr host_pkt_addr)
 {
-    static int dynamic_task_id = 0;
     _hsa_dispatch_packet_t *disp_pkt = (_hsa_dispatch_packet_t*)raw_pkt;
 
     /**
@@ -112,11 +111,16 @@ GPUCommandProcessor::submitDispatchPkt(void *raw_pkt, uint32_t queue_id,
     DPRINTF(GPUKernelInfo, "Kernel name: %s\n", kernel_name.c_str());
 
     HSAQueueEntry *task = new HSAQueueEntry(kernel_name, queue_id,
-        dynamic_task_id, raw_pkt, &akc, host_pkt_addr, machine_code_addr);
+        dynamicTaskId, raw_pkt, &akc, host_pkt_addr, machine_code_addr);
+
+    // queue_id is the HW queue the HSA queue is mapped to, the task
+    // inherits the priority and CU mask of the HSA queue
+    HSAQueueDescriptor *q_desc = hsaPP->getQueueDesc(queue_id);
+    task->setQueueAttrs(q_desc->queueId, q_desc->priority, q_desc->cuMask);
 
     DPRINTF(GPUCommandProc, "Task ID: %i Got AQL: wg size (%dx%dx%d), "
         "grid size (%dx%dx%d) kernarg addr: %#x, completion "
-        "signal addr:%#x\n", dynamic_task_id, disp_pkt->workgroup_size_x,
+        "signal addr:%#x\n", dynamicTaskId, disp_pkt->workgroup_size_x,
         disp_pkt->workgroup_size_y, disp_pkt->workgroup_size_z,
         disp_pkt->grid_size_x, disp_pkt->grid_size_y,
         disp_pkt->grid_size_z, disp_pkt->kernarg_address,
@@ -128,7 +132,7 @@ GPUCommandProcessor::submitDispatchPkt(void *raw_pkt, uint32_t queue_id,
         task->numScalarRegs(), task->codeAddr(), 0, 0);
 
     initABI(task);
-    ++dynamic_task_id;
+    ++dynamicTaskId;
 }
 
 /**
@@ -192,6 +196,18 @@ GPUCommandProcessor::system()
     return sys;
 }
 
+void
+GPUCommandProcessor::serialize(CheckpointOut &cp) const
+{
+    SERIALIZE_SCALAR(dynamicTaskId);
+}
+
+void
+GPUCommandProcessor::unserialize(CheckpointIn &cp)
+{
+    UNSERIALIZE_SCALAR(dynamicTaskId);
+}
+
 AddrRangeList
 GPUCommandProcessor::getAddrRanges() const
 {
@@ -76,9 +76,14 @@ class GPUCommandProcessor : public HSADevice
     AddrRangeList getAddrRanges() const override;
     System *system();
 
+    void serialize(CheckpointOut &cp) const override;
+    void unserialize(CheckpointIn &cp) override;
+
   private:
     Shader *_shader;
     GPUDispatcher &dispatcher;
+    // ID of the next task, unique across all queues
+    int dynamicTaskId;
 
     void initABI(HSAQueueEntry *task);
 
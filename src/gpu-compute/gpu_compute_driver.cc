@@ -205,7 +205,15 @@ GPUComputeDriver::ioctl(ThreadContext *tc, unsigned req)
           break;
         case AMDKFD_IOC_UPDATE_QUEUE:
           {
-            warn("unimplemented ioctl: AMDKFD_IOC_UPDATE_QUEUE\n");
+            TypedBufferArg<kfd_ioctl_update_queue_args> args(ioc_buf);
+            args.copyIn(virt_proxy);
+            DPRINTF(GPUDriver, "ioctl: AMDKFD_IOC_UPDATE_QUEUE; queue %d, "
+                    "priority %d\n", args->queue_id, args->queue_priority);
+
+            // the ring buffer of a queue is not resized or moved, only
+            // its priority is updated
+            device->hsaPacketProc().setQueuePriority(args->queue_id,
+                                                     args->queue_priority);
           }
           break;
         case AMDKFD_IOC_CREATE_EVENT:
@@ -279,7 +287,23 @@ GPUComputeDriver::ioctl(ThreadContext *tc, unsigned req)
           break;
         case AMDKFD_IOC_SET_CU_MASK:
           {
-            warn("unimplemented ioctl: AMDKFD_IOC_SET_CU_MASK\n");
+            TypedBufferArg<kfd_ioctl_set_cu_mask_args> args(ioc_buf);
+            args.copyIn(virt_proxy);
+            DPRINTF(GPUDriver, "ioctl: AMDKFD_IOC_SET_CU_MASK; queue %d, "
+                    "%d CUs\n", args->queue_id, args->num_cu_mask);
+
+            // the mask is an array of 32-bit words, with one bit per CU
+            int num_words = divCeil(args->num_cu_mask, 32);
+            TypedBufferArg<uint32_t> cu_mask(args->cu_mask_ptr,
+                                             num_words * sizeof(uint32_t));
+            cu_mask.copyIn(virt_proxy);
+
+            std::vector<bool> mask(args->num_cu_mask);
+            for (int i = 0; i < args->num_cu_mask; ++i) {
+                mask[i] = bits(cu_mask[i / 32], i % 32);
+            }
+
+            device->hsaPacketProc().setQueueCuMask(args->queue_id, mask);
           }
           break;
         case AMDKFD_IOC_SET_PROCESS_DGPU_APERTURE:
@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "gpu-compute/gpu_decode_cache.hh"
+
+#include "base/bitfield.hh"
+#include "debug/GPUFetch.hh"
+#include "gpu-compute/gpu_static_inst.hh"
+
+GPUDecodeCache::~GPUDecodeCache()
+{
+    invalidate();
+
+    for (auto static_inst : retiredInsts) {
+        delete static_inst;
+    }
+}
+
+GPUStaticInst*
+GPUDecodeCache::decode(TheGpuISA::Decoder &decoder, Addr pc,
+                       TheGpuISA::MachInst mach_inst)
+{
+    TheGpuISA::RawMachInst raw_inst
+        = *reinterpret_cast<TheGpuISA::RawMachInst*>(mach_inst);
+
+    std::lock_guard<std::mutex> lock(cacheMutex);
+
+    auto it = instMap.find(pc);
+
+    if (it != instMap.end()) {
+        DecodeCacheEntry &entry = it->second;
+        int inst_bits = entry.staticInst->instSize() * 8;
+
+        // only compare the bytes the cached instruction was decoded
+        // from, the remainder belongs to the next instruction
+        if (bits(raw_inst, inst_bits - 1, 0) == entry.rawInst) {
+            ++hits;
+            return entry.staticInst;
+        }
+
+        DPRINTF(GPUFetch, "Decode cache entry for PC %#x is stale, "
+                "replacing %s\n", pc, entry.staticInst->disassemble());
+
+        retiredInsts.push_back(entry.staticInst);
+        instMap.erase(it);
+    }
+
+    ++misses;
+
+    GPUStaticInst *static_inst = decoder.decode(mach_inst);
+    static_inst->instAddr(pc);
+    int inst_bits = static_inst->instSize() * 8;
+    instMap.emplace(pc, DecodeCacheEntry{bits(raw_inst, inst_bits - 1, 0),
+                                         static_inst});
+
+    return static_inst;
+}
+
+void
+GPUDecodeCache::invalidate()
+{
+    std::lock_guard<std::mutex> lock(cacheMutex);
+
+    for (auto &entry : instMap) {
+        retiredInsts.push_back(entry.second.staticInst);
+    }
+
+    instMap.clear();
+}
+
+void
+GPUDecodeCache::regStats(const std::string &name)
+{
+    hits
+        .name(name + ".decode_cache_hits")
+        .desc("number of fetched instructions found in the decode cache")
+        ;
+
+    misses
+        .name(name + ".decode_cache_misses")
+        .desc("number of fetched instructions that had to be decoded")
+        ;
+}
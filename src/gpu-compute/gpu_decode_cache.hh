@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __GPU_COMPUTE_GPU_DECODE_CACHE_HH__
+#define __GPU_COMPUTE_GPU_DECODE_CACHE_HH__
+
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "arch/gpu_decoder.hh"
+#include "arch/gpu_types.hh"
+#include "base/statistics.hh"
+#include "base/types.hh"
+#include "config/the_gpu_isa.hh"
+
+class GPUStaticInst;
+
+/**
+ * @file gpu_decode_cache.hh
+ *
+ * A cache of decoded GPU static instructions, shared by all CUs of a
+ * shader. All waves of a kernel execute the same code, so rather than
+ * decoding (and allocating) a new GPUStaticInst each time a wave fetches
+ * an instruction, the fetch units look the PC up here first and reuse
+ * the static instruction that was decoded for it previously. Static
+ * instructions handed out by the cache are owned by it, and must not be
+ * modified by the dynamic instructions that reference them.
+ *
+ * Each entry also records the raw instruction bits it was decoded from,
+ * which are checked on every lookup. If a code object is reloaded over
+ * a previously used address the stale entry is replaced, so the cache
+ * never needs to be explicitly flushed by the driver.
+ *
+ * When the CUs are simulated on separate event queues the fetch units
+ * look up the cache from different threads, so all accesses are
+ * serialized by a mutex.
+ */
+class GPUDecodeCache
+{
+  public:
+    GPUDecodeCache() { }
+    ~GPUDecodeCache();
+
+    /**
+     * Return the static instruction for the instruction at pc, whose
+     * raw bits are pointed to by mach_inst, decoding it with the given
+     * decoder if it has not been seen before.
+     */
+    GPUStaticInst *decode(TheGpuISA::Decoder &decoder, Addr pc,
+                          TheGpuISA::MachInst mach_inst);
+
+    /**
+     * Drop all entries. The static instructions are kept alive until the
+     * cache is destroyed, because in-flight dynamic instructions may
+     * still reference them.
+     */
+    void invalidate();
+
+    void regStats(const std::string &name);
+
+  private:
+    struct DecodeCacheEntry
+    {
+        TheGpuISA::RawMachInst rawInst;
+        GPUStaticInst *staticInst;
+    };
+
+    // protects the map, the retired list and the stats
+    std::mutex cacheMutex;
+
+    std::unordered_map<Addr, DecodeCacheEntry> instMap;
+
+    // static instructions whose entries were replaced or invalidated
+    std::vector<GPUStaticInst*> retiredInsts;
+
+    Stats::Scalar hits;
+    Stats::Scalar misses;
+};
+
+#endif // __GPU_COMPUTE_GPU_DECODE_CACHE_HH__
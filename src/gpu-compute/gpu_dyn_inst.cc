@@ -35,6 +35,8 @@
 
 #include "gpu-compute/gpu_dyn_inst.hh"
 
+#include <cstring>
+
 #include "debug/GPUMem.hh"
 #include "gpu-compute/gpu_static_inst.hh"
 #include "gpu-compute/scalar_register_file.hh"
@@ -44,28 +46,29 @@
 GPUDynInst::GPUDynInst(ComputeUnit *_cu, Wavefront *_wf,
                        GPUStaticInst *static_inst, InstSeqNum instSeqNum)
     : GPUExecContext(_cu, _wf), scalarAddr(0), addr(computeUnit()->wfSize(),
-      (Addr)0), numScalarReqs(0), isSaveRestore(false),
-      _staticInst(static_inst), _seqNum(instSeqNum)
+      (Addr)0), numScalarReqs(0), coalescedLaneSize(0), isSaveRestore(false),
+      _staticInst(static_inst), _seqNum(instSeqNum),
+      _executedAs(static_inst->executed_as)
 {
     statusVector.assign(TheGpuISA::NumVecElemPerVecReg, 0);
     tlbHitLevel.assign(computeUnit()->wfSize(), -1);
-    // vector instructions can have up to 4 source/destination operands
-    d_data = new uint8_t[computeUnit()->wfSize() * 4 * sizeof(double)];
-    a_data = new uint8_t[computeUnit()->wfSize() * 8];
-    x_data = new uint8_t[computeUnit()->wfSize() * 8];
-    // scalar loads can read up to 16 Dwords of data (see publicly
-    // available GCN3 ISA manual)
-    scalar_data = new uint8_t[16 * sizeof(uint32_t)];
-    for (int i = 0; i < (16 * sizeof(uint32_t)); ++i) {
-        scalar_data[i] = 0;
-    }
-    for (int i = 0; i < (computeUnit()->wfSize() * 8); ++i) {
-        a_data[i] = 0;
-        x_data[i] = 0;
-    }
-    for (int i = 0; i < (computeUnit()->wfSize() * 4 * sizeof(double)); ++i) {
-        d_data[i] = 0;
+
+    // all of the per-lane data lives in a single buffer that is
+    // recycled by the CU, see dataBufSize() for the layout
+    BufferPool &data_pool = computeUnit()->dynInstDataPool;
+    if (data_pool.empty()) {
+        computeUnit()->dynInstBufHeapAllocs++;
+    } else {
+        computeUnit()->dynInstBufReuses++;
     }
+    dataBuf = data_pool.acquire();
+    std::memset(dataBuf, 0, data_pool.size());
+
+    int wf_size = computeUnit()->wfSize();
+    d_data = dataBuf;
+    a_data = d_data + wf_size * 4 * sizeof(double);
+    x_data = a_data + wf_size * 8;
+    scalar_data = x_data + wf_size * 8;
     time = 0;
 
     cu_id = _cu->cu_id;
@@ -86,11 +89,38 @@ GPUDynInst::GPUDynInst(ComputeUnit *_cu, Wavefront *_wf,
 
 GPUDynInst::~GPUDynInst()
 {
-    delete[] d_data;
-    delete[] a_data;
-    delete[] x_data;
-    delete[] scalar_data;
-    delete _staticInst;
+    computeUnit()->dynInstDataPool.release(dataBuf);
+}
+
+size_t
+GPUDynInst::dataBufSize(int wf_size)
+{
+    // vector instructions can have up to 4 source/destination operands
+    size_t d_data_size = wf_size * 4 * sizeof(double);
+    // atomics have up to two additional operands
+    size_t a_data_size = wf_size * 8;
+    size_t x_data_size = wf_size * 8;
+    // scalar loads can read up to 16 Dwords of data (see publicly
+    // available GCN3 ISA manual)
+    size_t scalar_data_size = 16 * sizeof(uint32_t);
+
+    return d_data_size + a_data_size + x_data_size + scalar_data_size;
+}
+
+void
+GPUDynInst::scatterCoalescedData(int leader)
+{
+    if (coalescedData.empty() || coalescedLeader[leader] != leader) {
+        return;
+    }
+
+    for (int lane = 0; lane < coalescedLeader.size(); ++lane) {
+        if (coalescedLeader[lane] == leader) {
+            std::memcpy(d_data + lane * coalescedLaneSize,
+                        coalescedData.data() + coalescedOffset[lane],
+                        coalescedLaneSize);
+        }
+    }
 }
 
 void
@@ -267,7 +297,7 @@ GPUDynInst::seqNum() const
 Enums::StorageClassType
 GPUDynInst::executedAs()
 {
-    return _staticInst->executed_as;
+    return _executedAs;
 }
 
 bool
@@ -746,11 +776,11 @@ GPUDynInst::doApertureCheck(const VectorMask &mask)
         if (mask[lane]) {
             if (computeUnit()->shader->isLdsApe(addr[lane])) {
                 // group segment
-                staticInstruction()->executed_as = Enums::SC_GROUP;
+                _executedAs = Enums::SC_GROUP;
                 break;
             } else if (computeUnit()->shader->isScratchApe(addr[lane])) {
                 // private segment
-                staticInstruction()->executed_as = Enums::SC_PRIVATE;
+                _executedAs = Enums::SC_PRIVATE;
                 break;
             } else if (computeUnit()->shader->isGpuVmApe(addr[lane])) {
                 // we won't support GPUVM
@@ -762,7 +792,7 @@ GPUDynInst::doApertureCheck(const VectorMask &mask)
                       addr[lane]);
             } else {
                 // global memory segment
-                staticInstruction()->executed_as = Enums::SC_GLOBAL;
+                _executedAs = Enums::SC_GLOBAL;
                 break;
             }
         }
@@ -178,6 +178,28 @@ class GPUDynInst : public GPUExecContext
     GPUDynInst(ComputeUnit *_cu, Wavefront *_wf, GPUStaticInst *static_inst,
                uint64_t instSeqNum);
     ~GPUDynInst();
+
+    /**
+     * Create a new dynamic instruction. GPUDynInsts are created and
+     * destroyed for every instruction fetched, so their storage is
+     * recycled through a free list rather than using make_shared().
+     */
+    static GPUDynInstPtr
+    create(ComputeUnit *cu, Wavefront *wf, GPUStaticInst *static_inst,
+           uint64_t inst_seq_num)
+    {
+        return std::allocate_shared<GPUDynInst>(
+            FreeListAllocator<GPUDynInst>(), cu, wf, static_inst,
+            inst_seq_num);
+    }
+
+    /**
+     * Size of the buffer holding the per-lane data (d_data, a_data,
+     * x_data and scalar_data) of an instruction for the given wavefront
+     * size. These buffers come from the CU's dynInstDataPool.
+     */
+    static size_t dataBufSize(int wf_size);
+
     void execute(GPUDynInstPtr gpuDynInst);
     int numSrcRegOperands();
     int numDstRegOperands();
@@ -512,6 +534,25 @@ class GPUDynInst : public GPUExecContext
     // of outstanding reqs here
     int numScalarReqs;
 
+    /**
+     * when the CU coalesces the accesses of several lanes into a single
+     * request (see initMemReqHelper()), the request's data lives in
+     * coalescedData instead of d_data. for each lane we record the lane
+     * that issued the shared request on its behalf (-1 if the lane was
+     * not coalesced), and the offset of the lane's data in coalescedData.
+     */
+    std::vector<int> coalescedLeader;
+    std::vector<int> coalescedOffset;
+    std::vector<uint8_t> coalescedData;
+    // size, in bytes, of each lane's access
+    int coalescedLaneSize;
+
+    /**
+     * copy the data returned for the coalesced request issued by lane
+     * 'leader' into the d_data slot of every lane it was issued for.
+     */
+    void scatterCoalescedData(int leader);
+
     Tick getAccessTime() const { return accessTime; }
 
     void setAccessTime(Tick currentTime) { accessTime = currentTime; }
@@ -526,8 +567,16 @@ class GPUDynInst : public GPUExecContext
     // inst used to save/restore a wavefront context
     bool isSaveRestore;
   private:
+    // static instructions are shared by all dynamic instances of
+    // an instruction (see GPUDecodeCache) and are not owned by us
     GPUStaticInst *_staticInst;
     const InstSeqNum _seqNum;
+    // the segment this instruction accesses, for flat instructions this
+    // is only known once its addresses have been calculated
+    Enums::StorageClassType _executedAs;
+
+    // backing storage for d_data, a_data, x_data and scalar_data
+    uint8_t *dataBuf;
 
     // the time the request was started
     Tick accessTime = -1;
@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "gpu-compute/gpu_inst_profiler.hh"
+
+#include "base/logging.hh"
+#include "base/output.hh"
+#include "gpu-compute/compute_unit.hh"
+#include "gpu-compute/gpu_dyn_inst.hh"
+#include "gpu-compute/gpu_static_inst.hh"
+#include "gpu-compute/wavefront.hh"
+
+GPUInstProfiler::GPUInstProfiler(int num_cus, const std::string &dir)
+    : shards(num_cus), outDir(simout.createSubdirectory(dir))
+{
+}
+
+void
+GPUInstProfiler::beginKernel(int kern_id, const std::string &kern_name)
+{
+    std::lock_guard<std::mutex> lock(kernelMutex);
+    kernelNames[kern_id] = kern_name;
+}
+
+GPUInstProfiler::PcProfile &
+GPUInstProfiler::lookup(Wavefront *w, Addr pc)
+{
+    // the caller must hold the lock of the CU's shard
+    Shard &shard = shards[w->computeUnit->cu_id];
+    return shard.kernels[w->kernId][pc - w->kernelCodeAddr];
+}
+
+void
+GPUInstProfiler::issued(GPUDynInstPtr ii)
+{
+    Wavefront *w = ii->wavefront();
+    std::lock_guard<std::mutex> lock(shards[w->computeUnit->cu_id].mutex);
+
+    PcProfile &prof = lookup(w, ii->staticInstruction()->instAddr());
+    if (prof.disasm.empty()) {
+        prof.disasm = ii->disassemble();
+    }
+    ++prof.issued;
+    prof.activeLanes += ii->exec_mask.count();
+}
+
+void
+GPUInstProfiler::stalled(Wavefront *w, GPUDynInstPtr ii, StallReason reason)
+{
+    std::lock_guard<std::mutex> lock(shards[w->computeUnit->cu_id].mutex);
+
+    Addr pc = ii ? ii->staticInstruction()->instAddr() : w->pc();
+    PcProfile &prof = lookup(w, pc);
+    if (ii && prof.disasm.empty()) {
+        prof.disasm = ii->disassemble();
+    }
+    ++prof.stalls[reason];
+}
+
+const char *
+GPUInstProfiler::stallName(StallReason reason)
+{
+    switch (reason) {
+      case STALL_DEPENDENCY:
+        return "dependency";
+      case STALL_WAITCNT:
+        return "waitcnt";
+      case STALL_RESOURCE:
+        return "resource";
+      case STALL_BARRIER:
+        return "barrier";
+      case STALL_FETCH:
+        return "fetch";
+      default:
+        panic("unknown stall reason %d\n", reason);
+    }
+}
+
+void
+GPUInstProfiler::endKernel(int kern_id)
+{
+    std::string kern_name;
+    {
+        std::lock_guard<std::mutex> lock(kernelMutex);
+        auto it = kernelNames.find(kern_id);
+        if (it == kernelNames.end()) {
+            // the kernel was not profiled, e.g., it executed functionally
+            return;
+        }
+        kern_name = it->second;
+        kernelNames.erase(it);
+    }
+
+    // merge the samples of all CUs
+    KernelProfile profile;
+    for (auto &shard : shards) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.kernels.find(kern_id);
+        if (it == shard.kernels.end()) {
+            continue;
+        }
+
+        for (const auto &entry : it->second) {
+            PcProfile &prof = profile[entry.first];
+            if (prof.disasm.empty()) {
+                prof.disasm = entry.second.disasm;
+            }
+            prof.issued += entry.second.issued;
+            prof.activeLanes += entry.second.activeLanes;
+            for (int i = 0; i < NUM_STALL_REASONS; ++i) {
+                prof.stalls[i] += entry.second.stalls[i];
+            }
+        }
+
+        shard.kernels.erase(it);
+    }
+
+    OutputStream *file = outDir->create(csprintf("kernel%d.csv", kern_id));
+    std::ostream &os = *file->stream();
+
+    os << "# kernel: " << kern_name << ", dispatch id: " << kern_id
+       << std::endl;
+    os << "pc, issued, active lanes";
+    for (int i = 0; i < NUM_STALL_REASONS; ++i) {
+        os << ", " << stallName((StallReason)i) << " stalls";
+    }
+    os << ", disassembly" << std::endl;
+
+    for (const auto &entry : profile) {
+        const PcProfile &prof = entry.second;
+        os << csprintf("%#x", entry.first) << ", " << prof.issued << ", "
+           << prof.activeLanes;
+        for (auto stalls : prof.stalls) {
+            os << ", " << stalls;
+        }
+        // the disassembly contains commas, so quote it
+        os << ", \"" << prof.disasm << "\"" << std::endl;
+    }
+
+    outDir->close(file);
+}
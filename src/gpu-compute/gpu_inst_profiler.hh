@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __GPU_COMPUTE_GPU_INST_PROFILER_HH__
+#define __GPU_COMPUTE_GPU_INST_PROFILER_HH__
+
+#include <array>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "base/types.hh"
+#include "gpu-compute/misc.hh"
+
+class OutputDirectory;
+class Wavefront;
+
+/**
+ * @file gpu_inst_profiler.hh
+ *
+ * A per-instruction profiler for the kernels executed by a shader. For
+ * every static instruction of a kernel, identified by its offset from
+ * the start of the kernel's code, it records how many times the
+ * instruction was issued, the number of lanes that were active when it
+ * was, and the number of cycles the waves spent stalled on it, broken
+ * down by the reason of the stall. Stalls are counted per wave, i.e., two
+ * waves stalled on the same instruction in a cycle count as two cycles.
+ *
+ * The profile of a kernel launch is written to its own CSV file in the
+ * profile directory when the kernel completes. util/gpu_inst_profile.py
+ * annotates the disassembly of a kernel with its profile.
+ *
+ * When the CUs are simulated on separate event queues they update the
+ * profile from different threads, so each CU records its samples in its
+ * own shard, which are merged when the kernel completes.
+ */
+class GPUInstProfiler
+{
+  public:
+    enum StallReason
+    {
+        // the operands of the instruction were not ready
+        STALL_DEPENDENCY,
+        // the wave was waiting for its memory counters, i.e., s_waitcnt
+        STALL_WAITCNT,
+        // the execution resource of the instruction was busy
+        STALL_RESOURCE,
+        // the wave was waiting for the other waves of its workgroup
+        STALL_BARRIER,
+        // the instruction had not been fetched yet
+        STALL_FETCH,
+        NUM_STALL_REASONS
+    };
+
+    GPUInstProfiler(int num_cus, const std::string &dir);
+
+    /**
+     * Start profiling a kernel launch, called by the dispatcher when the
+     * kernel is launched.
+     */
+    void beginKernel(int kern_id, const std::string &kern_name);
+
+    /**
+     * Stop profiling a kernel launch and write out its profile.
+     */
+    void endKernel(int kern_id);
+
+    /**
+     * Record the issue of an instruction.
+     */
+    void issued(GPUDynInstPtr ii);
+
+    /**
+     * Record a cycle in which the wave was stalled on the given
+     * instruction. If the instruction is not known, e.g., it has not been
+     * fetched yet, it is taken to be the one at the wave's PC.
+     */
+    void stalled(Wavefront *w, GPUDynInstPtr ii, StallReason reason);
+
+  private:
+    struct PcProfile
+    {
+        std::string disasm;
+        uint64_t issued = 0;
+        uint64_t activeLanes = 0;
+        std::array<uint64_t, NUM_STALL_REASONS> stalls{};
+    };
+
+    typedef std::map<Addr, PcProfile> KernelProfile;
+
+    // the samples recorded by a single CU, keyed by dispatch ID
+    struct Shard
+    {
+        std::mutex mutex;
+        std::unordered_map<int, KernelProfile> kernels;
+    };
+
+    PcProfile &lookup(Wavefront *w, Addr pc);
+
+    static const char *stallName(StallReason reason);
+
+    std::vector<Shard> shards;
+
+    // protects the names of the kernels being profiled
+    std::mutex kernelMutex;
+    std::unordered_map<int, std::string> kernelNames;
+
+    // the directory the profiles are written to
+    OutputDirectory *outDir;
+};
+
+#endif // __GPU_COMPUTE_GPU_INST_PROFILER_HH__
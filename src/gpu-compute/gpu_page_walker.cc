@@ -0,0 +1,342 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "gpu-compute/gpu_page_walker.hh"
+
+#include <memory>
+
+#include "arch/x86/process.hh"
+#include "base/bitfield.hh"
+#include "base/logging.hh"
+#include "base/trace.hh"
+#include "cpu/thread_context.hh"
+#include "debug/GPUTLB.hh"
+#include "gpu-compute/gpu_tlb.hh"
+#include "sim/process.hh"
+#include "sim/system.hh"
+
+namespace X86ISA
+{
+    GpuPageWalker::GpuPageWalker(const Params *p)
+        : MemObject(p), tlb(nullptr), port(name() + ".port", this),
+          masterId(p->system->getMasterId(this)), pwc(p->pwc_size),
+          numWalkers(p->num_walkers), activeWalks(0)
+    {
+        fatal_if(numWalkers < 1, "%s: needs at least one walker\n", name());
+    }
+
+    void
+    GpuPageWalker::setTLB(GpuTLB *_tlb)
+    {
+        fatal_if(tlb, "%s: can only serve a single TLB\n", name());
+        tlb = _tlb;
+    }
+
+    BaseMasterPort&
+    GpuPageWalker::getMasterPort(const std::string &if_name, PortID idx)
+    {
+        if (if_name == "port") {
+            return port;
+        } else {
+            return MemObject::getMasterPort(if_name, idx);
+        }
+    }
+
+    void
+    GpuPageWalker::startWalk(Addr virt_page_addr, PacketPtr pkt)
+    {
+        GpuTLB::TranslationState *sender_state =
+            safe_cast<GpuTLB::TranslationState*>(pkt->senderState);
+
+        auto mem_state = sender_state->tc->getProcessPtr()->getMemState();
+        auto p_table =
+            std::dynamic_pointer_cast<ArchPageTable>(mem_state->_pTable);
+
+        fatal_if(!p_table, "%s: the GPU page walker needs an in-memory page "
+                 "table, set useArchPT for the process\n", name());
+
+        WalkState *walk = new WalkState;
+        walk->vaddr = virt_page_addr;
+        walk->pkt = pkt;
+        walk->level = 0;
+        walk->table = p_table->basePtr();
+        walk->startTick = curTick();
+
+        // skip the levels whose tables we know about
+        for (int level = NumLevels - 1; level > 0; --level) {
+            if (pwc.lookup(pwcTag(virt_page_addr, level), walk->table)) {
+                walk->level = level;
+                break;
+            }
+        }
+
+        if (walk->level) {
+            ++pwcHits;
+        } else {
+            ++pwcMisses;
+        }
+
+        DPRINTF(GPUTLB, "Walk for %#x starts at level %d, table %#x\n",
+                virt_page_addr, walk->level, walk->table);
+
+        ++numWalks;
+
+        if (activeWalks < numWalkers) {
+            issueWalk(walk);
+        } else {
+            ++numQueuedWalks;
+            pendingWalks.push_back(walk);
+        }
+    }
+
+    void
+    GpuPageWalker::issueWalk(WalkState *walk)
+    {
+        ++activeWalks;
+        sendEntryRead(walk);
+    }
+
+    void
+    GpuPageWalker::sendEntryRead(WalkState *walk)
+    {
+        int shift = levelShift(walk->level);
+        Addr entry_addr = walk->table + bits(walk->vaddr, shift + 8, shift) *
+            sizeof(PageTableEntry);
+
+        RequestPtr req = new Request(entry_addr, sizeof(PageTableEntry), 0,
+                                     masterId);
+        PacketPtr pkt = new Packet(req, MemCmd::ReadReq);
+        pkt->allocate();
+        pkt->senderState = new WalkerSenderState(walk);
+
+        ++numEntryReads;
+        port.sendReadReq(pkt);
+    }
+
+    void
+    GpuPageWalker::recvEntry(WalkState *walk, PageTableEntry pte)
+    {
+        if (!pte.p) {
+            GpuTLB::TranslationState *sender_state =
+                safe_cast<GpuTLB::TranslationState*>(walk->pkt->senderState);
+            auto mem_state =
+                sender_state->tc->getProcessPtr()->getMemState();
+
+            /**
+             * the page may simply not have been touched yet (e.g., stack
+             * growth), in which case the emulated memory state maps it and
+             * we restart the walk. otherwise this is a real fault.
+             */
+            if (mem_state->fixupFault(walk->vaddr)) {
+                auto p_table = std::static_pointer_cast<ArchPageTable>(
+                    mem_state->_pTable);
+                walk->level = 0;
+                walk->table = p_table->basePtr();
+                sendEntryRead(walk);
+            } else {
+                finishWalk(walk, nullptr);
+            }
+
+            return;
+        }
+
+        panic_if(walk->level < NumLevels - 1 && pte.ps,
+                 "%s: large pages are not supported\n", name());
+
+        Addr next = pte.base << PageShift;
+
+        if (walk->level == NumLevels - 1) {
+            GpuTLB::TranslationState *sender_state =
+                safe_cast<GpuTLB::TranslationState*>(walk->pkt->senderState);
+            Process *p = sender_state->tc->getProcessPtr();
+
+            DPRINTF(GPUTLB, "Walk mapped %#x to %#x\n", walk->vaddr, next);
+
+            // the protection bits are not applied, just as for walks of
+            // the emulated page table
+            finishWalk(walk, new TlbEntry(p->pid(), walk->vaddr, next,
+                                          false, false));
+        } else {
+            ++walk->level;
+            walk->table = next;
+            pwc.insert(pwcTag(walk->vaddr, walk->level), next);
+            sendEntryRead(walk);
+        }
+    }
+
+    void
+    GpuPageWalker::finishWalk(WalkState *walk, TlbEntry *entry)
+    {
+        Addr virt_page_addr = walk->vaddr;
+        PacketPtr pkt = walk->pkt;
+
+        GpuTLB::TranslationState *sender_state =
+            safe_cast<GpuTLB::TranslationState*>(pkt->senderState);
+        sender_state->tlbEntry = entry;
+
+        walkTicks += curTick() - walk->startTick;
+        delete walk;
+
+        --activeWalks;
+
+        if (!pendingWalks.empty()) {
+            WalkState *next_walk = pendingWalks.front();
+            pendingWalks.pop_front();
+            issueWalk(next_walk);
+        }
+
+        tlb->translationReturn(virt_page_addr, GpuTLB::PAGE_WALK, pkt);
+    }
+
+    void
+    GpuPageWalker::WalkerPort::sendReadReq(PacketPtr pkt)
+    {
+        // keep requests in order behind any that are waiting for a retry
+        if (!retries.empty() || !sendTimingReq(pkt)) {
+            retries.push_back(pkt);
+        }
+    }
+
+    bool
+    GpuPageWalker::WalkerPort::recvTimingResp(PacketPtr pkt)
+    {
+        WalkerSenderState *sender_state =
+            safe_cast<WalkerSenderState*>(pkt->senderState);
+        WalkState *walk = sender_state->walk;
+        PageTableEntry pte = pkt->getLE<uint64_t>();
+
+        delete sender_state;
+        delete pkt->req;
+        delete pkt;
+
+        walker->recvEntry(walk, pte);
+
+        return true;
+    }
+
+    void
+    GpuPageWalker::WalkerPort::recvReqRetry()
+    {
+        while (!retries.empty()) {
+            if (!sendTimingReq(retries.front())) {
+                break;
+            }
+
+            retries.pop_front();
+        }
+    }
+
+    bool
+    GpuPageWalker::PageWalkCache::lookup(Addr tag, Addr &table)
+    {
+        auto entry = entryMap.find(tag);
+
+        if (entry == entryMap.end()) {
+            return false;
+        }
+
+        entryList.splice(entryList.begin(), entryList, entry->second);
+        table = entry->second->second;
+
+        return true;
+    }
+
+    void
+    GpuPageWalker::PageWalkCache::insert(Addr tag, Addr table)
+    {
+        if (!numEntries) {
+            return;
+        }
+
+        auto entry = entryMap.find(tag);
+
+        if (entry != entryMap.end()) {
+            entryList.splice(entryList.begin(), entryList, entry->second);
+            entry->second->second = table;
+            return;
+        }
+
+        if (entryList.size() == numEntries) {
+            entryMap.erase(entryList.back().first);
+            entryList.pop_back();
+        }
+
+        entryList.emplace_front(tag, table);
+        entryMap[tag] = entryList.begin();
+    }
+
+    void
+    GpuPageWalker::regStats()
+    {
+        MemObject::regStats();
+
+        numWalks
+            .name(name() + ".num_walks")
+            .desc("Number of page table walks")
+            ;
+
+        numQueuedWalks
+            .name(name() + ".num_queued_walks")
+            .desc("Number of walks that waited for a free walker")
+            ;
+
+        numEntryReads
+            .name(name() + ".num_entry_reads")
+            .desc("Number of page table entries read from memory")
+            ;
+
+        pwcHits
+            .name(name() + ".pwc_hits")
+            .desc("Number of walks that skipped levels thanks to the PWC")
+            ;
+
+        pwcMisses
+            .name(name() + ".pwc_misses")
+            .desc("Number of walks that started at the root of the page "
+                  "table")
+            ;
+
+        walkTicks
+            .name(name() + ".walk_ticks")
+            .desc("Ticks spent walking the page table, including queueing")
+            ;
+
+        walkLatency
+            .name(name() + ".walk_latency")
+            .desc("Avg. latency of a page table walk, in ticks")
+            ;
+
+        walkLatency = walkTicks / numWalks;
+    }
+} // namespace X86ISA
+
+X86ISA::GpuPageWalker*
+X86GPUPageWalkerParams::create()
+{
+    return new X86ISA::GpuPageWalker(this);
+}
@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __GPU_COMPUTE_GPU_PAGE_WALKER_HH__
+#define __GPU_COMPUTE_GPU_PAGE_WALKER_HH__
+
+#include <deque>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include "arch/x86/pagetable.hh"
+#include "base/statistics.hh"
+#include "mem/mem_object.hh"
+#include "mem/packet.hh"
+#include "mem/port.hh"
+#include "params/X86GPUPageWalker.hh"
+
+namespace X86ISA
+{
+    class GpuTLB;
+
+    /**
+     * Timing page table walker for the last-level GPU TLB. Instead of
+     * resolving a miss through the emulated page table after a fixed
+     * latency, the walker reads each level of the process' in-memory
+     * x86-64 page table through its memory port, so walks see the latency
+     * and bandwidth of the memory system they are attached to. Up to
+     * numWalkers walks may be in flight, further walks are queued.
+     *
+     * A page walk cache (PWC) holds the addresses of recently used page
+     * directories, page directory pointer tables and page tables, so a
+     * walk may start at the deepest level that hits in the PWC.
+     */
+    class GpuPageWalker : public MemObject
+    {
+      public:
+        typedef X86GPUPageWalkerParams Params;
+        GpuPageWalker(const Params *p);
+
+        void setTLB(GpuTLB *_tlb);
+
+        /**
+         * walk the page table for virt_page_addr on behalf of the
+         * translation packet pkt. when the walk is done the packet's
+         * TranslationState holds the new TLB entry (or nullptr if the page
+         * is not mapped) and the packet is handed back to the TLB.
+         */
+        void startWalk(Addr virt_page_addr, PacketPtr pkt);
+
+        BaseMasterPort &getMasterPort(const std::string &if_name,
+                                      PortID idx=InvalidPortID) override;
+
+        void regStats() override;
+
+      private:
+        static const int NumLevels = 4;
+
+        // the walk of a single virtual page
+        struct WalkState
+        {
+            Addr vaddr;
+            // the translation packet this walk is for
+            PacketPtr pkt;
+            // the level of the table we read next, 0 is the PML4
+            int level;
+            // the physical base address of that table
+            Addr table;
+            Tick startTick;
+        };
+
+        struct WalkerSenderState : public Packet::SenderState
+        {
+            WalkerSenderState(WalkState *_walk) : walk(_walk) { }
+            WalkState *walk;
+        };
+
+        class WalkerPort : public MasterPort
+        {
+          public:
+            WalkerPort(const std::string &_name, GpuPageWalker *_walker)
+                : MasterPort(_name, _walker), walker(_walker) { }
+
+            void sendReadReq(PacketPtr pkt);
+
+          protected:
+            GpuPageWalker *walker;
+            std::deque<PacketPtr> retries;
+
+            bool recvTimingResp(PacketPtr pkt) override;
+            void recvReqRetry() override;
+        };
+
+        /**
+         * fully-associative, LRU cache of page table entries from the
+         * upper levels of the page table. entries are tagged with the
+         * level of the table they point to and the virtual address bits
+         * that select it.
+         */
+        class PageWalkCache
+        {
+          public:
+            PageWalkCache(int num_entries) : numEntries(num_entries) { }
+
+            bool lookup(Addr tag, Addr &table);
+            void insert(Addr tag, Addr table);
+
+          private:
+            typedef std::list<std::pair<Addr, Addr>> EntryList;
+
+            int numEntries;
+            // MRU entry at the front
+            EntryList entryList;
+            std::unordered_map<Addr, EntryList::iterator> entryMap;
+        };
+
+        static int
+        levelShift(int level)
+        {
+            return PageShift + 9 * (NumLevels - 1 - level);
+        }
+
+        static Addr
+        pwcTag(Addr vaddr, int level)
+        {
+            return ((vaddr >> levelShift(level - 1)) << 2) | level;
+        }
+
+        void issueWalk(WalkState *walk);
+        void sendEntryRead(WalkState *walk);
+        void recvEntry(WalkState *walk, PageTableEntry pte);
+        void finishWalk(WalkState *walk, TlbEntry *entry);
+
+        GpuTLB *tlb;
+        WalkerPort port;
+        MasterID masterId;
+        PageWalkCache pwc;
+
+        int numWalkers;
+        int activeWalks;
+        std::deque<WalkState*> pendingWalks;
+
+        Stats::Scalar numWalks;
+        Stats::Scalar numQueuedWalks;
+        Stats::Scalar numEntryReads;
+        Stats::Scalar pwcHits;
+        Stats::Scalar pwcMisses;
+        Stats::Scalar walkTicks;
+        Stats::Formula walkLatency;
+    };
+}
+
+#endif // __GPU_COMPUTE_GPU_PAGE_WALKER_HH__
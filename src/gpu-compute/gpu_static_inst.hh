@@ -62,9 +62,9 @@ class GPUStaticInst : public GPUStaticInstFlags
   public:
     GPUStaticInst(const std::string &opcode);
     virtual ~GPUStaticInst() { }
-    void instAddr(int inst_addr) { _instAddr = inst_addr; }
-    int instAddr() const { return _instAddr; }
-    int nextInstAddr() const { return _instAddr + instSize(); }
+    void instAddr(Addr inst_addr) { _instAddr = inst_addr; }
+    Addr instAddr() const { return _instAddr; }
+    Addr nextInstAddr() const { return _instAddr + instSize(); }
 
     void instNum(int num) { _instNum = num; }
 
@@ -234,7 +234,9 @@ class GPUStaticInst : public GPUStaticInstFlags
 
     static uint64_t dynamic_id_count;
 
-    // For flat memory accesses
+    // The segment accessed by this instruction. For flat memory
+    // accesses the segment is resolved per dynamic instance, see
+    // GPUDynInst::doApertureCheck()
     Enums::StorageClassType executed_as;
 
     void setFlag(Flags flag) {
@@ -262,7 +264,8 @@ class GPUStaticInst : public GPUStaticInstFlags
     const std::string _opcode;
     std::string disassembly;
     int _instNum;
-    int _instAddr;
+    // PC of the instruction, set by the decode cache
+    Addr _instAddr;
     int srcVecOperands;
     int dstVecOperands;
     int srcVecDWORDs;
@@ -35,8 +35,10 @@
 
 #include "gpu-compute/gpu_tlb.hh"
 
+#include <algorithm>
 #include <cmath>
 #include <cstring>
+#include <iterator>
 
 #include "arch/x86/faults.hh"
 #include "arch/x86/insts/microldstop.hh"
@@ -73,16 +75,8 @@ namespace X86ISA
         accessDistance = p->accessDistance;
 
         tlb.assign(size, TlbEntry());
-
-        freeList.resize(numSets);
-        entryList.resize(numSets);
-
-        for (int set = 0; set < numSets; ++set) {
-            for (int way = 0; way < assoc; ++way) {
-                int x = set * assoc + way;
-                freeList[set].push_back(&tlb.at(x));
-            }
-        }
+        entries.init(tlb.data(), numSets, assoc);
+        numEntriesOfSize.assign(NumPageSizes, 0);
 
         FA = (size == assoc);
 
@@ -102,6 +96,12 @@ namespace X86ISA
         walker->setTLB(this);
     #endif
 
+        pageWalker = p->page_walker;
+
+        if (pageWalker) {
+            pageWalker->setTLB(this);
+        }
+
         maxCoalescedReqs = p->maxOutstandingReqs;
 
         // Do not allow maxCoalescedReqs to be more than the TLB associativity
@@ -165,73 +165,103 @@ namespace X86ISA
         }
     }
 
+    const unsigned GpuTLB::pageSizeLogs[GpuTLB::NumPageSizes] = {
+        TheISA::PageShift, 21, 30
+    };
+
+    int
+    GpuTLB::pageSizeIdx(unsigned log_bytes)
+    {
+        for (int i = 0; i < NumPageSizes; ++i) {
+            if (pageSizeLogs[i] == log_bytes)
+                return i;
+        }
+
+        panic("GpuTLB: unsupported page size %#x\n", Addr(1) << log_bytes);
+    }
+
     TlbEntry*
     GpuTLB::insert(Addr vpn, TlbEntry &entry)
     {
-        TlbEntry *newEntry = nullptr;
+        /**
+         * vpn holds a virtual address within the page, the least
+         * significant bits are simply masked according to the page size
+         */
+        unsigned log_bytes = entry.logBytes;
+        int size_idx = pageSizeIdx(log_bytes);
+        Addr page_vaddr = roundDown(vpn, entry.size());
+        Addr key = entryKey(page_vaddr, log_bytes);
+        int set = entrySet(page_vaddr, log_bytes);
 
         /**
-         * vpn holds the virtual page address
-         * The least significant bits are simply masked
+         * a page may only be cached once, so if the page is already
+         * present we simply update its entry and make it the MRU.
          */
-        int set = (vpn >> TheISA::PageShift) & setMask;
+        TlbEntry *newEntry = entries.lookup(key, set);
 
-        if (!freeList[set].empty()) {
-            newEntry = freeList[set].front();
-            freeList[set].pop_front();
-        } else {
-            newEntry = entryList[set].back();
-            entryList[set].pop_back();
+        if (!newEntry) {
+            TlbEntry *victim = entries.victim(set);
+            if (victim) {
+                --numEntriesOfSize[pageSizeIdx(victim->logBytes)];
+            }
+            newEntry = entries.insert(key, set);
+            ++numEntriesOfSize[size_idx];
         }
 
         *newEntry = entry;
-        newEntry->vaddr = vpn;
-        entryList[set].push_front(newEntry);
+        newEntry->vaddr = page_vaddr;
+
+        pageSizeFills[size_idx]++;
 
         return newEntry;
     }
 
-    GpuTLB::EntryList::iterator
-    GpuTLB::lookupIt(Addr va, bool update_lru)
+    TlbEntry*
+    GpuTLB::lookup(Addr va, bool update_lru)
     {
-        int set = (va >> TheISA::PageShift) & setMask;
+        // the smallest page mapping va wins, should it also be covered by
+        // a stale larger one
+        for (int i = 0; i < NumPageSizes; ++i) {
+            if (!numEntriesOfSize[i])
+                continue;
 
-        if (FA) {
-            assert(!set);
-        }
+            unsigned log_bytes = pageSizeLogs[i];
+            TlbEntry *entry = entries.lookup(entryKey(va, log_bytes),
+                                             entrySet(va, log_bytes),
+                                             update_lru);
 
-        auto entry = entryList[set].begin();
-        for (; entry != entryList[set].end(); ++entry) {
-            int page_size = (*entry)->size();
+            if (!entry)
+                continue;
 
-            if ((*entry)->vaddr <= va && (*entry)->vaddr + page_size > va) {
-                DPRINTF(GPUTLB, "Matched vaddr %#x to entry starting at %#x "
-                        "with size %#x.\n", va, (*entry)->vaddr, page_size);
+            int page_size M5_VAR_USED = entry->size();
 
-                if (update_lru) {
-                    entryList[set].push_front(*entry);
-                    entryList[set].erase(entry);
-                    entry = entryList[set].begin();
-                }
+            assert(entry->vaddr <= va && entry->vaddr + page_size > va);
+            DPRINTF(GPUTLB, "Matched vaddr %#x to entry starting at %#x "
+                    "with size %#x.\n", va, entry->vaddr, page_size);
 
-                break;
-            }
+            return entry;
         }
 
-        return entry;
+        return nullptr;
     }
 
-    TlbEntry*
-    GpuTLB::lookup(Addr va, bool update_lru)
+    TlbEntry
+    GpuTLB::pageTableEntry(Process *p, Addr vaddr,
+                           const EmulationPageTable::Entry *pte)
     {
-        int set = (va >> TheISA::PageShift) & setMask;
+        auto p_table = p->getMemState()->_pTable;
+        Addr page_size = p_table->mappedPageSize(vaddr);
+        Addr page_vaddr = roundDown(vaddr, page_size);
+
+        // pte maps the base page holding vaddr, which the large page
+        // maps contiguously
+        Addr page_paddr = pte->paddr -
+                          (p_table->pageAlign(vaddr) - page_vaddr);
 
-        auto entry = lookupIt(va, update_lru);
+        TlbEntry entry(p->pid(), page_vaddr, page_paddr, false, false);
+        entry.logBytes = floorLog2(page_size);
 
-        if (entry == entryList[set].end())
-            return nullptr;
-        else
-            return *entry;
+        return entry;
     }
 
     void
@@ -239,13 +269,8 @@ namespace X86ISA
     {
         DPRINTF(GPUTLB, "Invalidating all entries.\n");
 
-        for (int i = 0; i < numSets; ++i) {
-            while (!entryList[i].empty()) {
-                TlbEntry *entry = entryList[i].front();
-                entryList[i].pop_front();
-                freeList[i].push_back(entry);
-            }
-        }
+        entries.clear();
+        std::fill(numEntriesOfSize.begin(), numEntriesOfSize.end(), 0);
     }
 
     void
@@ -259,29 +284,23 @@ namespace X86ISA
     {
         DPRINTF(GPUTLB, "Invalidating all non global entries.\n");
 
-        for (int i = 0; i < numSets; ++i) {
-            for (auto entryIt = entryList[i].begin();
-                 entryIt != entryList[i].end();) {
-                if (!(*entryIt)->global) {
-                    freeList[i].push_back(*entryIt);
-                    entryList[i].erase(entryIt++);
-                } else {
-                    ++entryIt;
-                }
-            }
-        }
+        entries.removeIf([this](TlbEntry *entry) {
+            if (entry->global)
+                return false;
+            --numEntriesOfSize[pageSizeIdx(entry->logBytes)];
+            return true;
+        });
     }
 
     void
     GpuTLB::demapPage(Addr va, uint64_t asn)
     {
+        TlbEntry *entry = lookup(va, false);
 
-        int set = (va >> TheISA::PageShift) & setMask;
-        auto entry = lookupIt(va, false);
-
-        if (entry != entryList[set].end()) {
-            freeList[set].push_back(*entry);
-            entryList[set].erase(entry);
+        if (entry) {
+            --numEntriesOfSize[pageSizeIdx(entry->logBytes)];
+            entries.remove(entryKey(entry->vaddr, entry->logBytes),
+                           entrySet(entry->vaddr, entry->logBytes));
         }
     }
 
@@ -701,6 +720,7 @@ namespace X86ISA
                     localNumTLBMisses++;
                 } else {
                     localNumTLBHits++;
+                    pageSizeHits[pageSizeIdx(entry->logBytes)]++;
                 }
             }
         }
@@ -826,20 +846,20 @@ namespace X86ISA
                                                                mode, true,
                                                                false);
                         } else {
-                            Addr alignedVaddr = p_table->pageAlign(vaddr);
+                            TlbEntry gpuEntry = pageTableEntry(p, vaddr, pte);
 
-                            DPRINTF(GPUTLB, "Mapping %#x to %#x\n",
-                                    alignedVaddr, pte->paddr);
+                            DPRINTF(GPUTLB, "Mapping %#x to %#x (%#x)\n",
+                                    gpuEntry.vaddr, gpuEntry.paddr,
+                                    gpuEntry.size());
 
-                            TlbEntry gpuEntry(p->pid(), alignedVaddr,
-                                              pte->paddr, false, false);
-                            entry = insert(alignedVaddr, gpuEntry);
+                            entry = insert(gpuEntry.vaddr, gpuEntry);
                         }
 
                         DPRINTF(GPUTLB, "Miss was serviced.\n");
                     }
                 } else {
                     localNumTLBHits++;
+                    pageSizeHits[pageSizeIdx(entry->logBytes)]++;
 
                     if (timing) {
                         latency = hitLatency;
@@ -1035,6 +1055,25 @@ namespace X86ISA
             .desc("avg. reuse distance over all pages (in ticks)")
             ;
 
+        pageSizeHits
+            .init(NumPageSizes)
+            .name(name() + ".page_size_hits")
+            .desc("Number of TLB hits per page size")
+            ;
+
+        pageSizeFills
+            .init(NumPageSizes)
+            .name(name() + ".page_size_fills")
+            .desc("Number of TLB fills per page size")
+            ;
+
+        const char *page_size_names[NumPageSizes] = {"4KB", "2MB", "1GB"};
+
+        for (int i = 0; i < NumPageSizes; ++i) {
+            pageSizeHits.subname(i, page_size_names[i]);
+            pageSizeFills.subname(i, page_size_names[i]);
+        }
+
     }
 
     /**
@@ -1085,6 +1124,7 @@ namespace X86ISA
             sender_state->tlbEntry =
                 new TlbEntry(p->pid(), entry->vaddr, entry->paddr,
                              false, false);
+            sender_state->tlbEntry->logBytes = entry->logBytes;
 
             if (update_stats) {
                 // the reqCnt has an entry per level, so its size tells us
@@ -1319,6 +1359,13 @@ namespace X86ISA
                 if (update_stats)
                     pageTableCycles -= (req_cnt*curTick());
 
+                if (pageWalker) {
+                    // the walker calls translationReturn() with a
+                    // PAGE_WALK outcome once the walk is done
+                    pageWalker->startWalk(virtPageAddr, pkt);
+                    return;
+                }
+
                 TLBEvent *tlb_event = translationReturnEvent[virtPageAddr];
                 assert(tlb_event);
                 tlb_event->updateOutcome(PAGE_WALK);
@@ -1336,25 +1383,28 @@ namespace X86ISA
             TranslationState *sender_state =
                 safe_cast<TranslationState*>(pkt->senderState);
 
-            auto p = sender_state->tc->getProcessPtr();
-            auto mem_state = p->getMemState();
-            Addr vaddr = pkt->req->getVaddr();
+            // a timing walk has already filled in the TLB entry
+            if (!pageWalker) {
+                auto p = sender_state->tc->getProcessPtr();
+                auto mem_state = p->getMemState();
+                Addr vaddr = pkt->req->getVaddr();
     #ifndef NDEBUG
-            auto p_table = mem_state->_pTable;
-            Addr alignedVaddr = p_table->pageAlign(vaddr);
-            assert(alignedVaddr == virtPageAddr);
+                auto p_table = mem_state->_pTable;
+                Addr alignedVaddr = p_table->pageAlign(vaddr);
+                assert(alignedVaddr == virtPageAddr);
     #endif
-            const EmulationPageTable::Entry *pte = mem_state->lookup(vaddr);
+                const EmulationPageTable::Entry *pte =
+                    mem_state->lookup(vaddr);
 
-            if (pte) {
-                DPRINTF(GPUTLB, "Mapping %#x to %#x\n", alignedVaddr,
-                        pte->paddr);
+                if (pte) {
+                    DPRINTF(GPUTLB, "Mapping %#x to %#x\n", alignedVaddr,
+                            pte->paddr);
 
-                sender_state->tlbEntry =
-                    new TlbEntry(p->pid(), virtPageAddr, pte->paddr, false,
-                                 false);
-            } else {
-                sender_state->tlbEntry = nullptr;
+                    sender_state->tlbEntry =
+                        new TlbEntry(pageTableEntry(p, vaddr, pte));
+                } else {
+                    sender_state->tlbEntry = nullptr;
+                }
             }
 
             handleTranslationReturn(virtPageAddr, TLB_MISS, pkt);
@@ -1559,8 +1609,7 @@ namespace X86ISA
                             pte->paddr);
 
                     sender_state->tlbEntry =
-                        new TlbEntry(p->pid(), virt_page_addr,
-                                     pte->paddr, false, false);
+                        new TlbEntry(tlb->pageTableEntry(p, vaddr, pte));
                 } else {
                     // If this was a prefetch, then do the normal thing if it
                     // was a successful translation.  Otherwise, send an empty
@@ -1571,8 +1620,8 @@ namespace X86ISA
                                 pte->paddr);
 
                         sender_state->tlbEntry =
-                            new TlbEntry(p->pid(), virt_page_addr,
-                                         pte->paddr, false, false);
+                            new TlbEntry(tlb->pageTableEntry(p, vaddr,
+                                                             pte));
                     } else {
                         DPRINTF(GPUPrefetch, "Prefetch failed %#x\n",
                                 alignedVaddr);
@@ -1596,6 +1645,7 @@ namespace X86ISA
             sender_state->tlbEntry =
                 new TlbEntry(p->pid(), entry->vaddr, entry->paddr,
                              false, false);
+            sender_state->tlbEntry->logBytes = entry->logBytes;
         }
         // This is the function that would populate pkt->req with the paddr of
         // the translation. But if no translation happens (i.e Prefetch fails)
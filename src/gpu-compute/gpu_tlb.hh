@@ -37,9 +37,9 @@
 #define __GPU_TLB_HH__
 
 #include <fstream>
-#include <list>
 #include <queue>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "arch/generic/tlb.hh"
@@ -50,7 +50,10 @@
 #include "base/logging.hh"
 #include "base/statistics.hh"
 #include "gpu-compute/compute_unit.hh"
+#include "gpu-compute/gpu_page_walker.hh"
+#include "gpu-compute/lru_index.hh"
 #include "mem/mem_object.hh"
+#include "mem/page_table.hh"
 #include "mem/port.hh"
 #include "mem/request.hh"
 #include "params/X86GPUTLB.hh"
@@ -58,6 +61,7 @@
 
 class BaseTLB;
 class Packet;
+class Process;
 class ThreadContext;
 
 namespace X86ISA
@@ -67,8 +71,6 @@ namespace X86ISA
       protected:
         friend class Walker;
 
-        typedef std::list<TlbEntry*> EntryList;
-
         uint32_t configAddress;
 
       public:
@@ -103,9 +105,15 @@ namespace X86ISA
         void setConfigAddress(uint32_t addr);
 
       protected:
-        EntryList::iterator lookupIt(Addr va, bool update_lru=true);
         Walker *walker;
 
+        /**
+         * if set, misses in this (last-level) TLB are resolved by timing
+         * walks of the in-memory page table rather than by a functional
+         * lookup after missLatency2 cycles.
+         */
+        GpuPageWalker *pageWalker;
+
       public:
         Walker *getWalker();
         void invalidateAll();
@@ -142,21 +150,39 @@ namespace X86ISA
 
         std::vector<TlbEntry> tlb;
 
-        /*
-         * It's a per-set list. As long as we have not reached
-         * the full capacity of the given set, grab an entry from
-         * the freeList.
+        /**
+         * Which tlb entries are valid, keyed by page (see entryKey()),
+         * and the LRU order of the entries of each set. While a set has
+         * free entries, fills take one of those; otherwise they evict
+         * the set's LRU entry.
          */
-        std::vector<EntryList> freeList;
+        LRUIndex<TlbEntry> entries;
 
         /**
-         * An entryList per set is the equivalent of an LRU stack;
-         * it's used to guide replacement decisions. The head of the list
-         * contains the MRU TLB entry of the given set. If the freeList
-         * for this set is empty, the last element of the list
-         * is evicted (i.e., dropped on the floor).
+         * The page sizes (as log2 of their size in bytes) an entry may
+         * map: 4KB, 2MB and 1GB. An entry is placed in the set given by
+         * its page number for its own page size, and is keyed by its
+         * page address and size (see entryKey()), so a lookup probes
+         * each page size we currently hold entries of.
          */
-        std::vector<EntryList> entryList;
+        static const int NumPageSizes = 3;
+        static const unsigned pageSizeLogs[NumPageSizes];
+        static int pageSizeIdx(unsigned log_bytes);
+
+        // number of valid entries of each page size
+        std::vector<int> numEntriesOfSize;
+
+        Addr
+        entryKey(Addr va, unsigned log_bytes) const
+        {
+            return roundDown(va, Addr(1) << log_bytes) | log_bytes;
+        }
+
+        int
+        entrySet(Addr va, unsigned log_bytes) const
+        {
+            return (va >> log_bytes) & setMask;
+        }
 
         Fault translateInt(RequestPtr req, ThreadContext *tc);
 
@@ -198,6 +224,10 @@ namespace X86ISA
         // the avg. over all pages.
         Stats::Scalar avgReuseDistance;
 
+        // hits and fills of this TLB, per page size
+        Stats::Vector pageSizeHits;
+        Stats::Vector pageSizeFills;
+
         void regStats();
         void updatePageFootprint(Addr virt_page_addr);
         void printAccessPattern();
@@ -215,6 +245,13 @@ namespace X86ISA
 
         TlbEntry *insert(Addr vpn, TlbEntry &entry);
 
+        /**
+         * Create the entry for vaddr from its emulated page table entry,
+         * mapping the largest page the page table maps vaddr with.
+         */
+        TlbEntry pageTableEntry(Process *p, Addr vaddr,
+                                const EmulationPageTable::Entry *pte);
+
         // Checkpointing
         virtual void serialize(CheckpointOut& cp) const;
         virtual void unserialize(CheckpointIn& cp);
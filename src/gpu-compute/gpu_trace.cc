@@ -0,0 +1,187 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "gpu-compute/gpu_trace.hh"
+
+#include <cstring>
+
+#include "base/callback.hh"
+#include "base/intmath.hh"
+#include "base/output.hh"
+#include "gpu-compute/compute_unit.hh"
+#include "gpu-compute/wavefront.hh"
+#include "sim/core.hh"
+
+static_assert(sizeof(GPUTrace::Record) == 48,
+              "the size of the trace records must not depend on the host");
+
+GPUTrace::GPUTrace(int num_cus, const std::string &file_name,
+                   int buffer_size, Tick clock_period)
+    : buffers(num_cus + 1), bufferSize(buffer_size),
+      file(simout.create(file_name, true))
+{
+    fatal_if(buffer_size <= 0, "the GPU trace buffers must hold at least "
+             "one record");
+
+    for (auto &buf : buffers) {
+        buf.records.reserve(bufferSize);
+    }
+
+    FileHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, "GEM5GPUT", sizeof(header.magic));
+    header.version = 1;
+    header.recordSize = sizeof(Record);
+    header.tickFrequency = SimClock::Frequency;
+    header.clockPeriod = clock_period;
+    file->stream()->write((const char*)&header, sizeof(header));
+
+    // the simulation may end at any point, so make sure the events that
+    // are still buffered make it to the file
+    registerExitCallback(new MakeCallback<GPUTrace, &GPUTrace::flush>(this));
+}
+
+void
+GPUTrace::append(Buffer &buf, const Record &rec)
+{
+    buf.records.push_back(rec);
+    if (buf.records.size() >= bufferSize) {
+        write(buf);
+    }
+}
+
+void
+GPUTrace::write(Buffer &buf)
+{
+    std::lock_guard<std::mutex> lock(fileMutex);
+    file->stream()->write((const char*)buf.records.data(),
+                          buf.records.size() * sizeof(Record));
+    buf.records.clear();
+}
+
+void
+GPUTrace::record(EventType type, Wavefront *w, uint64_t seq_num,
+                 uint64_t arg)
+{
+    if (w->functionalMode) {
+        return;
+    }
+
+    Record rec;
+    memset(&rec, 0, sizeof(rec));
+    rec.tick = curTick();
+    rec.seqNum = seq_num;
+    rec.arg = arg;
+    rec.kernId = w->kernId;
+    rec.wgId = w->wgId;
+    rec.wfDynId = w->wfDynId;
+    rec.cuId = w->computeUnit->cu_id;
+    rec.wfSlotId = w->wfSlotId;
+    rec.simdId = w->simdId;
+    rec.type = type;
+
+    Buffer &buf = buffers[rec.cuId];
+    std::lock_guard<std::mutex> lock(buf.mutex);
+    append(buf, rec);
+}
+
+void
+GPUTrace::kernelLaunch(int kern_id, const std::string &kern_name)
+{
+    Record rec;
+    memset(&rec, 0, sizeof(rec));
+    rec.tick = curTick();
+    rec.arg = kern_name.size();
+    rec.kernId = kern_id;
+    rec.type = KERNEL_LAUNCH;
+
+    Buffer &buf = buffers.back();
+    std::lock_guard<std::mutex> lock(buf.mutex);
+
+    // the name fills as many records as it needs, which must follow the
+    // launch event in the file. the buffers are written out as a whole,
+    // so the event and its name must not be split across two writes
+    size_t num_records = 1 + divCeil(kern_name.size(), sizeof(Record));
+    if (buf.records.size() + num_records > bufferSize) {
+        write(buf);
+    }
+
+    buf.records.push_back(rec);
+    for (size_t pos = 0; pos < kern_name.size(); pos += sizeof(Record)) {
+        Record name;
+        memset(&name, 0, sizeof(name));
+        kern_name.copy((char*)&name, sizeof(Record), pos);
+        buf.records.push_back(name);
+    }
+
+    if (buf.records.size() >= bufferSize) {
+        write(buf);
+    }
+}
+
+void
+GPUTrace::kernelEnd(int kern_id)
+{
+    Record rec;
+    memset(&rec, 0, sizeof(rec));
+    rec.tick = curTick();
+    rec.kernId = kern_id;
+    rec.type = KERNEL_END;
+
+    Buffer &buf = buffers.back();
+    std::lock_guard<std::mutex> lock(buf.mutex);
+    append(buf, rec);
+}
+
+void
+GPUTrace::wgComplete(int cu_id, int kern_id, int wg_id)
+{
+    Record rec;
+    memset(&rec, 0, sizeof(rec));
+    rec.tick = curTick();
+    rec.kernId = kern_id;
+    rec.wgId = wg_id;
+    rec.cuId = cu_id;
+    rec.type = WG_COMPLETE;
+
+    Buffer &buf = buffers.back();
+    std::lock_guard<std::mutex> lock(buf.mutex);
+    append(buf, rec);
+}
+
+void
+GPUTrace::flush()
+{
+    for (auto &buf : buffers) {
+        std::lock_guard<std::mutex> lock(buf.mutex);
+        if (!buf.records.empty()) {
+            write(buf);
+        }
+    }
+    file->stream()->flush();
+}
@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __GPU_COMPUTE_GPU_TRACE_HH__
+#define __GPU_COMPUTE_GPU_TRACE_HH__
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "base/types.hh"
+
+class OutputStream;
+class Wavefront;
+
+/**
+ * @file gpu_trace.hh
+ *
+ * A timeline trace of the lifecycle of the wavefronts executed by a
+ * shader: wavefront dispatch and completion, instruction issue and
+ * completion, memory requests and responses, barriers, and workgroup and
+ * kernel completion. Unlike the GPUExec and GPUMem debug flags, which
+ * format a line of text for every event, each event is recorded as a
+ * fixed-size binary record in a buffer, which is written out when it
+ * fills up, so the trace can be kept on for long runs.
+ *
+ * The trace is converted to the Chrome trace event format, which can be
+ * viewed in chrome://tracing or the Perfetto UI, by
+ * util/gpu_trace2json.py.
+ *
+ * When the CUs are simulated on separate event queues they record events
+ * from different threads, so each CU has its own buffer. Events are
+ * therefore not written in tick order.
+ */
+class GPUTrace
+{
+  public:
+    enum EventType : uint8_t
+    {
+        WF_DISPATCH,
+        WF_END,
+        // arg is the offset of the instruction from the kernel's code
+        INST_ISSUE,
+        INST_COMPLETE,
+        // arg is the virtual address of the request
+        MEM_SEND,
+        // arg is the physical address of the request
+        MEM_RESP,
+        BARRIER_ARRIVE,
+        BARRIER_RELEASE,
+        WG_COMPLETE,
+        // arg is the length of the kernel's name, which is stored in the
+        // records that follow
+        KERNEL_LAUNCH,
+        KERNEL_END,
+        NUM_EVENT_TYPES
+    };
+
+    /**
+     * The on-disk format of an event. The trace file starts with a
+     * FileHeader, followed by the records.
+     */
+    struct Record
+    {
+        uint64_t tick;
+        uint64_t seqNum;
+        uint64_t arg;
+        uint32_t kernId;
+        uint32_t wgId;
+        uint32_t wfDynId;
+        uint16_t cuId;
+        uint16_t wfSlotId;
+        uint8_t simdId;
+        uint8_t type;
+        uint8_t pad[6];
+    };
+
+    struct FileHeader
+    {
+        char magic[8];
+        uint32_t version;
+        uint32_t recordSize;
+        // the number of ticks per second, and per shader cycle
+        uint64_t tickFrequency;
+        uint64_t clockPeriod;
+    };
+
+    GPUTrace(int num_cus, const std::string &file_name, int buffer_size,
+             Tick clock_period);
+
+    /**
+     * Record an event of a wavefront, e.g., the issue of an instruction.
+     * The events of functionally executed wavefronts are not recorded.
+     */
+    void record(EventType type, Wavefront *w, uint64_t seq_num = 0,
+                uint64_t arg = 0);
+
+    void kernelLaunch(int kern_id, const std::string &kern_name);
+    void kernelEnd(int kern_id);
+    void wgComplete(int cu_id, int kern_id, int wg_id);
+
+    /**
+     * Write out the events in all buffers.
+     */
+    void flush();
+
+  private:
+    struct Buffer
+    {
+        std::mutex mutex;
+        std::vector<Record> records;
+    };
+
+    // append a record to the buffer, which must be locked by the caller
+    void append(Buffer &buf, const Record &rec);
+    void write(Buffer &buf);
+
+    // one buffer per CU, and one for the dispatcher's events
+    std::vector<Buffer> buffers;
+    size_t bufferSize;
+
+    // protects the file, which is shared by all buffers
+    std::mutex fileMutex;
+    OutputStream *file;
+};
+
+#endif // __GPU_COMPUTE_GPU_TRACE_HH__
@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __GPU_COMPUTE_GTO_SCHEDULING_POLICY_HH__
+#define __GPU_COMPUTE_GTO_SCHEDULING_POLICY_HH__
+
+#include <cstdint>
+#include <vector>
+
+#include "base/logging.hh"
+#include "gpu-compute/scheduling_policy.hh"
+#include "gpu-compute/wavefront.hh"
+
+/**
+ * Greedy-then-oldest: keep picking the wave we last picked for as long as
+ * it is ready, and fall back to the oldest ready wave (by wave id), which
+ * then becomes the greedy wave, once it stalls.
+ */
+class GTOSchedulingPolicy final : public SchedulingPolicy
+{
+  public:
+    GTOSchedulingPolicy() : hasGreedyWave(false), greedyWaveId(0)
+    {
+    }
+
+    Wavefront*
+    chooseWave(std::vector<Wavefront*> *sched_list) override
+    {
+        panic_if(!sched_list->size(), "GTO scheduling policy sched list is "
+            "empty.\n");
+        int selected_position = -1;
+        int oldest_position = -1;
+
+        for (int position = 0; position < sched_list->size(); ++position) {
+            Wavefront *cur_wave = sched_list->at(position);
+
+            if (hasGreedyWave && cur_wave->wfDynId == greedyWaveId) {
+                selected_position = position;
+                break;
+            }
+
+            if (oldest_position == -1 || cur_wave->wfDynId <
+                sched_list->at(oldest_position)->wfDynId) {
+                oldest_position = position;
+            }
+        }
+
+        stalled = hasGreedyWave && selected_position == -1;
+
+        if (selected_position == -1) {
+            selected_position = oldest_position;
+            hasGreedyWave = true;
+            greedyWaveId = sched_list->at(selected_position)->wfDynId;
+        }
+
+        return takeWave(sched_list, selected_position);
+    }
+
+  private:
+    bool hasGreedyWave;
+    uint64_t greedyWaveId;
+};
+
+#endif // __GPU_COMPUTE_GTO_SCHEDULING_POLICY_HH__
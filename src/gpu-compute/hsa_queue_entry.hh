@@ -56,10 +56,22 @@
 #include "dev/hsa/hsa_packet.hh"
 #include "dev/hsa/hsa_queue.hh"
 #include "gpu-compute/kernel_code.hh"
+#include "sim/serialize.hh"
 
-class HSAQueueEntry
+class HSAQueueEntry : public Serializable
 {
   public:
+    /**
+     * Create an empty entry, which is used to restore a task from a
+     * checkpoint. All of its fields are set by unserialize(), except
+     * for the dispatch packet pointer, which the dispatcher sets once
+     * the AQL queues are restored.
+     */
+    HSAQueueEntry()
+        : dispPkt(nullptr), _hsaQueueId(0), _priority(0)
+    {
+    }
+
     HSAQueueEntry(std::string kernel_name, uint32_t queue_id,
                   int dispatch_id, void *disp_pkt, AMDKernelCode *akc,
                   Addr host_pkt_addr, Addr code_addr)
@@ -85,7 +97,8 @@ class HSAQueueEntry
                          private_segment_size),
           _contextId(0), _wgId{{ 0, 0, 0 }},
           _numWgTotal(1), numWgArrivedAtBarrier(0), _numWgCompleted(0),
-          _globalWgId(0), dispatchComplete(false)
+          _globalWgId(0), dispatchComplete(false), _functional(false),
+          _hsaQueueId(0), _priority(0)
 
     {
         initialVgprState.reset();
@@ -149,6 +162,12 @@ class HSAQueueEntry
         return dispPkt;
     }
 
+    void
+    dispPktPtr(void *disp_pkt)
+    {
+        dispPkt = disp_pkt;
+    }
+
     Addr
     hostDispPktAddr() const
     {
@@ -193,6 +212,64 @@ class HSAQueueEntry
         return dispatchComplete;
     }
 
+    /**
+     * Whether the kernel's workgroups are executed functionally,
+     * i.e., without the CU pipeline and without timing memory
+     * accesses. This is decided by the dispatcher when the kernel
+     * is launched.
+     */
+    bool
+    functional() const
+    {
+        return _functional;
+    }
+
+    void
+    setFunctional(bool functional)
+    {
+        _functional = functional;
+    }
+
+    /**
+     * The driver-assigned ID of the HSA queue the task was submitted
+     * to. Unlike queueId(), which is the index of the HW queue the
+     * HSA queue is mapped to, it is unique for the lifetime of the
+     * queue.
+     */
+    uint32_t
+    hsaQueueId() const
+    {
+        return _hsaQueueId;
+    }
+
+    uint32_t
+    priority() const
+    {
+        return _priority;
+    }
+
+    /**
+     * Set the scheduling attributes the task inherits from its HSA
+     * queue when it is submitted.
+     */
+    void
+    setQueueAttrs(uint32_t hsa_queue_id, uint32_t priority,
+                  const std::vector<bool> &cu_mask)
+    {
+        _hsaQueueId = hsa_queue_id;
+        _priority = priority;
+        cuMask = cu_mask;
+    }
+
+    /**
+     * Whether the task's WGs may be dispatched to the given CU.
+     */
+    bool
+    cuEnabled(int cu_id) const
+    {
+        return cuMask.empty() || (cu_id < cuMask.size() && cuMask[cu_id]);
+    }
+
     int
     wgId(int dim) const
     {
@@ -363,6 +440,90 @@ class HSAQueueEntry
         assert(_outstandingWbs >= 0);
     }
 
+    /**
+     * Save the task and its progress through the kernel. Only the
+     * number of dispatched and completed WGs is saved, so tasks must
+     * be checkpointed at WG boundaries.
+     */
+    void
+    serialize(CheckpointOut &cp) const override
+    {
+        paramOut(cp, "kern_name", kernName);
+        arrayParamOut(cp, "wg_size", _wgSize.data(), MAX_DIM);
+        arrayParamOut(cp, "grid_size", _gridSize.data(), MAX_DIM);
+        SERIALIZE_SCALAR(numVgprs);
+        SERIALIZE_SCALAR(numSgprs);
+        SERIALIZE_SCALAR(_queueId);
+        SERIALIZE_SCALAR(_dispatchId);
+        SERIALIZE_SCALAR(_hostDispPktAddr);
+        SERIALIZE_SCALAR(_completionSignal);
+        SERIALIZE_SCALAR(codeAddress);
+        SERIALIZE_SCALAR(kernargAddress);
+        SERIALIZE_SCALAR(_outstandingInvs);
+        SERIALIZE_SCALAR(_outstandingWbs);
+        SERIALIZE_SCALAR(_ldsSize);
+        SERIALIZE_SCALAR(_privMemPerItem);
+        SERIALIZE_SCALAR(_contextId);
+        arrayParamOut(cp, "wg_id", _wgId.data(), MAX_DIM);
+        arrayParamOut(cp, "num_wg", _numWg.data(), MAX_DIM);
+        SERIALIZE_SCALAR(_numWgTotal);
+        SERIALIZE_SCALAR(numWgArrivedAtBarrier);
+        SERIALIZE_SCALAR(_numWgCompleted);
+        SERIALIZE_SCALAR(_globalWgId);
+        SERIALIZE_SCALAR(dispatchComplete);
+        SERIALIZE_SCALAR(_functional);
+        SERIALIZE_SCALAR(_hsaQueueId);
+        SERIALIZE_SCALAR(_priority);
+        SERIALIZE_CONTAINER(cuMask);
+        paramOut(cp, "initial_vgpr_state", initialVgprState.to_ulong());
+        paramOut(cp, "initial_sgpr_state", initialSgprState.to_ulong());
+        SERIALIZE_SCALAR(hostAMDQueueAddr);
+        arrayParamOut(cp, "amd_queue", (const uint8_t*)&amdQueue,
+                      sizeof(amdQueue));
+    }
+
+    void
+    unserialize(CheckpointIn &cp) override
+    {
+        unsigned long initial_vgpr_state;
+        unsigned long initial_sgpr_state;
+
+        paramIn(cp, "kern_name", kernName);
+        arrayParamIn(cp, "wg_size", _wgSize.data(), MAX_DIM);
+        arrayParamIn(cp, "grid_size", _gridSize.data(), MAX_DIM);
+        UNSERIALIZE_SCALAR(numVgprs);
+        UNSERIALIZE_SCALAR(numSgprs);
+        UNSERIALIZE_SCALAR(_queueId);
+        UNSERIALIZE_SCALAR(_dispatchId);
+        UNSERIALIZE_SCALAR(_hostDispPktAddr);
+        UNSERIALIZE_SCALAR(_completionSignal);
+        UNSERIALIZE_SCALAR(codeAddress);
+        UNSERIALIZE_SCALAR(kernargAddress);
+        UNSERIALIZE_SCALAR(_outstandingInvs);
+        UNSERIALIZE_SCALAR(_outstandingWbs);
+        UNSERIALIZE_SCALAR(_ldsSize);
+        UNSERIALIZE_SCALAR(_privMemPerItem);
+        UNSERIALIZE_SCALAR(_contextId);
+        arrayParamIn(cp, "wg_id", _wgId.data(), MAX_DIM);
+        arrayParamIn(cp, "num_wg", _numWg.data(), MAX_DIM);
+        UNSERIALIZE_SCALAR(_numWgTotal);
+        UNSERIALIZE_SCALAR(numWgArrivedAtBarrier);
+        UNSERIALIZE_SCALAR(_numWgCompleted);
+        UNSERIALIZE_SCALAR(_globalWgId);
+        UNSERIALIZE_SCALAR(dispatchComplete);
+        UNSERIALIZE_SCALAR(_functional);
+        UNSERIALIZE_SCALAR(_hsaQueueId);
+        UNSERIALIZE_SCALAR(_priority);
+        UNSERIALIZE_CONTAINER(cuMask);
+        UNSERIALIZE_SCALAR(initial_vgpr_state);
+        UNSERIALIZE_SCALAR(initial_sgpr_state);
+        UNSERIALIZE_SCALAR(hostAMDQueueAddr);
+        arrayParamIn(cp, "amd_queue", (uint8_t*)&amdQueue, sizeof(amdQueue));
+
+        initialVgprState = initial_vgpr_state;
+        initialSgprState = initial_sgpr_state;
+    }
+
   private:
     void
     parseKernelCode(AMDKernelCode *akc)
@@ -459,6 +620,11 @@ class HSAQueueEntry
     int _numWgCompleted;
     int _globalWgId;
     bool dispatchComplete;
+    bool _functional;
+    uint32_t _hsaQueueId;
+    uint32_t _priority;
+    // CUs the WGs may be dispatched to, all CUs if empty
+    std::vector<bool> cuMask;
 
     std::bitset<NumVectorInitFields> initialVgprState;
     std::bitset<NumScalarInitFields> initialSgprState;
@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __GPU_COMPUTE_LDS_BANK_CONFLICTS_HH__
+#define __GPU_COMPUTE_LDS_BANK_CONFLICTS_HH__
+
+#include <algorithm>
+#include <vector>
+
+#include "base/intmath.hh"
+#include "base/types.hh"
+
+/**
+ * The bank model of the LDS. Counts the cycles needed to access the
+ * LDS banks for the per-lane addresses of a wavefront. The lanes are
+ * processed in groups of one lane per bank, and within a group the
+ * accesses to the same bank are serialized. Lanes map to banks by bank
+ * word, i.e., (addr / bank width) % banks, and lanes accessing more
+ * than a bank width (e.g., 64-bit accesses) access consecutive banks.
+ */
+class LdsBankConflicts
+{
+  public:
+    LdsBankConflicts(int num_banks, int bank_width)
+        : banks(num_banks), bankWidth(bank_width),
+          bankWidthBits(floorLog2(bank_width)),
+          bankAccessCounts(num_banks, 0)
+    {
+    }
+
+    /**
+     * Returns the cycles needed by the active lanes of exec_mask, each
+     * accessing lane_bytes bytes from its addr. Lanes accessing the same
+     * bank word are served by a single access (a broadcast for loads)
+     * if merge_words is set, and serialized otherwise, as for atomics.
+     * Also adds the number of bank words accessed to numBankAccesses,
+     * and the number of cycles spent above the minimum needed to access
+     * that many words, i.e., due to bank conflicts, to conflictCycles.
+     */
+    template <typename Mask>
+    unsigned
+    count(const Addr *addr, const Mask &exec_mask, int wf_size,
+          int lane_bytes, bool merge_words, unsigned *numBankAccesses,
+          unsigned *conflictCycles)
+    {
+        // the number of lanes accessing the LDS banks at once
+        int group_size = std::min(wf_size, banks);
+        int lane_words = divCeil(lane_bytes, bankWidth) + 1;
+
+        if (groupWords.size() < group_size * lane_words) {
+            groupWords.resize(group_size * lane_words);
+        }
+
+        unsigned cycles = 0;
+
+        for (int group = 0; group < wf_size; group += group_size) {
+            int num_words = 0;
+
+            // gather the bank words accessed by the active lanes
+            for (int lane = group; lane < group + group_size; ++lane) {
+                if (!exec_mask[lane]) {
+                    continue;
+                }
+
+                Addr last_word =
+                    (addr[lane] + lane_bytes - 1) >> bankWidthBits;
+
+                for (Addr word = addr[lane] >> bankWidthBits;
+                     word <= last_word; ++word) {
+                    groupWords[num_words++] = word;
+                }
+            }
+
+            auto words_begin = groupWords.begin();
+            auto words_end = words_begin + num_words;
+
+            if (merge_words) {
+                std::sort(words_begin, words_end);
+                words_end = std::unique(words_begin, words_end);
+                num_words = words_end - words_begin;
+            }
+
+            // the accesses to each bank are serialized, so the group
+            // takes as many cycles as the most accessed bank
+            std::fill(bankAccessCounts.begin(), bankAccessCounts.end(), 0);
+            int max_accesses = 0;
+
+            for (auto word = words_begin; word != words_end; ++word) {
+                int &count = bankAccessCounts[*word & (banks - 1)];
+                max_accesses = std::max(max_accesses, ++count);
+            }
+
+            *numBankAccesses += num_words;
+            *conflictCycles += max_accesses - divCeil(num_words, banks);
+            cycles += max_accesses;
+        }
+
+        return cycles;
+    }
+
+    int getBanks() const { return banks; }
+    int getBankWidth() const { return bankWidth; }
+
+  private:
+    // the number of banks, a power of 2
+    const int banks;
+
+    // the width of each bank in bytes, a power of 2, and its log2
+    const int bankWidth;
+    const int bankWidthBits;
+
+    // scratch space of count(): the bank words accessed by a group of
+    // lanes, and the number of accesses to each bank
+    std::vector<Addr> groupWords;
+    std::vector<int> bankAccessCounts;
+};
+
+#endif // __GPU_COMPUTE_LDS_BANK_CONFLICTS_HH__
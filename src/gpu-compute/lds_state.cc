@@ -36,12 +36,15 @@
 
 #include "gpu-compute/lds_state.hh"
 
+#include <algorithm>
 #include <array>
 #include <cstdio>
 #include <cstdlib>
 
+#include "base/intmath.hh"
 #include "gpu-compute/compute_unit.hh"
 #include "gpu-compute/gpu_dyn_inst.hh"
+#include "gpu-compute/gpu_static_inst.hh"
 #include "gpu-compute/shader.hh"
 
 /**
@@ -54,16 +57,126 @@ LdsState::LdsState(const Params *params) :
     maximumSize(params->size),
     range(params->range),
     bankConflictPenalty(params->bankConflictPenalty),
-    banks(params->banks)
+    bankConflicts(params->banks, params->bankWidth)
 {
     fatal_if(params->banks <= 0,
              "Number of LDS banks should be positive number");
     fatal_if((params->banks & (params->banks - 1)) != 0,
              "Number of LDS banks should be a power of 2");
+    fatal_if(params->bankWidth <= 0 || !isPowerOf2(params->bankWidth),
+             "LDS bank width should be a power of 2");
     fatal_if(params->size <= 0,
              "cannot allocate an LDS with a size less than 1");
     fatal_if(params->size % 2,
           "the LDS should be an even number");
+
+    storage.resize(maximumSize, 0);
+    freeRegions[0] = maximumSize;
+}
+
+LdsChunk *
+LdsState::reserveSpace(const uint32_t dispatchId, const uint32_t wgId,
+                       const uint32_t size)
+{
+    // find the smallest free region the chunk fits in, to keep the large
+    // regions available for the workgroups that need them
+    auto best = freeRegions.end();
+    if (size) {
+        for (auto it = freeRegions.begin(); it != freeRegions.end(); ++it) {
+            if (it->second >= size &&
+                (best == freeRegions.end() || it->second < best->second)) {
+                best = it;
+                if (it->second == size) {
+                    break;
+                }
+            }
+        }
+
+        if (best == freeRegions.end()) {
+            return nullptr;
+        }
+    }
+
+    LdsChunk *chunk;
+    if (freeChunks.empty()) {
+        chunks.emplace_back();
+        chunk = &chunks.back();
+    } else {
+        chunk = freeChunks.back();
+        freeChunks.pop_back();
+    }
+
+    chunk->offset = 0;
+    chunk->data = nullptr;
+    chunk->_size = size;
+    chunk->dispatchId = dispatchId;
+    chunk->wgId = wgId;
+    chunk->refCount = 0;
+
+    if (size) {
+        uint32_t offset = best->first;
+        uint32_t region_size = best->second;
+        freeRegions.erase(best);
+        if (region_size > size) {
+            freeRegions[offset + size] = region_size - size;
+        }
+
+        chunk->offset = offset;
+        chunk->data = storage.data() + offset;
+        std::fill(chunk->data, chunk->data + size, 0);
+        bytesAllocated += size;
+    }
+
+    return chunk;
+}
+
+void
+LdsState::releaseSpace(LdsChunk *chunk)
+{
+    if (chunk->_size) {
+        uint32_t offset = chunk->offset;
+        uint32_t size = chunk->_size;
+
+        // merge the region with its free neighbors, if any
+        auto next = freeRegions.lower_bound(offset);
+        if (next != freeRegions.end() && offset + size == next->first) {
+            size += next->second;
+            next = freeRegions.erase(next);
+        }
+        if (next != freeRegions.begin()) {
+            auto prev = std::prev(next);
+            if (prev->first + prev->second == offset) {
+                offset = prev->first;
+                size += prev->second;
+                freeRegions.erase(prev);
+            }
+        }
+        freeRegions[offset] = size;
+
+        bytesAllocated -= chunk->_size;
+        fatal_if(bytesAllocated < 0,
+                 "more bytes released from the LDS than were allocated");
+    }
+
+    chunk->data = nullptr;
+    chunk->_size = 0;
+    freeChunks.push_back(chunk);
+}
+
+bool
+LdsState::canReserve(uint32_t x_size) const
+{
+    if (!x_size) {
+        return true;
+    }
+
+    for (const auto &region : freeRegions) {
+        if (region.second >= x_size) {
+            return true;
+        }
+    }
+
+    return false;
 }
 
 /**
@@ -94,7 +207,8 @@ LdsState::setParent(ComputeUnit *x_parent)
  * derive the gpu mem packet from the packet and then count the bank conflicts
  */
 unsigned
-LdsState::countBankConflicts(PacketPtr packet, unsigned *bankAccesses)
+LdsState::countBankConflicts(PacketPtr packet, unsigned *bankAccesses,
+                             unsigned *conflictCycles)
 {
     Packet::SenderState *baseSenderState = packet->senderState;
     while (baseSenderState->predecessor) {
@@ -108,69 +222,29 @@ LdsState::countBankConflicts(PacketPtr packet, unsigned *bankAccesses)
 
     GPUDynInstPtr gpuDynInst = senderState->getMemInst();
 
-    return countBankConflicts(gpuDynInst, bankAccesses);
+    return countBankConflicts(gpuDynInst, bankAccesses, conflictCycles);
 }
 
-// Count the total number of bank conflicts for the local memory packet
 unsigned
 LdsState::countBankConflicts(GPUDynInstPtr gpuDynInst,
-                             unsigned *numBankAccesses)
+                             unsigned *numBankAccesses,
+                             unsigned *conflictCycles)
 {
-    int bank_conflicts = 0;
-    std::vector<int> bank;
-    // the number of LDS banks being touched by the memory instruction
-    int numBanks = std::min(parent->wfSize(), banks);
-    // if the wavefront size is larger than the number of LDS banks, we
-    // need to iterate over all work items to calculate the total
-    // number of bank conflicts
-    int groups = (parent->wfSize() > numBanks) ?
-        (parent->wfSize() / numBanks) : 1;
-    for (int i = 0; i < groups; i++) {
-        // Address Array holding all the work item addresses of an instruction
-        std::vector<Addr> addr_array;
-        addr_array.resize(numBanks, 0);
-        bank.clear();
-        bank.resize(banks, 0);
-        int max_bank = 0;
-
-        // populate the address array for all active work items
-        for (int j = 0; j < numBanks; j++) {
-            if (gpuDynInst->exec_mask[(i*numBanks)+j]) {
-                addr_array[j] = gpuDynInst->addr[(i*numBanks)+j];
-            } else {
-                addr_array[j] = std::numeric_limits<Addr>::max();
-            }
-        }
-
-        if (gpuDynInst->isLoad() || gpuDynInst->isStore()) {
-            // mask identical addresses
-            for (int j = 0; j < numBanks; ++j) {
-                for (int j0 = 0; j0 < j; j0++) {
-                    if (addr_array[j] != std::numeric_limits<Addr>::max()
-                                    && addr_array[j] == addr_array[j0]) {
-                        addr_array[j] = std::numeric_limits<Addr>::max();
-                    }
-                }
-            }
-        }
-        // calculate bank conflicts
-        for (int j = 0; j < numBanks; ++j) {
-            if (addr_array[j] != std::numeric_limits<Addr>::max()) {
-                int bankId = addr_array[j] % banks;
-                bank[bankId]++;
-                max_bank = std::max(max_bank, bank[bankId]);
-                // Count the number of LDS banks accessed.
-                // Since we have masked identical addresses all remaining
-                // accesses will need to be serialized if they access
-                // the same bank (bank conflict).
-                (*numBankAccesses)++;
-            }
-        }
-        bank_conflicts += max_bank;
-    }
-    panic_if(bank_conflicts > parent->wfSize(),
-             "Max bank conflicts should match num of work items per instr");
-    return bank_conflicts;
+    // the number of bytes accessed by each lane. the address is the
+    // only source operand that is not data
+    GPUStaticInst *static_inst = gpuDynInst->staticInstruction();
+    int lane_bytes = sizeof(uint32_t) *
+        std::max({static_inst->numDstVecDWORDs(),
+                  static_inst->numSrcVecDWORDs() - 1, 1});
+
+    // atomics to the same word are serialized, other accesses to the
+    // same word are merged
+    bool merge_words = gpuDynInst->isLoad() || gpuDynInst->isStore();
+
+    return bankConflicts.count(gpuDynInst->addr.data(),
+                               gpuDynInst->exec_mask, parent->wfSize(),
+                               lane_bytes, merge_words, numBankAccesses,
+                               conflictCycles);
 }
 
 /**
@@ -198,8 +272,10 @@ bool
 LdsState::processPacket(PacketPtr packet)
 {
     unsigned bankAccesses = 0;
+    unsigned conflictCycles = 0;
     // the number of conflicts this packet will have when accessing the LDS
-    unsigned bankConflicts = countBankConflicts(packet, &bankAccesses);
+    unsigned bankConflicts = countBankConflicts(packet, &bankAccesses,
+                                                &conflictCycles);
     // count the total number of physical LDS bank accessed
     parent->ldsBankAccesses += bankAccesses;
     // count the LDS bank conflicts. A number set to 1 indicates one
@@ -207,6 +283,16 @@ LdsState::processPacket(PacketPtr packet)
     parent->ldsBankConflictDist.sample(bankConflicts-1);
 
     GPUDynInstPtr dynInst = getDynInstr(packet);
+
+    // attribute the cycles lost to bank conflicts to the kernel and to
+    // the instruction, by its PC. kernels have their own code, so the PC
+    // also tells apart the instructions of different kernels
+    if (conflictCycles) {
+        parent->ldsBankConflictsPerKernel.sample(dynInst->kern_id,
+                                                 conflictCycles);
+        parent->ldsBankConflictsPerPc.sample(
+            dynInst->staticInstruction()->instAddr(), conflictCycles);
+    }
     // account for the LDS bank conflict overhead
     int busLength = (dynInst->isLoad()) ? parent->loadBusLength() :
         (dynInst->isStore()) ? parent->storeBusLength() :
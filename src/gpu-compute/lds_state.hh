@@ -38,12 +38,14 @@
 #define __LDS_STATE_HH__
 
 #include <array>
+#include <deque>
+#include <map>
 #include <queue>
 #include <string>
-#include <unordered_map>
 #include <utility>
 #include <vector>
 
+#include "gpu-compute/lds_bank_conflicts.hh"
 #include "gpu-compute/misc.hh"
 #include "mem/mem_object.hh"
 #include "mem/port.hh"
@@ -53,16 +55,12 @@ class ComputeUnit;
 
 /**
  * this represents a slice of the overall LDS, intended to be associated with
- * an individual workgroup
+ * an individual workgroup. the chunk does not own its data, which lives in
+ * the LDS's storage at the chunk's offset.
  */
 class LdsChunk
 {
   public:
-    LdsChunk(const uint32_t x_size):
-        chunk(x_size)
-    {
-    }
-
     LdsChunk() {}
 
     /**
@@ -72,10 +70,10 @@ class LdsChunk
     T
     read(const uint32_t index)
     {
-        fatal_if(!chunk.size(), "cannot read from an LDS chunk of size 0");
-        fatal_if(index >= chunk.size(), "out-of-bounds access to an LDS "
+        fatal_if(!_size, "cannot read from an LDS chunk of size 0");
+        fatal_if(index + sizeof(T) > _size, "out-of-bounds access to an LDS "
             "chunk");
-        T *p0 = (T *) (&(chunk.at(index)));
+        T *p0 = (T *) (data + index);
         return *p0;
     }
 
@@ -86,25 +84,42 @@ class LdsChunk
     void
     write(const uint32_t index, const T value)
     {
-        fatal_if(!chunk.size(), "cannot write to an LDS chunk of size 0");
-        fatal_if(index >= chunk.size(), "out-of-bounds access to an LDS "
+        fatal_if(!_size, "cannot write to an LDS chunk of size 0");
+        fatal_if(index + sizeof(T) > _size, "out-of-bounds access to an LDS "
             "chunk");
-        T *p0 = (T *) (&(chunk.at(index)));
+        T *p0 = (T *) (data + index);
         *p0 = value;
     }
 
     /**
      * get the size of this chunk
      */
-    std::vector<uint8_t>::size_type
+    uint32_t
     size() const
     {
-        return chunk.size();
+        return _size;
     }
 
   protected:
-    // the actual data store for this slice of the LDS
-    std::vector<uint8_t> chunk;
+    friend class LdsState;
+
+    // the data of this slice of the LDS, in the LDS's storage
+    uint8_t *data = nullptr;
+    // the offset of this slice in the LDS, and its size in bytes
+    uint32_t offset = 0;
+    uint32_t _size = 0;
+    // the workgroup this slice is allocated to
+    uint32_t dispatchId = 0;
+    uint32_t wgId = 0;
+    /**
+     * the number of wavefronts that reference this slice. as wavefronts
+     * are launched, the counter goes up for that workgroup and when they
+     * return it decreases, once it reaches 0 then this chunk of the LDS
+     * is returned to the available pool. However,it is deallocated on the
+     * 1->0 transition, not whenever the counter is 0 as it always starts
+     * with 0 when the workgroup asks for space
+     */
+    int32_t refCount = 0;
 };
 
 // Local Data Share (LDS) State per Wavefront (contents of the LDS region
@@ -137,13 +152,13 @@ class LdsState: public MemObject
         void
         schedule(Tick when)
         {
-            mainEventQueue[0]->schedule(this, when);
+            ldsState->eventQueue()->schedule(this, when);
         }
 
         void
         deschedule()
         {
-            mainEventQueue[0]->deschedule(this);
+            ldsState->eventQueue()->deschedule(this);
         }
     };
 
@@ -208,21 +223,22 @@ class LdsState: public MemObject
   protected:
 
     /**
-     * the lds reference counter
-     * The key is the workgroup ID and dispatch ID
-     * The value is the number of wavefronts that reference this LDS, as
-     * wavefronts are launched, the counter goes up for that workgroup and when
-     * they return it decreases, once it reaches 0 then this chunk of the LDS
-     * is returned to the available pool. However,it is deallocated on the 1->0
-     * transition, not whenever the counter is 0 as it always starts with 0
-     * when the workgroup asks for space
+     * the backing storage of the LDS, which holds the chunks of all
+     * resident workgroups, each at its own offset
+     */
+    std::vector<uint8_t> storage;
+
+    /**
+     * the allocation table, with one entry per resident workgroup. the
+     * entries of released chunks are recycled through freeChunks, and
+     * a deque keeps the pointers to the entries stable as it grows
      */
-    std::unordered_map<uint32_t,
-                       std::unordered_map<uint32_t, int32_t>> refCounter;
+    std::deque<LdsChunk> chunks;
+    std::vector<LdsChunk*> freeChunks;
 
-    // the map that allows workgroups to access their own chunk of the LDS
-    std::unordered_map<uint32_t,
-                       std::unordered_map<uint32_t, LdsChunk>> chunkMap;
+    // the unallocated regions of the storage, as offset -> size, where
+    // adjacent regions are always merged
+    std::map<uint32_t, uint32_t> freeRegions;
 
     // an event to allow the LDS to wake up at a specified time
     TickEvent tickEvent;
@@ -245,11 +261,18 @@ class LdsState: public MemObject
     processPacket(PacketPtr packet);
 
     unsigned
-    countBankConflicts(PacketPtr packet, unsigned *bankAccesses);
+    countBankConflicts(PacketPtr packet, unsigned *bankAccesses,
+                       unsigned *conflictCycles);
 
+    /**
+     * Count the cycles needed to access the LDS banks for the given
+     * instruction, see LdsBankConflicts::count(). Lanes accessing the
+     * same bank word are served by a single access, except for atomics.
+     */
     unsigned
     countBankConflicts(GPUDynInstPtr gpuDynInst,
-                       unsigned *numBankAccesses);
+                       unsigned *numBankAccesses,
+                       unsigned *conflictCycles);
 
   public:
     typedef LdsStateParams Params;
@@ -287,117 +310,50 @@ class LdsState: public MemObject
     operator=(const LdsState &) = delete;
 
     /**
-     * use the dynamic wave id to create or just increase the reference count
+     * a wavefront of the workgroup the chunk is allocated to starts
+     * referencing it
      */
     int
-    increaseRefCounter(const uint32_t dispatchId, const uint32_t wgId)
+    increaseRefCounter(LdsChunk *chunk)
     {
-        int refCount = getRefCounter(dispatchId, wgId);
-        fatal_if(refCount < 0,
+        fatal_if(chunk->refCount < 0,
                  "reference count should not be below zero");
-        return ++refCounter[dispatchId][wgId];
+        return ++chunk->refCount;
     }
 
     /**
-     * decrease the reference count after making sure it is in the list
-     * give back this chunk if the ref counter has reached 0
+     * decrease the reference count of the chunk, and give it back if the
+     * ref counter has reached 0
      */
     int
-    decreaseRefCounter(const uint32_t dispatchId, const uint32_t wgId)
+    decreaseRefCounter(LdsChunk *chunk)
     {
-      int refCount = getRefCounter(dispatchId, wgId);
+        fatal_if(chunk->refCount <= 0,
+                 "reference count should not be below zero or at zero to"
+                 "decrement");
 
-      fatal_if(refCount <= 0,
-              "reference count should not be below zero or at zero to"
-              "decrement");
-
-      refCounter[dispatchId][wgId]--;
+        if (--chunk->refCount == 0) {
+            releaseSpace(chunk);
+        }
 
-      if (refCounter[dispatchId][wgId] == 0) {
-        releaseSpace(dispatchId, wgId);
-        return 0;
-      } else {
-        return refCounter[dispatchId][wgId];
-      }
+        return chunk->refCount;
     }
 
     /**
-     * return the current reference count for this workgroup id
+     * return the current reference count of the chunk
      */
     int
-    getRefCounter(const uint32_t dispatchId, const uint32_t wgId) const
+    getRefCounter(const LdsChunk *chunk) const
     {
-      auto dispatchIter = chunkMap.find(dispatchId);
-      fatal_if(dispatchIter == chunkMap.end(),
-               "could not locate this dispatch id [%d]", dispatchId);
-
-      auto workgroup = dispatchIter->second.find(wgId);
-      fatal_if(workgroup == dispatchIter->second.end(),
-               "could not find this workgroup id within this dispatch id"
-               " did[%d] wgid[%d]", dispatchId, wgId);
-
-      auto refCountIter = refCounter.find(dispatchId);
-      if (refCountIter == refCounter.end()) {
-        fatal("could not locate this dispatch id [%d]", dispatchId);
-      } else {
-        auto workgroup = refCountIter->second.find(wgId);
-        if (workgroup == refCountIter->second.end()) {
-          fatal("could not find this workgroup id within this dispatch id"
-                  " did[%d] wgid[%d]", dispatchId, wgId);
-        } else {
-          return refCounter.at(dispatchId).at(wgId);
-        }
-      }
-
-      fatal("should not reach this point");
-      return 0;
+        return chunk->refCount;
     }
 
     /**
-     * assign a parent and request this amount of space be set aside
-     * for this wgid
+     * request this amount of space be set aside for the workgroup,
+     * return nullptr if there is no free region that is large enough
      */
-    LdsChunk *
-    reserveSpace(const uint32_t dispatchId, const uint32_t wgId,
-            const uint32_t size)
-    {
-        if (chunkMap.find(dispatchId) != chunkMap.end()) {
-            panic_if(
-                chunkMap[dispatchId].find(wgId) != chunkMap[dispatchId].end(),
-                "duplicate workgroup ID asking for space in the LDS "
-                "did[%d] wgid[%d]", dispatchId, wgId);
-        }
-
-        if (bytesAllocated + size > maximumSize) {
-            return nullptr;
-        } else {
-            bytesAllocated += size;
-
-            auto value = chunkMap[dispatchId].emplace(wgId, LdsChunk(size));
-            panic_if(!value.second, "was unable to allocate a new chunkMap");
-
-            // make an entry for this workgroup
-            refCounter[dispatchId][wgId] = 0;
-
-            return &chunkMap[dispatchId][wgId];
-        }
-    }
-
-    /*
-     * return pointer to lds chunk for wgid
-     */
-    LdsChunk *
-    getLdsChunk(const uint32_t dispatchId, const uint32_t wgId)
-    {
-      fatal_if(chunkMap.find(dispatchId) == chunkMap.end(),
-          "fetch for unknown dispatch ID did[%d]", dispatchId);
-
-      fatal_if(chunkMap[dispatchId].find(wgId) == chunkMap[dispatchId].end(),
-          "fetch for unknown workgroup ID wgid[%d] in dispatch ID did[%d]",
-          wgId, dispatchId);
-
-      return &chunkMap[dispatchId][wgId];
-    }
+    LdsChunk *reserveSpace(const uint32_t dispatchId, const uint32_t wgId,
+                           const uint32_t size);
 
     bool
     returnQueuePush(std::pair<Tick, PacketPtr> thePair);
@@ -428,7 +384,13 @@ class LdsState: public MemObject
     int
     getBanks() const
     {
-        return banks;
+        return bankConflicts.getBanks();
+    }
+
+    int
+    getBankWidth() const
+    {
+        return bankConflicts.getBankWidth();
     }
 
     ComputeUnit *
@@ -443,15 +405,6 @@ class LdsState: public MemObject
         return bankConflictPenalty;
     }
 
-    /**
-     * get the allocated size for this workgroup
-     */
-    std::size_t
-    ldsSize(const uint32_t x_wgId)
-    {
-        return chunkMap[x_wgId].size();
-    }
-
     AddrRange
     getAddrRange() const
     {
@@ -470,41 +423,35 @@ class LdsState: public MemObject
     }
 
     /**
-     * can this much space be reserved for a workgroup?
+     * can this much space be reserved for a workgroup? the space must be
+     * contiguous, so this may fail even if enough bytes are free
      */
-    bool
-    canReserve(uint32_t x_size) const
+    bool canReserve(uint32_t x_size) const;
+
+    /**
+     * the number of bytes that are not allocated to any workgroup
+     */
+    int
+    freeBytes() const
     {
-      return bytesAllocated + x_size <= maximumSize;
+        return maximumSize - bytesAllocated;
     }
 
-  private:
     /**
-     * give back the space
+     * the fraction of the LDS allocated to workgroups
      */
-    bool
-    releaseSpace(const uint32_t x_dispatchId, const uint32_t x_wgId)
+    double
+    occupancy() const
     {
-        auto dispatchIter = chunkMap.find(x_dispatchId);
-
-        if (dispatchIter == chunkMap.end()) {
-          fatal("dispatch id not found [%d]", x_dispatchId);
-        } else {
-          auto workgroupIter = dispatchIter->second.find(x_wgId);
-          if (workgroupIter == dispatchIter->second.end()) {
-            fatal("workgroup id [%d] not found in dispatch id [%d]",
-                    x_wgId, x_dispatchId);
-          }
-        }
-
-        fatal_if(bytesAllocated < chunkMap[x_dispatchId][x_wgId].size(),
-                 "releasing more space than was allocated");
-
-        bytesAllocated -= chunkMap[x_dispatchId][x_wgId].size();
-        chunkMap[x_dispatchId].erase(chunkMap[x_dispatchId].find(x_wgId));
-        return true;
+        return (double)bytesAllocated / maximumSize;
     }
 
+  private:
+    /**
+     * give back the space
+     */
+    void releaseSpace(LdsChunk *chunk);
+
     // the port that connects this LDS to its owner CU
     CuSidePort cuPort;
 
@@ -524,8 +471,8 @@ class LdsState: public MemObject
     // the penalty, in cycles, for each LDS bank conflict
     int bankConflictPenalty = 0;
 
-    // the number of banks in the LDS underlying data store
-    int banks = 0;
+    // the banks of the LDS underlying data store
+    LdsBankConflicts bankConflicts;
 };
 
 #endif // __LDS_STATE_HH__
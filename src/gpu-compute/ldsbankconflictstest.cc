@@ -0,0 +1,219 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <bitset>
+#include <vector>
+
+#include "gpu-compute/lds_bank_conflicts.hh"
+
+namespace {
+
+const int wfSize = 64;
+
+typedef std::bitset<wfSize> Mask;
+
+struct Result
+{
+    unsigned cycles;
+    unsigned accesses;
+    unsigned conflicts;
+};
+
+Result
+count(LdsBankConflicts &banks, const std::vector<Addr> &addr,
+      int lane_bytes, bool merge_words, const Mask &mask = Mask().set())
+{
+    Result res = { 0, 0, 0 };
+    res.cycles = banks.count(addr.data(), mask, addr.size(), lane_bytes,
+                             merge_words, &res.accesses, &res.conflicts);
+    return res;
+}
+
+std::vector<Addr>
+strided(Addr base, Addr stride, int lanes = wfSize)
+{
+    std::vector<Addr> addr(lanes);
+    for (int lane = 0; lane < lanes; ++lane) {
+        addr[lane] = base + lane * stride;
+    }
+    return addr;
+}
+
+} // anonymous namespace
+
+TEST(LdsBankConflictsTest, ConsecutiveWordsDoNotConflict)
+{
+    LdsBankConflicts banks(32, 4);
+
+    // two groups of 32 lanes, one word in each bank per group
+    Result res = count(banks, strided(0x100, 4), 4, true);
+    EXPECT_EQ(2, res.cycles);
+    EXPECT_EQ(64, res.accesses);
+    EXPECT_EQ(0, res.conflicts);
+}
+
+TEST(LdsBankConflictsTest, StridedWordsConflict)
+{
+    LdsBankConflicts banks(32, 4);
+
+    // a stride of two words leaves every other bank unused, and the
+    // other banks are accessed twice per group
+    Result res = count(banks, strided(0, 8), 4, true);
+    EXPECT_EQ(4, res.cycles);
+    EXPECT_EQ(64, res.accesses);
+    EXPECT_EQ(2, res.conflicts);
+
+    // a stride of the number of banks serializes every group
+    res = count(banks, strided(0, 32 * 4), 4, true);
+    EXPECT_EQ(64, res.cycles);
+    EXPECT_EQ(62, res.conflicts);
+}
+
+TEST(LdsBankConflictsTest, BroadcastReads)
+{
+    LdsBankConflicts banks(32, 4);
+
+    // all the lanes of a group read the same word with one access
+    Result res = count(banks, strided(0x40, 0), 4, true);
+    EXPECT_EQ(2, res.cycles);
+    EXPECT_EQ(2, res.accesses);
+    EXPECT_EQ(0, res.conflicts);
+
+    // lanes reading different bytes of one word share it too
+    res = count(banks, strided(0x40, 1, 4), 1, true);
+    EXPECT_EQ(1, res.cycles);
+    EXPECT_EQ(1, res.accesses);
+}
+
+TEST(LdsBankConflictsTest, AtomicsToOneWordAreSerialized)
+{
+    LdsBankConflicts banks(32, 4);
+
+    Result res = count(banks, strided(0x40, 0), 4, false);
+    EXPECT_EQ(64, res.cycles);
+    EXPECT_EQ(64, res.accesses);
+    EXPECT_EQ(62, res.conflicts);
+}
+
+TEST(LdsBankConflictsTest, DualBankAccesses)
+{
+    LdsBankConflicts banks(32, 4);
+
+    // each 64-bit lane accesses two consecutive banks, so a group of
+    // 32 lanes needs two accesses to every bank
+    Result res = count(banks, strided(0, 8), 8, true);
+    EXPECT_EQ(4, res.cycles);
+    EXPECT_EQ(128, res.accesses);
+    EXPECT_EQ(0, res.conflicts);
+
+    // a misaligned access spans the banks of both of its words
+    Mask one_lane;
+    one_lane.set(0);
+    std::vector<Addr> addr(wfSize, 0);
+    addr[0] = 31 * 4 + 2;
+    res = count(banks, addr, 8, true, one_lane);
+    EXPECT_EQ(1, res.cycles);
+    EXPECT_EQ(3, res.accesses);
+    EXPECT_EQ(0, res.conflicts);
+
+    // two lanes of a group accessing banks 0-1 and 1-2 conflict in
+    // bank 1
+    Mask two_lanes;
+    two_lanes.set(0).set(1);
+    addr[0] = 0;
+    addr[1] = 4;
+    res = count(banks, addr, 8, false, two_lanes);
+    EXPECT_EQ(2, res.cycles);
+    EXPECT_EQ(4, res.accesses);
+    EXPECT_EQ(1, res.conflicts);
+}
+
+TEST(LdsBankConflictsTest, NonDefaultBanks)
+{
+    // 16 banks of 8 bytes, so four groups of 16 lanes
+    LdsBankConflicts banks(16, 8);
+    EXPECT_EQ(16, banks.getBanks());
+    EXPECT_EQ(8, banks.getBankWidth());
+
+    // 64-bit lanes fit in one bank each
+    Result res = count(banks, strided(0, 8), 8, true);
+    EXPECT_EQ(4, res.cycles);
+    EXPECT_EQ(64, res.accesses);
+    EXPECT_EQ(0, res.conflicts);
+
+    // pairs of 32-bit lanes share a word, which loads merge...
+    res = count(banks, strided(0, 4), 4, true);
+    EXPECT_EQ(4, res.cycles);
+    EXPECT_EQ(32, res.accesses);
+    EXPECT_EQ(0, res.conflicts);
+
+    // ...but atomics serialize
+    res = count(banks, strided(0, 4), 4, false);
+    EXPECT_EQ(8, res.cycles);
+    EXPECT_EQ(64, res.accesses);
+    EXPECT_EQ(4, res.conflicts);
+
+    // 128-bit lanes access two banks each
+    res = count(banks, strided(0, 16), 16, true);
+    EXPECT_EQ(8, res.cycles);
+    EXPECT_EQ(128, res.accesses);
+    EXPECT_EQ(0, res.conflicts);
+}
+
+TEST(LdsBankConflictsTest, MoreBanksThanLanes)
+{
+    LdsBankConflicts banks(64, 4);
+
+    // a 16-lane wavefront is a single group
+    Result res = count(banks, strided(0, 4, 16), 4, true);
+    EXPECT_EQ(1, res.cycles);
+    EXPECT_EQ(16, res.accesses);
+    EXPECT_EQ(0, res.conflicts);
+}
+
+TEST(LdsBankConflictsTest, InactiveLanesDoNotAccess)
+{
+    LdsBankConflicts banks(32, 4);
+
+    Result res = count(banks, strided(0, 32 * 4), 4, true, Mask());
+    EXPECT_EQ(0, res.cycles);
+    EXPECT_EQ(0, res.accesses);
+    EXPECT_EQ(0, res.conflicts);
+
+    // only the even lanes of the first group, all in bank 0
+    Mask even;
+    for (int lane = 0; lane < 32; lane += 2) {
+        even.set(lane);
+    }
+    res = count(banks, strided(0, 32 * 4), 4, true, even);
+    EXPECT_EQ(16, res.cycles);
+    EXPECT_EQ(16, res.accesses);
+    EXPECT_EQ(15, res.conflicts);
+}
@@ -85,6 +85,11 @@ LocalMemPipeline::exec()
                 m->cu_id, m->simdId, m->wfSlotId, m->disassemble());
         m->completeAcc(m);
 
+        if (computeUnit->shader->trace()) {
+            computeUnit->shader->trace()->record(GPUTrace::INST_COMPLETE,
+                                                 w, m->seqNum());
+        }
+
         if (m->isLoad() || m->isAtomicRet()) {
             w->computeUnit->vrf[w->simdId]->
                 scheduleWriteOperandsFromLoad(w, m);
@@ -127,6 +132,11 @@ LocalMemPipeline::exec()
 void
 LocalMemPipeline::issueRequest(GPUDynInstPtr gpuDynInst)
 {
+    if (gpuDynInst->wavefront()->functionalMode) {
+        computeUnit->execFunctionalAccess(gpuDynInst);
+        return;
+    }
+
     gpuDynInst->setAccessTime(curTick());
     lmIssuedRequests.push(gpuDynInst);
 }
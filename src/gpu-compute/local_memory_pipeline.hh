@@ -77,6 +77,12 @@ class LocalMemPipeline
         return (lmIssuedRequests.size() + pendReqs) < lmQueueSize;
     }
 
+    bool
+    isQuiescent() const
+    {
+        return lmIssuedRequests.empty() && lmReturnedRequests.empty();
+    }
+
     const std::string& name() const { return _name; }
     void regStats();
 
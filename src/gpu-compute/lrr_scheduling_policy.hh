@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __GPU_COMPUTE_LRR_SCHEDULING_POLICY_HH__
+#define __GPU_COMPUTE_LRR_SCHEDULING_POLICY_HH__
+
+#include <cstdint>
+#include <vector>
+
+#include "base/logging.hh"
+#include "gpu-compute/scheduling_policy.hh"
+#include "gpu-compute/wavefront.hh"
+
+/**
+ * Loose round-robin: waves take turns by the slot they occupy in the CU,
+ * picking the first ready wave after the slot of the wave picked last,
+ * so a wave that is not ready simply loses its turn.
+ */
+class LRRSchedulingPolicy final : public SchedulingPolicy
+{
+  public:
+    LRRSchedulingPolicy() : lastSlot(-1)
+    {
+    }
+
+    Wavefront*
+    chooseWave(std::vector<Wavefront*> *sched_list) override
+    {
+        panic_if(!sched_list->size(), "LRR scheduling policy sched list is "
+            "empty.\n");
+        // the first ready slot after lastSlot, and the first overall for
+        // when we need to wrap around
+        int next_position = -1;
+        int first_position = -1;
+
+        for (int position = 0; position < sched_list->size(); ++position) {
+            int64_t slot = waveSlot(sched_list->at(position));
+
+            if (slot > lastSlot && (next_position == -1 ||
+                slot < waveSlot(sched_list->at(next_position)))) {
+                next_position = position;
+            }
+
+            if (first_position == -1 ||
+                slot < waveSlot(sched_list->at(first_position))) {
+                first_position = position;
+            }
+        }
+
+        int selected_position =
+            next_position != -1 ? next_position : first_position;
+        lastSlot = waveSlot(sched_list->at(selected_position));
+
+        return takeWave(sched_list, selected_position);
+    }
+
+  private:
+    int64_t lastSlot;
+
+    static int64_t
+    waveSlot(const Wavefront *w)
+    {
+        return ((int64_t)w->simdId << 32) | w->wfSlotId;
+    }
+};
+
+#endif // __GPU_COMPUTE_LRR_SCHEDULING_POLICY_HH__
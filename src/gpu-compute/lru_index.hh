@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __GPU_COMPUTE_LRU_INDEX_HH__
+#define __GPU_COMPUTE_LRU_INDEX_HH__
+
+#include <cassert>
+#include <iterator>
+#include <list>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "base/types.hh"
+
+/**
+ * Tracks which of a fixed pool of entries hold which keys, and the LRU
+ * order of the entries in each set. Each set has an LRU list, with the
+ * MRU entry at its head, and a list of free entries. A hash map from
+ * key to list node makes lookups, fills, evictions and removals O(1)
+ * regardless of associativity, which matters for large
+ * fully-associative structures such as the GPU TLBs.
+ *
+ * The index only hands out entries; filling in their contents is up
+ * to the user. Keys must be unique across all sets.
+ */
+template <class Entry>
+class LRUIndex
+{
+  public:
+    /**
+     * Give each of the num_sets sets the assoc entries starting at
+     * entries + set * assoc, all of them initially free.
+     */
+    void
+    init(Entry *entries, int num_sets, int assoc)
+    {
+        freeLists.assign(num_sets, FreeList());
+        lruLists.assign(num_sets, LRUList());
+        index.clear();
+        index.reserve(num_sets * assoc);
+
+        for (int set = 0; set < num_sets; ++set) {
+            for (int way = 0; way < assoc; ++way) {
+                freeLists[set].push_back(&entries[set * assoc + way]);
+            }
+        }
+    }
+
+    /**
+     * Returns the entry holding key, which lives in set, or nullptr if
+     * there is none. A hit makes the entry the MRU of its set unless
+     * update_lru is false.
+     */
+    Entry *
+    lookup(Addr key, int set, bool update_lru=true)
+    {
+        auto mapped = index.find(key);
+        if (mapped == index.end())
+            return nullptr;
+
+        if (update_lru) {
+            // splicing keeps the iterator in the index valid
+            LRUList &lru = lruLists[set];
+            lru.splice(lru.begin(), lru, mapped->second);
+        }
+
+        return mapped->second->second;
+    }
+
+    /**
+     * Returns the entry insert() would evict from set, or nullptr if
+     * the set still has a free entry.
+     */
+    Entry *
+    victim(int set) const
+    {
+        if (!freeLists[set].empty())
+            return nullptr;
+        return lruLists[set].back().second;
+    }
+
+    /**
+     * Gives key, which must not be present, a free entry of set, or
+     * else its LRU entry, and makes that entry the MRU of the set.
+     */
+    Entry *
+    insert(Addr key, int set)
+    {
+        assert(index.find(key) == index.end());
+
+        LRUList &lru = lruLists[set];
+        FreeList &free_list = freeLists[set];
+
+        if (!free_list.empty()) {
+            lru.emplace_front(key, free_list.front());
+            free_list.pop_front();
+        } else {
+            index.erase(lru.back().first);
+            lru.splice(lru.begin(), lru, std::prev(lru.end()));
+            lru.front().first = key;
+        }
+
+        index[key] = lru.begin();
+        return lru.front().second;
+    }
+
+    /** Frees the entry holding key, if any. Returns true if it did. */
+    bool
+    remove(Addr key, int set)
+    {
+        auto mapped = index.find(key);
+        if (mapped == index.end())
+            return false;
+
+        freeLists[set].push_back(mapped->second->second);
+        lruLists[set].erase(mapped->second);
+        index.erase(mapped);
+        return true;
+    }
+
+    /** Frees every entry for which pred(entry) returns true. */
+    template <class Pred>
+    void
+    removeIf(Pred pred)
+    {
+        for (int set = 0; set < lruLists.size(); ++set) {
+            LRUList &lru = lruLists[set];
+            for (auto it = lru.begin(); it != lru.end();) {
+                if (pred(it->second)) {
+                    index.erase(it->first);
+                    freeLists[set].push_back(it->second);
+                    it = lru.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+        }
+    }
+
+    /** Frees every entry, in MRU to LRU order within each set. */
+    void
+    clear()
+    {
+        removeIf([](Entry *entry) { return true; });
+    }
+
+  private:
+    typedef std::list<Entry*> FreeList;
+    typedef std::list<std::pair<Addr, Entry*>> LRUList;
+
+    std::vector<FreeList> freeLists;
+    std::vector<LRUList> lruLists;
+    std::unordered_map<Addr, typename LRUList::iterator> index;
+};
+
+#endif // __GPU_COMPUTE_LRU_INDEX_HH__
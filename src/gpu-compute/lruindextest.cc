@@ -0,0 +1,285 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <list>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "base/gtest/benchmark.hh"
+#include "gpu-compute/lru_index.hh"
+
+namespace {
+
+const int pageShift = 12;
+
+struct Entry
+{
+    Addr key = 0;
+};
+
+/**
+ * The per-set LRU list walk GpuTLB used before it had an LRUIndex,
+ * kept as the reference the index has to match.
+ */
+class ListWalk
+{
+  public:
+    ListWalk(Entry *entries, int num_sets, int assoc)
+        : freeList(num_sets), entryList(num_sets)
+    {
+        for (int set = 0; set < num_sets; ++set) {
+            for (int way = 0; way < assoc; ++way)
+                freeList[set].push_back(&entries[set * assoc + way]);
+        }
+    }
+
+    Entry *
+    lookup(Addr key, int set)
+    {
+        auto entry = entryList[set].begin();
+        for (; entry != entryList[set].end(); ++entry) {
+            if ((*entry)->key == key) {
+                entryList[set].push_front(*entry);
+                entryList[set].erase(entry);
+                return entryList[set].front();
+            }
+        }
+        return nullptr;
+    }
+
+    Entry *
+    insert(Addr key, int set)
+    {
+        Entry *entry;
+        if (!freeList[set].empty()) {
+            entry = freeList[set].front();
+            freeList[set].pop_front();
+        } else {
+            entry = entryList[set].back();
+            entryList[set].pop_back();
+        }
+        entry->key = key;
+        entryList[set].push_front(entry);
+        return entry;
+    }
+
+    void
+    remove(Addr key, int set)
+    {
+        for (auto entry = entryList[set].begin();
+             entry != entryList[set].end(); ++entry) {
+            if ((*entry)->key == key) {
+                freeList[set].push_back(*entry);
+                entryList[set].erase(entry);
+                return;
+            }
+        }
+    }
+
+    void
+    clear()
+    {
+        for (int set = 0; set < entryList.size(); ++set) {
+            while (!entryList[set].empty()) {
+                freeList[set].push_back(entryList[set].front());
+                entryList[set].pop_front();
+            }
+        }
+    }
+
+  private:
+    std::vector<std::list<Entry*>> freeList;
+    std::vector<std::list<Entry*>> entryList;
+};
+
+int
+setOf(Addr key, int num_sets)
+{
+    return (key >> pageShift) & (num_sets - 1);
+}
+
+Addr
+page(int n)
+{
+    return Addr(n) << pageShift;
+}
+
+/**
+ * Runs the same random accesses, demaps and flushes against an
+ * LRUIndex and the list walk, checking that they agree on every hit,
+ * miss and victim.
+ */
+void
+compareWithListWalk(int size, int assoc, int num_pages)
+{
+    const int numSets = size / assoc;
+
+    std::vector<Entry> idxEntries(size), refEntries(size);
+    LRUIndex<Entry> idx;
+    idx.init(idxEntries.data(), numSets, assoc);
+    ListWalk ref(refEntries.data(), numSets, assoc);
+
+    std::mt19937 rng(size * assoc);
+    std::uniform_int_distribution<int> pageDist(0, num_pages - 1);
+    std::uniform_int_distribution<int> opDist(0, 99);
+
+    for (int i = 0; i < 20000; ++i) {
+        Addr key = page(pageDist(rng));
+        int set = setOf(key, numSets);
+        int op = opDist(rng);
+
+        if (op < 5) {
+            idx.remove(key, set);
+            ref.remove(key, set);
+        } else if (op == 5) {
+            idx.clear();
+            ref.clear();
+        } else {
+            Entry *hit = idx.lookup(key, set);
+            Entry *refHit = ref.lookup(key, set);
+            ASSERT_EQ(refHit != nullptr, hit != nullptr);
+            if (hit) {
+                ASSERT_EQ(refHit - refEntries.data(),
+                          hit - idxEntries.data());
+                continue;
+            }
+
+            Entry *victim = idx.victim(set);
+            Entry *filled = idx.insert(key, set);
+            filled->key = key;
+            Entry *refFilled = ref.insert(key, set);
+            ASSERT_EQ(refFilled - refEntries.data(),
+                      filled - idxEntries.data());
+            if (victim) {
+                ASSERT_EQ(victim, filled);
+            }
+        }
+    }
+}
+
+} // anonymous namespace
+
+TEST(LRUIndexTest, HitAndMiss)
+{
+    std::vector<Entry> entries(8);
+    LRUIndex<Entry> idx;
+    idx.init(entries.data(), 2, 4);
+
+    EXPECT_EQ(nullptr, idx.lookup(page(0), 0));
+    Entry *entry = idx.insert(page(0), 0);
+    EXPECT_EQ(&entries[0], entry);
+    EXPECT_EQ(entry, idx.lookup(page(0), 0));
+    EXPECT_EQ(nullptr, idx.lookup(page(1), 1));
+
+    // the second set hands out its own entries
+    EXPECT_EQ(&entries[4], idx.insert(page(1), 1));
+
+    EXPECT_TRUE(idx.remove(page(0), 0));
+    EXPECT_FALSE(idx.remove(page(0), 0));
+    EXPECT_EQ(nullptr, idx.lookup(page(0), 0));
+}
+
+TEST(LRUIndexTest, EvictOrder)
+{
+    std::vector<Entry> entries(4);
+    LRUIndex<Entry> idx;
+    idx.init(entries.data(), 1, 4);
+
+    for (int p = 0; p < 4; ++p) {
+        EXPECT_EQ(nullptr, idx.victim(0));
+        idx.insert(page(p), 0);
+    }
+
+    // touching page 0 makes page 1 the LRU
+    idx.lookup(page(0), 0);
+    Entry *page1 = idx.lookup(page(1), 0, false);
+    EXPECT_EQ(page1, idx.victim(0));
+    EXPECT_EQ(page1, idx.insert(page(4), 0));
+    EXPECT_EQ(nullptr, idx.lookup(page(1), 0));
+
+    // and a lookup without an LRU update leaves page 2 the LRU
+    Entry *page2 = idx.lookup(page(2), 0, false);
+    EXPECT_EQ(page2, idx.victim(0));
+
+    // freed entries are reused before anything is evicted
+    idx.removeIf([page2](Entry *entry) { return entry == page2; });
+    EXPECT_EQ(nullptr, idx.victim(0));
+    EXPECT_EQ(page2, idx.insert(page(5), 0));
+}
+
+TEST(LRUIndexTest, MatchesListWalk)
+{
+    compareWithListWalk(32, 32, 48);
+    compareWithListWalk(64, 4, 160);
+    compareWithListWalk(512, 8, 700);
+    compareWithListWalk(4096, 4096, 5000);
+}
+
+/**
+ * Lookup throughput of fully-associative TLBs from 32 to 4096 entries,
+ * with a working set a quarter larger than the TLB, for the index and
+ * the list walk it replaced. A benchmark, so only run on request.
+ */
+TEST(LRUIndexTest, DISABLED_LookupThroughput)
+{
+    const int numAccesses = 1 << 20;
+
+    for (int size = 32; size <= 4096; size *= 2) {
+        std::vector<Entry> idxEntries(size), refEntries(size);
+        LRUIndex<Entry> idx;
+        idx.init(idxEntries.data(), 1, size);
+        ListWalk ref(refEntries.data(), 1, size);
+
+        std::mt19937 rng(size);
+        std::uniform_int_distribution<int> pageDist(0, size * 5 / 4 - 1);
+        std::vector<Addr> keys(numAccesses);
+        for (auto &key : keys)
+            key = page(pageDist(rng));
+
+        std::string entries = std::to_string(size) + "_entries";
+
+        recordThroughput(entries + "_index_lookups_per_second",
+                         numAccesses, [&]() {
+            for (auto key : keys) {
+                if (!idx.lookup(key, 0))
+                    idx.insert(key, 0)->key = key;
+            }
+        });
+
+        recordThroughput(entries + "_list_walk_lookups_per_second",
+                         numAccesses, [&]() {
+            for (auto key : keys) {
+                if (!ref.lookup(key, 0))
+                    ref.insert(key, 0);
+            }
+        });
+    }
+}
@@ -37,8 +37,12 @@
 #define __MISC_HH__
 
 #include <bitset>
+#include <cstdint>
 #include <limits>
 #include <memory>
+#include <new>
+#include <utility>
+#include <vector>
 
 #include "base/logging.hh"
 #include "sim/clocked_object.hh"
@@ -112,6 +116,160 @@ class WaitClass
     uint64_t numStages;
 };
 
+/**
+ * A free list of fixed size byte buffers. Buffers are returned to the
+ * pool when released and handed out again by the next acquire(), so
+ * objects that are created and destroyed at a high rate (e.g., the
+ * per-lane data of dynamic instructions) do not hit the heap once the
+ * pool has grown to the number of objects in flight.
+ */
+class BufferPool
+{
+  public:
+    BufferPool(size_t buf_size) : bufSize(buf_size) { }
+
+    ~BufferPool()
+    {
+        for (auto buf : freeList) {
+            delete[] buf;
+        }
+    }
+
+    BufferPool(const BufferPool&) = delete;
+    BufferPool &operator=(const BufferPool&) = delete;
+
+    uint8_t*
+    acquire()
+    {
+        if (freeList.empty()) {
+            return new uint8_t[bufSize];
+        }
+
+        uint8_t *buf = freeList.back();
+        freeList.pop_back();
+        return buf;
+    }
+
+    void release(uint8_t *buf) { freeList.push_back(buf); }
+
+    // true if the next acquire() has to allocate a new buffer
+    bool empty() const { return freeList.empty(); }
+
+    size_t size() const { return bufSize; }
+
+  private:
+    const size_t bufSize;
+    std::vector<uint8_t*> freeList;
+};
+
+/**
+ * A free list of objects of a single type. acquire() constructs a new
+ * object in the storage of a previously released one, if there is any,
+ * and release() destroys an object but keeps its storage for the next
+ * acquire(). Objects that were created with new may be released to the
+ * pool too.
+ */
+template<typename T>
+class ObjectPool
+{
+  public:
+    ObjectPool() { }
+
+    ~ObjectPool()
+    {
+        for (auto obj : freeList) {
+            ::operator delete(obj);
+        }
+    }
+
+    ObjectPool(const ObjectPool&) = delete;
+    ObjectPool &operator=(const ObjectPool&) = delete;
+
+    template<typename... Args>
+    T*
+    acquire(Args&&... args)
+    {
+        if (freeList.empty()) {
+            return new T(std::forward<Args>(args)...);
+        }
+
+        void *obj = freeList.back();
+        freeList.pop_back();
+        return new (obj) T(std::forward<Args>(args)...);
+    }
+
+    void
+    release(T *obj)
+    {
+        obj->~T();
+        freeList.push_back(obj);
+    }
+
+    // true if the next acquire() has to allocate a new object
+    bool empty() const { return freeList.empty(); }
+
+  private:
+    std::vector<void*> freeList;
+};
+
+/**
+ * An allocator that recycles single-object allocations through a free
+ * list shared by all allocators of the same type. This is intended for
+ * std::allocate_shared(), which rebinds the allocator to the type of
+ * its combined object and control block, so each shared object costs a
+ * single heap allocation the first time, and none after it is recycled.
+ * Memory on the free list is never returned to the heap. Each simulation
+ * thread has its own list, so CUs simulated on different event queues
+ * never contend for it.
+ */
+template<typename T>
+class FreeListAllocator
+{
+  public:
+    typedef T value_type;
+
+    FreeListAllocator() { }
+
+    template<typename U>
+    FreeListAllocator(const FreeListAllocator<U>&) { }
+
+    T*
+    allocate(size_t n)
+    {
+        if (n == 1 && !freeList().empty()) {
+            T *ptr = freeList().back();
+            freeList().pop_back();
+            return ptr;
+        }
+
+        return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+
+    void
+    deallocate(T *ptr, size_t n)
+    {
+        if (n == 1) {
+            freeList().push_back(ptr);
+        } else {
+            ::operator delete(ptr);
+        }
+    }
+
+    template<typename U>
+    bool operator==(const FreeListAllocator<U>&) const { return true; }
+
+    template<typename U>
+    bool operator!=(const FreeListAllocator<U>&) const { return false; }
+
+  private:
+    static std::vector<T*>&
+    freeList()
+    {
+        static thread_local std::vector<T*> free_list;
+        return free_list;
+    }
+};
+
 class Float16
 {
   public:
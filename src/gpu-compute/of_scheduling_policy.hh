@@ -74,9 +74,8 @@ class OFSchedulingPolicy final : public __SchedulingPolicy<OFSchedulingPolicy>
 
         // Check to make sure ready list had at least one schedulable wave
         panic_if(!selected_wave, "No wave found by OF scheduling policy.\n");
-        sched_list->erase(sched_list->begin() + selected_position);
 
-        return selected_wave;
+        return takeWave(sched_list, selected_position);
     }
 };
 
@@ -184,6 +184,7 @@ void
 RegisterFile::MarkRegFreeScbEvent::process()
 {
     rf->markReg(regIdx, false);
+    rf->computeUnit->wakeup();
 }
 
 // Mark a register as busy in the scoreboard/busy vector
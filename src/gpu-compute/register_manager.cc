@@ -38,6 +38,7 @@
 #include "config/the_gpu_isa.hh"
 #include "debug/GPURename.hh"
 #include "gpu-compute/compute_unit.hh"
+#include "gpu-compute/dynamic_register_manager_policy.hh"
 #include "gpu-compute/scalar_register_file.hh"
 #include "gpu-compute/static_register_manager_policy.hh"
 #include "gpu-compute/vector_register_file.hh"
@@ -50,6 +51,8 @@ RegisterManager::RegisterManager(const RegisterManagerParams *p)
 {
     if (p->policy == "static") {
         policy = new StaticRegisterManagerPolicy();
+    } else if (p->policy == "dynamic") {
+        policy = new DynamicRegisterManagerPolicy();
     } else {
         fatal("Unimplemented Register Manager Policy");
     }
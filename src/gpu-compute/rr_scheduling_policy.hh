@@ -68,9 +68,8 @@ class RRSchedulingPolicy final : public __SchedulingPolicy<RRSchedulingPolicy>
          */
         selected_wave = sched_list->front();
         panic_if(!selected_wave, "No wave found by RR scheduling policy.\n");
-        sched_list->erase(sched_list->begin());
 
-        return selected_wave;
+        return takeWave(sched_list, 0);
     }
 };
 
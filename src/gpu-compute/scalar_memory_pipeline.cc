@@ -91,6 +91,11 @@ ScalarMemPipeline::exec()
 
         m->completeAcc(m);
 
+        if (computeUnit->shader->trace()) {
+            computeUnit->shader->trace()->record(GPUTrace::INST_COMPLETE,
+                                                 w, m->seqNum());
+        }
+
         if (m->isLoad() || m->isAtomic()) {
             returnedLoads.pop();
             assert(inflightLoads > 0);
@@ -147,6 +152,17 @@ ScalarMemPipeline::exec()
     }
 }
 
+void
+ScalarMemPipeline::issueRequest(GPUDynInstPtr gpuDynInst)
+{
+    if (gpuDynInst->wavefront()->functionalMode) {
+        computeUnit->execFunctionalAccess(gpuDynInst);
+        return;
+    }
+
+    issuedRequests.push(gpuDynInst);
+}
+
 void
 ScalarMemPipeline::regStats()
 {
@@ -63,6 +63,12 @@ class ScalarMemPipeline
     void init(ComputeUnit *cu);
     void exec();
 
+    /**
+     * Issues a request to the pipeline (i.e., enqueue it
+     * in the request FIFO).
+     */
+    void issueRequest(GPUDynInstPtr gpuDynInst);
+
     std::queue<GPUDynInstPtr> &getGMReqFIFO() { return issuedRequests; }
     std::queue<GPUDynInstPtr> &getGMStRespFIFO() { return returnedStores; }
     std::queue<GPUDynInstPtr> &getGMLdRespFIFO() { return returnedLoads; }
@@ -85,6 +91,13 @@ class ScalarMemPipeline
         return (issuedRequests.size() + pendReqs) < queueSize;
     }
 
+    bool
+    isQuiescent() const
+    {
+        return issuedRequests.empty() && returnedStores.empty() &&
+            returnedLoads.empty();
+    }
+
     const std::string &name() const { return _name; }
     void regStats();
 
@@ -44,6 +44,7 @@
 #include "gpu-compute/compute_unit.hh"
 #include "gpu-compute/gpu_static_inst.hh"
 #include "gpu-compute/scalar_register_file.hh"
+#include "gpu-compute/shader.hh"
 #include "gpu-compute/vector_register_file.hh"
 #include "gpu-compute/wavefront.hh"
 
@@ -130,7 +131,7 @@ ScheduleStage::exec()
         rdyListNotEmpty[j]++;
 
         // Pick a wave and attempt to add it to schList
-        Wavefront *w = scheduler[j].chooseWave();
+        Wavefront *w = chooseWave(j);
         if (!addToSchList(j, w)) {
             // For waves not added to schList, increment count of cycles
             // this wave spends in SCH stage.
@@ -155,7 +156,7 @@ ScheduleStage::exec()
         rdyListNotEmpty[j]++;
 
         // Pick a wave and attempt to add it to schList
-        Wavefront *w = scheduler[j].chooseWave();
+        Wavefront *w = chooseWave(j);
         if (!addToSchList(j, w)) {
             // For waves not added to schList, increment count of cycles
             // this wave spends in SCH stage.
@@ -194,6 +195,21 @@ ScheduleStage::exec()
     reserveResources();
 }
 
+Wavefront*
+ScheduleStage::chooseWave(int exeType)
+{
+    Wavefront *w = scheduler[exeType].chooseWave();
+
+    if (scheduler[exeType].lastChoiceStalled()) {
+        policyStalls[exeType]++;
+    }
+
+    schedWaveAge += computeUnit->curCycle() - w->startCycle;
+    schedWaves++;
+
+    return w;
+}
+
 void
 ScheduleStage::doDispatchListTransition(int unitId, DISPATCH_STATUS s,
                                         Wavefront *w)
@@ -558,6 +574,12 @@ ScheduleStage::fillDispatchList()
                     if (!dispRdy) {
                         // not ready for dispatch, increment stall stat
                         schIter->first->schResourceStalls++;
+                        if (computeUnit->shader->instProfiler()) {
+                            computeUnit->shader->instProfiler()->stalled(
+                                schIter->first,
+                                schIter->first->instructionBuffer.front(),
+                                GPUInstProfiler::STALL_RESOURCE);
+                        }
                     }
                     // Examine next wave for this resource
                     schIter++;
@@ -744,6 +766,24 @@ ScheduleStage::deleteFromSch(Wavefront *w)
     wavesInSch.erase(w->wfDynId);
 }
 
+bool
+ScheduleStage::isQuiescent() const
+{
+    for (const auto &sch_list : schList) {
+        if (!sch_list.empty()) {
+            return false;
+        }
+    }
+
+    for (const auto &dispatch_entry : *dispatchList) {
+        if (dispatch_entry.second != EMPTY) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
 void
 ScheduleStage::regStats()
 {
@@ -846,4 +886,29 @@ ScheduleStage::regStats()
         .name(name() + ".lds_bus_arb_stalls")
         .desc("number of stalls due to VRF->LDS bus conflicts")
         ;
+
+    policyStalls
+        .init(computeUnit->numExeUnits())
+        .name(name() + ".policy_stalls")
+        .desc("number of cycles the scheduling policy could not pick the "
+              "wave it prefers per execution resource")
+        ;
+
+    schedWaveAge
+        .name(name() + ".sched_wave_age")
+        .desc("total age, in cycles, of the waves picked by the scheduling "
+              "policy")
+        ;
+
+    schedWaves
+        .name(name() + ".sched_waves")
+        .desc("number of waves picked by the scheduling policy")
+        ;
+
+    avgSchedWaveAge
+        .name(name() + ".avg_sched_wave_age")
+        .desc("average age, in cycles, of the waves picked by the "
+              "scheduling policy")
+        ;
+    avgSchedWaveAge = schedWaveAge / schedWaves;
 }
@@ -109,6 +109,9 @@ class ScheduleStage
     // Called by ExecStage to inform SCH of instruction execution
     void deleteFromSch(Wavefront *w);
 
+    // True if no wave is waiting in the schedule or dispatch lists
+    bool isQuiescent() const;
+
     // Schedule List status
     enum SCH_STATUS
     {
@@ -171,8 +174,22 @@ class ScheduleStage
     // to dispatchList
     Stats::Vector dispNrdyStalls;
 
+    // Number of cycles, per execution resource, the scheduling policy
+    // could not pick the wave it prefers (e.g., the greedy wave of GTO or
+    // an active wave of the two-level policy was not ready)
+    Stats::Vector policyStalls;
+
+    // Age, in cycles since the wave started, of the waves picked by the
+    // scheduling policy
+    Stats::Scalar schedWaveAge;
+    Stats::Scalar schedWaves;
+    Stats::Formula avgSchedWaveAge;
+
     std::string _name;
 
+    // called by exec() to pick a wave from the readyList of an execution
+    // resource and update the scheduling policy stats
+    Wavefront *chooseWave(int exeType);
     // called by exec() to add a wave to schList if the RFs can support it
     bool addToSchList(int exeType, Wavefront *w);
     // re-insert a wave to schList if wave lost arbitration
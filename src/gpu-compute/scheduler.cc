@@ -36,8 +36,11 @@
 
 #include "gpu-compute/scheduler.hh"
 
+#include "gpu-compute/gto_scheduling_policy.hh"
+#include "gpu-compute/lrr_scheduling_policy.hh"
 #include "gpu-compute/of_scheduling_policy.hh"
 #include "gpu-compute/rr_scheduling_policy.hh"
+#include "gpu-compute/two_level_scheduling_policy.hh"
 #include "params/ComputeUnit.hh"
 
 Scheduler::Scheduler(const ComputeUnitParams *p)
@@ -46,6 +49,12 @@ Scheduler::Scheduler(const ComputeUnitParams *p)
         schedPolicy = new OFSchedulingPolicy();
     } else if (p->execPolicy == "ROUND-ROBIN") {
         schedPolicy = new RRSchedulingPolicy();
+    } else if (p->execPolicy == "LOOSE-ROUND-ROBIN") {
+        schedPolicy = new LRRSchedulingPolicy();
+    } else if (p->execPolicy == "GREEDY-THEN-OLDEST") {
+        schedPolicy = new GTOSchedulingPolicy();
+    } else if (p->execPolicy == "TWO-LEVEL") {
+        schedPolicy = new TwoLevelSchedulingPolicy(p->twoLevelActiveWaves);
     } else {
         fatal("Unimplemented scheduling policy.\n");
     }
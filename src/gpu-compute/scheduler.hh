@@ -48,12 +48,14 @@ class Scheduler
   public:
     Scheduler(const ComputeUnitParams *params);
     Wavefront *chooseWave();
+    bool lastChoiceStalled() const { return schedPolicy->lastChoiceStalled(); }
     void bindList(std::vector<Wavefront*> *sched_list);
 
   private:
     /**
-     * Scheduling policy. Currently the model can support oldest-first
-     * or round-robin scheduling.
+     * Scheduling policy. Currently the model can support oldest-first,
+     * round-robin, loose round-robin, greedy-then-oldest, or two-level
+     * scheduling.
      */
     SchedulingPolicy *schedPolicy;
     std::vector<Wavefront*> *scheduleList;
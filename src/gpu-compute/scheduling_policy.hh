@@ -47,8 +47,35 @@ class Wavefront;
 class SchedulingPolicy
 {
   public:
-    SchedulingPolicy() { }
+    SchedulingPolicy() : stalled(false) { }
+    virtual ~SchedulingPolicy() { }
     virtual Wavefront *chooseWave(std::vector<Wavefront*> *sched_list) = 0;
+
+    /**
+     * True if the last wave chosen is not the one the policy would have
+     * preferred, e.g., because the greedy wave of GTO, or all of the
+     * active waves of the two-level policy, were not ready.
+     */
+    bool lastChoiceStalled() const { return stalled; }
+
+  protected:
+    bool stalled;
+
+    /**
+     * Remove the wave at the given position from the schedule list and
+     * return it. The ready lists are rebuilt by the SCB stage every
+     * cycle, so their order need not be kept, and we move the last wave
+     * into the hole rather than shifting all the waves after it.
+     */
+    static Wavefront*
+    takeWave(std::vector<Wavefront*> *sched_list, int position)
+    {
+        Wavefront *wave = sched_list->at(position);
+        sched_list->at(position) = sched_list->back();
+        sched_list->pop_back();
+
+        return wave;
+    }
 };
 
 /**
@@ -75,6 +75,41 @@ ScoreboardCheckStage::collectStatistics(nonrdytype_e rdyStatus)
     stallCycles[rdyStatus]++;
 }
 
+// Report why a wave is not ready to the instruction profiler, if any
+void
+ScoreboardCheckStage::profileStall(Wavefront *w, nonrdytype_e rdyStatus)
+{
+    GPUInstProfiler *profiler = computeUnit->shader->instProfiler();
+    if (!profiler) {
+        return;
+    }
+
+    GPUInstProfiler::StallReason reason;
+    switch (rdyStatus) {
+      case NRDY_VGPR_NRDY:
+      case NRDY_SGPR_NRDY:
+        reason = GPUInstProfiler::STALL_DEPENDENCY;
+        break;
+      case NRDY_WAIT_CNT:
+        reason = GPUInstProfiler::STALL_WAITCNT;
+        break;
+      case NRDY_BARRIER_WAIT:
+        reason = GPUInstProfiler::STALL_BARRIER;
+        break;
+      case NRDY_IB_EMPTY:
+        reason = GPUInstProfiler::STALL_FETCH;
+        break;
+      default:
+        // the wave is either ready or not running
+        return;
+    }
+
+    // the instruction the wave is stalled on, if it has been fetched
+    GPUDynInstPtr ii = w->instructionBuffer.empty() ? nullptr :
+        w->nextInstr();
+    profiler->stalled(w, ii, reason);
+}
+
 // Return true if this wavefront is ready
 // to execute an instruction of the specified type.
 // It also returns the reason (in rdyStatus) if the instruction is not
@@ -107,13 +142,18 @@ ScoreboardCheckStage::ready(Wavefront *w, nonrdytype_e *rdyStatus,
     // the last instruction in the instruction buffer.
     if (w->stalledAtBarrier) {
         if (!computeUnit->AllAtBarrier(w->barrierId,w->barrierCnt,
-                        computeUnit->getRefCounter(w->dispatchId, w->wgId))) {
+                        computeUnit->getRefCounter(w->ldsChunk))) {
             // Are all threads at barrier?
             *rdyStatus = NRDY_BARRIER_WAIT;
             return false;
         }
         w->oldBarrierCnt = w->barrierCnt;
         w->stalledAtBarrier = false;
+
+        if (computeUnit->shader->trace()) {
+            computeUnit->shader->trace()->record(GPUTrace::BARRIER_RELEASE,
+                                                 w);
+        }
     }
 
     // Check WF status: it has to be running
@@ -268,6 +308,7 @@ ScoreboardCheckStage::exec()
                 readyList.at(exeResType)->push_back(curWave);
             }
             collectStatistics(rdyStatus);
+            profileStall(curWave, rdyStatus);
         }
     }
 }
@@ -84,6 +84,8 @@ class ScoreboardCheckStage
 
   private:
     void collectStatistics(nonrdytype_e rdyStatus);
+    // attribute the stall of the wave to its next instruction
+    void profileStall(Wavefront *w, nonrdytype_e rdyStatus);
     int mapWaveToExeUnit(Wavefront *w);
     bool ready(Wavefront *w, nonrdytype_e *rdyStatus,
                int *exeResType, int wfSlot);
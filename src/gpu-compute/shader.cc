@@ -39,6 +39,7 @@
 
 #include "arch/x86/linux/linux.hh"
 #include "base/chunk_generator.hh"
+#include "debug/Drain.hh"
 #include "debug/GPUDisp.hh"
 #include "debug/GPUMem.hh"
 #include "debug/GPUShader.hh"
@@ -81,6 +82,15 @@ Shader::Shader(const Params *p) : ClockedObject(p),
 
     shHiddenPrivateBaseVmid = 0;
 
+    if (!p->inst_profile_dir.empty()) {
+        _instProfiler.reset(new GPUInstProfiler(n_cu, p->inst_profile_dir));
+    }
+
+    if (!p->trace_file.empty()) {
+        _trace.reset(new GPUTrace(n_cu, p->trace_file, p->trace_buffer_size,
+                                  clockPeriod()));
+    }
+
     cuList.resize(n_cu);
 
     panic_if(n_wf <= 0, "Must have at least 1 WF Slot per SIMD");
@@ -90,6 +100,8 @@ Shader::Shader(const Params *p) : ClockedObject(p),
         assert(i == cuList[i]->cu_id);
         cuList[i]->shader = this;
         cuList[i]->idleCUTimeout = p->idlecu_timeout;
+        // all WF slots are free initially
+        cusWithFreeWfSlots.insert(i);
     }
 }
 
@@ -179,18 +191,36 @@ Shader::execScheduledAdds()
 {
     assert(!sa_when.empty());
 
+    bool applied_adds = false;
+
     // apply any scheduled adds
     for (int i = 0; i < sa_n; ++i) {
         if (sa_when[i] <= curTick()) {
-            *sa_val[i] += sa_x[i];
-            panic_if(*sa_val[i] < 0, "Negative counter value\n");
+            applied_adds = true;
+            {
+                // the counter belongs to the CU that scheduled the add
+                EventQueue::ScopedNestedMigration enter(sa_eventq[i]);
+                *sa_val[i] += sa_x[i];
+                panic_if(*sa_val[i] < 0, "Negative counter value\n");
+            }
             sa_val.erase(sa_val.begin() + i);
             sa_x.erase(sa_x.begin() + i);
             sa_when.erase(sa_when.begin() + i);
+            sa_eventq.erase(sa_eventq.begin() + i);
             --sa_n;
             --i;
         }
     }
+
+    // the updated counters may unblock waves on CUs that stopped
+    // ticking while waiting on them
+    if (applied_adds) {
+        for (auto cu : cuList) {
+            EventQueue::ScopedNestedMigration enter(cu->eventQueue());
+            cu->wakeup();
+        }
+    }
+
     if (!sa_when.empty()) {
         Tick shader_wakeup = *std::max_element(sa_when.begin(),
                  sa_when.end());
@@ -198,9 +228,25 @@ Shader::execScheduledAdds()
         schedule(tickEvent, shader_wakeup);
     } else {
         DPRINTF(GPUDisp, "sa_when empty, shader going to sleep!\n");
+
+        if (drainState() == DrainState::Draining) {
+            DPRINTF(Drain, "Shader done draining\n");
+            signalDrainDone();
+        }
     }
 }
 
+/**
+ * The scheduled adds update the counters of the waves in flight, so
+ * they must be applied before checkpointing. The shader holds no other
+ * state that outlives a WG.
+ */
+DrainState
+Shader::drain()
+{
+    return sa_n ? DrainState::Draining : DrainState::Drained;
+}
+
 /*
  * dispatcher/shader arranges invalidate requests to the CUs
  */
@@ -224,6 +270,7 @@ Shader::prepareInvalidate(HSAQueueEntry *task) {
 
         _dispatcher.updateInvCounter(kernId, +1);
         // all necessary INV flags are all set now, call cu to execute
+        EventQueue::ScopedNestedMigration enter(cuList[i_cu]->eventQueue());
         cuList[i_cu]->doInvalidate(req, task->dispatchId());
     }
 }
@@ -233,6 +280,7 @@ Shader::prepareInvalidate(HSAQueueEntry *task) {
  */
 void
 Shader::prepareFlush(GPUDynInstPtr gpuDynInst){
+    EventQueue::ScopedMigration migrate(eventQueue());
     int kernId = gpuDynInst->kern_id;
     // flush has never been started, performed only once at kernel end
     assert(_dispatcher.getOutstandingWbs(kernId) == 0);
@@ -241,6 +289,7 @@ Shader::prepareFlush(GPUDynInstPtr gpuDynInst){
     // assuming that L2 cache is shared by all cus in the shader
     int i_cu = 0;
     _dispatcher.updateWbCounter(kernId, +1);
+    EventQueue::ScopedNestedMigration enter(cuList[i_cu]->eventQueue());
     cuList[i_cu]->doFlush(gpuDynInst);
 }
 
@@ -248,24 +297,35 @@ bool
 Shader::dispatchWorkgroups(HSAQueueEntry *task)
 {
     bool scheduledSomething = false;
-    int cuCount = 0;
-    int curCu = nextSchedCu;
+    std::vector<int> cus;
+
+    // only the CUs with a free WF slot can take a WG, they are tried
+    // round robin starting at nextSchedCu. the set is copied as the
+    // dispatched WFs update it
+    {
+        std::lock_guard<std::mutex> lock(cusWithFreeWfSlotsMutex);
+        auto first = cusWithFreeWfSlots.lower_bound(nextSchedCu);
+        cus.insert(cus.end(), first, cusWithFreeWfSlots.end());
+        cus.insert(cus.end(), cusWithFreeWfSlots.begin(), first);
+    }
 
-    while (cuCount < n_cu) {
-        //Every time we try a CU, update nextSchedCu
-        nextSchedCu = (nextSchedCu + 1) % n_cu;
+    for (int curCu : cus) {
+        EventQueue::ScopedNestedMigration enter(cuList[curCu]->eventQueue());
 
-        // dispatch workgroup iff the following two conditions are met:
+        // dispatch workgroup iff the following three conditions are met:
         // (a) wg_rem is true - there are unassigned workgroups in the grid
-        // (b) there are enough free slots in cu cuList[i] for this wg
-        if (!task->dispComplete() && cuList[curCu]->hasDispResources(task)) {
+        // (b) the CU mask of the task's queue includes cu cuList[i]
+        // (c) there are enough free slots in cu cuList[i] for this wg
+        if (!task->dispComplete() && task->cuEnabled(curCu) &&
+            cuList[curCu]->hasDispResources(task)) {
             scheduledSomething = true;
             DPRINTF(GPUDisp, "Dispatching a workgroup to CU %d: WG %d\n",
                             curCu, task->globalWgId());
             DPRINTF(GPUWgLatency, "WG Begin cycle:%d wg:%d cu:%d\n",
                     curTick(), task->globalWgId(), curCu);
 
-            if (!cuList[curCu]->tickEvent.scheduled()) {
+            if (!cuList[curCu]->tickEvent.scheduled() &&
+                !cuList[curCu]->isSleeping()) {
                 if (!_activeCus)
                     _lastInactiveTick = curTick();
                 _activeCus++;
@@ -277,19 +337,30 @@ Shader::dispatchWorkgroups(HSAQueueEntry *task)
 
             task->markWgDispatch();
         }
-
-        ++cuCount;
-        curCu = nextSchedCu;
     }
 
     return scheduledSomething;
 }
 
+void
+Shader::updateFreeWfSlots(int cu_id, bool free_slots)
+{
+    std::lock_guard<std::mutex> lock(cusWithFreeWfSlotsMutex);
+
+    if (free_slots) {
+        cusWithFreeWfSlots.insert(cu_id);
+    } else {
+        cusWithFreeWfSlots.erase(cu_id);
+    }
+}
+
 void
 Shader::regStats()
 {
     ClockedObject::regStats();
 
+    _decodeCache.regStats(name());
+
     shaderActiveTicks
         .name(name() + ".shader_active_ticks")
         .desc("Total ticks that any CU attached to this shader is active")
@@ -312,13 +383,18 @@ Shader::regStats()
         .desc("delay distribution for stores")
         .flags(Stats::pdf | Stats::oneline);
 
+    // the operand counts are kept per CU, so that CUs on different
+    // event queues never update the same stat
+    for (auto cu : cuList) {
+        vectorInstSrcOperand += cu->vectorInstSrcOperand;
+        vectorInstDstOperand += cu->vectorInstDstOperand;
+    }
+
     vectorInstSrcOperand
-        .init(4)
         .name(name() + ".vec_inst_src_operand")
         .desc("vector instruction source operand distribution");
 
     vectorInstDstOperand
-        .init(4)
         .name(name() + ".vec_inst_dst_operand")
         .desc("vector instruction destination operand distribution");
 
@@ -441,10 +517,18 @@ Shader::doFunctionalAccess(RequestPtr req, MemCmd cmd, void *data,
 void
 Shader::ScheduleAdd(int *val,Tick when,int x)
 {
-    sa_val.push_back(val);
+    // the add is timed and applied relative to the caller's queue
+    EventQueue *caller_eq = curEventQueue();
     when += curTick();
+
+    EventQueue::ScopedMigration migrate(eventQueue());
+    // the shader's queue may run up to a quantum behind the caller
+    when = std::max(when, curTick());
+
+    sa_val.push_back(val);
     sa_when.push_back(when);
     sa_x.push_back(x);
+    sa_eventq.push_back(caller_eq);
     ++sa_n;
     if (!tickEvent.scheduled() || (when < tickEvent.when())) {
         DPRINTF(GPUDisp, "New scheduled add; scheduling shader wakeup at "
@@ -534,6 +618,7 @@ Shader::functionalTLBAccess(PacketPtr pkt, int cu_id, BaseTLB::Mode mode)
 void
 Shader::sampleStore(const Tick accessTime)
 {
+    EventQueue::ScopedMigration migrate(eventQueue());
     storeLatencyDist.sample(accessTime);
     allLatencyDist.sample(accessTime);
 }
@@ -544,6 +629,7 @@ Shader::sampleStore(const Tick accessTime)
 void
 Shader::sampleLoad(const Tick accessTime)
 {
+    EventQueue::ScopedMigration migrate(eventQueue());
     loadLatencyDist.sample(accessTime);
     allLatencyDist.sample(accessTime);
 }
@@ -551,6 +637,7 @@ Shader::sampleLoad(const Tick accessTime)
 void
 Shader::sampleInstRoundTrip(std::vector<Tick> roundTripTime)
 {
+    EventQueue::ScopedMigration migrate(eventQueue());
     // Only sample instructions that go all the way to main memory
     if (roundTripTime.size() != InstMemoryHop::InstMemoryHopMax) {
         return;
@@ -571,6 +658,7 @@ Shader::sampleInstRoundTrip(std::vector<Tick> roundTripTime)
 void
 Shader::sampleLineRoundTrip(const std::map<Addr, std::vector<Tick>>& lineMap)
 {
+    EventQueue::ScopedMigration migrate(eventQueue());
     coalsrLineAddresses.sample(lineMap.size());
     std::vector<Tick> netTimes;
 
@@ -599,6 +687,7 @@ Shader::sampleLineRoundTrip(const std::map<Addr, std::vector<Tick>>& lineMap)
 
 void
 Shader::notifyCuSleep() {
+    EventQueue::ScopedMigration migrate(eventQueue());
     // If all CUs attached to his shader are asleep, update shaderActiveTicks
     panic_if(_activeCus <= 0 || _activeCus > cuList.size(),
              "Invalid activeCu size\n");
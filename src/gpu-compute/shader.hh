@@ -36,7 +36,11 @@
 #ifndef __SHADER_HH__
 #define __SHADER_HH__
 
+#include <atomic>
 #include <functional>
+#include <memory>
+#include <mutex>
+#include <set>
 #include <string>
 
 #include "arch/isa.hh"
@@ -48,8 +52,11 @@
 #include "cpu/thread_context.hh"
 #include "cpu/thread_state.hh"
 #include "gpu-compute/compute_unit.hh"
+#include "gpu-compute/gpu_decode_cache.hh"
 #include "gpu-compute/gpu_dyn_inst.hh"
+#include "gpu-compute/gpu_inst_profiler.hh"
 #include "gpu-compute/gpu_tlb.hh"
+#include "gpu-compute/gpu_trace.hh"
 #include "gpu-compute/hsa_queue_entry.hh"
 #include "gpu-compute/lds_state.hh"
 #include "mem/page_table.hh"
@@ -93,6 +100,12 @@ class Shader : public ClockedObject
     ApertureRegister _scratchApe;
     Addr shHiddenPrivateBaseVmid;
 
+    // IDs of the CUs that have a free WF slot, which are the only CUs
+    // WGs can be dispatched to. WFs start and stop on the event queues
+    // of their CUs, so the set is guarded by a mutex
+    std::set<int> cusWithFreeWfSlots;
+    std::mutex cusWithFreeWfSlotsMutex;
+
     // Number of active Cus attached to this shader
     int _activeCus;
 
@@ -119,11 +132,23 @@ class Shader : public ClockedObject
     Stats::Distribution coalsrLineAddresses;
     Stats::Distribution *cacheBlockRoundTrip;
 
+    // decoded instructions shared by the fetch units of all CUs
+    GPUDecodeCache _decodeCache;
+
+    // the per-instruction profiler, if profiling is enabled
+    std::unique_ptr<GPUInstProfiler> _instProfiler;
+
+    // the timeline trace of the wavefronts, if tracing is enabled
+    std::unique_ptr<GPUTrace> _trace;
+
   public:
     typedef ShaderParams Params;
     enum hsail_mode_e {SIMT,VECTOR_SCALAR};
 
     GPUDispatcher &dispatcher();
+    GPUDecodeCache &decodeCache() { return _decodeCache; }
+    GPUInstProfiler *instProfiler() { return _instProfiler.get(); }
+    GPUTrace *trace() { return _trace.get(); }
     void sampleLoad(const Tick accessTime);
     void sampleStore(const Tick accessTime);
     void sampleInstRoundTrip(std::vector<Tick> roundTripTime);
@@ -243,6 +268,8 @@ class Shader : public ClockedObject
     std::vector<uint64_t> sa_when;
     // Amount to increment by
     std::vector<int32_t> sa_x;
+    // Event queue of the object that scheduled the increment
+    std::vector<EventQueue*> sa_eventq;
 
     // List of Compute Units (CU's)
     std::vector<ComputeUnit*> cuList;
@@ -254,16 +281,17 @@ class Shader : public ClockedObject
      * Statistics
      */
     Stats::Scalar shaderActiveTicks;
-    Stats::Vector vectorInstSrcOperand;
-    Stats::Vector vectorInstDstOperand;
+    Stats::Formula vectorInstSrcOperand;
+    Stats::Formula vectorInstDstOperand;
     void regStats();
 
     int max_valu_insts;
-    int total_valu_insts;
+    std::atomic<int> total_valu_insts;
 
     Shader(const Params *p);
     ~Shader();
     virtual void init();
+    DrainState drain() override;
 
     // Run shader scheduled adds
     void execScheduledAdds();
@@ -298,6 +326,11 @@ class Shader : public ClockedObject
     void prepareFlush(GPUDynInstPtr gpuDynInst);
 
     bool dispatchWorkgroups(HSAQueueEntry *task);
+    /**
+     * Called by a CU when its last free WF slot is occupied, or when a
+     * slot is freed while none was free.
+     */
+    void updateFreeWfSlots(int cu_id, bool free_slots);
     Addr mmap(int length);
     void functionalTLBAccess(PacketPtr pkt, int cu_id, BaseTLB::Mode mode);
     void updateContext(int cid);
@@ -112,11 +112,8 @@ TLBCoalescer::canCoalesce(PacketPtr incoming_pkt, PacketPtr coalesced_pkt)
 
     // Rule 1: Coalesce requests only if they
     // fall within the same virtual page
-    Addr incoming_virt_page_addr = roundDown(incoming_pkt->req->getVaddr(),
-                                             TheISA::PageBytes);
-
-    Addr coalesced_virt_page_addr = roundDown(coalesced_pkt->req->getVaddr(),
-                                              TheISA::PageBytes);
+    Addr incoming_virt_page_addr = pageKey(incoming_pkt->req->getVaddr());
+    Addr coalesced_virt_page_addr = pageKey(coalesced_pkt->req->getVaddr());
 
     if (incoming_virt_page_addr != coalesced_virt_page_addr)
         return false;
@@ -139,6 +136,48 @@ TLBCoalescer::canCoalesce(PacketPtr incoming_pkt, PacketPtr coalesced_pkt)
     return true;
 }
 
+Addr
+TLBCoalescer::pageKey(Addr vaddr) const
+{
+    for (auto size = largePageSizes.rbegin(); size != largePageSizes.rend();
+         ++size) {
+        auto large_page = largePages.find(roundDown(vaddr, *size));
+
+        if (large_page != largePages.end() && large_page->second == *size)
+            return large_page->first;
+    }
+
+    return roundDown(vaddr, TheISA::PageBytes);
+}
+
+Addr
+TLBCoalescer::issuedKey(PacketPtr pkt) const
+{
+    /**
+     * the large pages we know of may have changed since pkt was issued,
+     * so look for the table entry pkt leads among all the page sizes
+     */
+    Addr vaddr = pkt->req->getVaddr();
+    Addr key = roundDown(vaddr, TheISA::PageBytes);
+
+    for (auto size = largePageSizes.begin(); size != largePageSizes.end();
+         ++size) {
+        auto issued = issuedTranslationsTable.find(key);
+
+        if (issued != issuedTranslationsTable.end() &&
+            issued->second.front() == pkt) {
+            return key;
+        }
+
+        key = roundDown(vaddr, *size);
+    }
+
+    assert(issuedTranslationsTable.count(key) &&
+           issuedTranslationsTable.at(key).front() == pkt);
+
+    return key;
+}
+
 /*
  * We need to update the physical addresses of all the translation requests
  * that were coalesced into the one that just returned.
@@ -146,7 +185,7 @@ TLBCoalescer::canCoalesce(PacketPtr incoming_pkt, PacketPtr coalesced_pkt)
 void
 TLBCoalescer::updatePhysAddresses(PacketPtr pkt)
 {
-    Addr virt_page_addr = roundDown(pkt->req->getVaddr(), TheISA::PageBytes);
+    Addr virt_page_addr = issuedKey(pkt);
 
     DPRINTF(GPUTLB, "Update phys. addr. for %d coalesced reqs for page %#x\n",
             issuedTranslationsTable[virt_page_addr].size(), virt_page_addr);
@@ -168,12 +207,28 @@ TLBCoalescer::updatePhysAddresses(PacketPtr pkt)
     Addr phys_page_paddr = pkt->req->getPaddr();
     phys_page_paddr &= ~(page_size - 1);
 
+    // later requests to this large page can share its translations
+    if (page_size > TheISA::PageBytes) {
+        largePages[first_entry_vaddr] = page_size;
+        largePageSizes.insert(page_size);
+    }
+
+    // requests coalesced by a large page that has since been remapped
+    // with smaller pages, which need translations of their own
+    std::vector<PacketPtr> uncovered_pkts;
+
     for (int i = 0; i < issuedTranslationsTable[virt_page_addr].size(); ++i) {
         PacketPtr local_pkt = issuedTranslationsTable[virt_page_addr][i];
         TheISA::GpuTLB::TranslationState *sender_state =
             safe_cast<TheISA::GpuTLB::TranslationState*>(
                     local_pkt->senderState);
 
+        if (i && roundDown(local_pkt->req->getVaddr(), page_size) !=
+                 first_entry_vaddr) {
+            uncovered_pkts.push_back(local_pkt);
+            continue;
+        }
+
         // we are sending the packet back, so pop the reqCnt associated
         // with this level in the TLB hiearchy
         if (!sender_state->prefetch)
@@ -199,6 +254,7 @@ TLBCoalescer::updatePhysAddresses(PacketPtr pkt)
             sender_state->tlbEntry =
                 new TheISA::TlbEntry(p->pid(), first_entry_vaddr,
                     first_entry_paddr, false, false);
+            sender_state->tlbEntry->logBytes = tlb_entry->logBytes;
 
             // update the hitLevel for all uncoalesced reqs
             // so that each packet knows where it hit
@@ -227,6 +283,29 @@ TLBCoalescer::updatePhysAddresses(PacketPtr pkt)
 
     if (!cleanupEvent.scheduled())
         schedule(cleanupEvent, curTick());
+
+    if (!uncovered_pkts.empty()) {
+        DPRINTF(GPUTLB, "Page %#x is no longer a large page, reissuing %d "
+                "reqs\n", virt_page_addr, uncovered_pkts.size());
+
+        auto stale_page = largePages.find(virt_page_addr);
+
+        if (stale_page != largePages.end() && stale_page->second != page_size)
+            largePages.erase(stale_page);
+
+        for (auto uncovered_pkt : uncovered_pkts) {
+            TheISA::GpuTLB::TranslationState *sender_state =
+                safe_cast<TheISA::GpuTLB::TranslationState*>(
+                        uncovered_pkt->senderState);
+
+            int64_t tick_index = sender_state->issueTime / coalescingWindow;
+            coalescerFIFO[tick_index].push_back(coalescedReq(1,
+                                                             uncovered_pkt));
+        }
+
+        if (!probeTLBEvent.scheduled())
+            schedule(probeTLBEvent, curTick() + clockPeriod());
+    }
 }
 
 // Receive translation requests, create a coalesced request,
@@ -352,7 +431,7 @@ TLBCoalescer::CpuSidePort::recvFunctional(PacketPtr pkt)
     // print a warning message. This is a temporary caveat of
     // the current simulator where atomic and timing requests can
     // coexist. FIXME remove this check/warning in the future.
-    Addr virt_page_addr = roundDown(pkt->req->getVaddr(), TheISA::PageBytes);
+    Addr virt_page_addr = coalescer->pageKey(pkt->req->getVaddr());
     int map_count = coalescer->issuedTranslationsTable.count(virt_page_addr);
 
     if (map_count) {
@@ -436,12 +515,17 @@ TLBCoalescer::processProbeTLBEvent()
             PacketPtr first_packet = iter->second[vector_index][0];
 
             // compute virtual page address for this request
-            Addr virt_page_addr = roundDown(first_packet->req->getVaddr(),
-                    TheISA::PageBytes);
+            Addr virt_page_addr = pageKey(first_packet->req->getVaddr());
 
             // is there another outstanding request for the same page addr?
+            // The TLB below tracks translations by their 4KB page, so a
+            // request for a large page must also wait for one that was
+            // issued for its 4KB page before we knew of the large page.
             int pending_reqs =
-                issuedTranslationsTable.count(virt_page_addr);
+                issuedTranslationsTable.count(virt_page_addr) +
+                issuedTranslationsTable.count(
+                    roundDown(first_packet->req->getVaddr(),
+                              TheISA::PageBytes));
 
             if (pending_reqs) {
                 DPRINTF(GPUTLB, "Cannot issue - There are pending reqs for "
@@ -483,6 +567,9 @@ TLBCoalescer::processProbeTLBEvent()
                     // we just sent but only at this coalescer level
                     int pkt_cnt = iter->second[vector_index].size();
                     localqueuingCycles += (curTick() * pkt_cnt);
+
+                    if (largePages.count(virt_page_addr))
+                        largePageAccesses++;
                 }
 
                 DPRINTF(GPUTLB, "Successfully sent TLB request for page %#x",
@@ -542,6 +629,11 @@ TLBCoalescer::regStats()
         .desc("Number of coalesced TLB accesses")
         ;
 
+    largePageAccesses
+        .name(name() + ".large_page_accesses")
+        .desc("Number of coalesced TLB accesses to a known large page")
+        ;
+
     queuingCycles
         .name(name() + ".queuing_cycles")
         .desc("Number of cycles spent in queue")
@@ -38,7 +38,9 @@
 
 #include <list>
 #include <queue>
+#include <set>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "arch/generic/tlb.hh"
@@ -118,10 +120,28 @@ class TLBCoalescer : public MemObject
 
     CoalescingTable issuedTranslationsTable;
 
+    /*
+     * The large pages translations have returned for, indexed by their
+     * virtual page address, and the sizes of those pages. Requests that
+     * fall within a known large page are coalesced, and tracked in the
+     * issuedTranslationsTable, by the large page address rather than by
+     * their 4KB page address (see pageKey()), so a single translation
+     * serves all of them.
+     */
+    std::unordered_map<Addr, Addr> largePages;
+    std::set<Addr> largePageSizes;
+
+    // the address coalescing of a request to vaddr is keyed by
+    Addr pageKey(Addr vaddr) const;
+    // the issuedTranslationsTable key of the coalesced request pkt leads
+    Addr issuedKey(PacketPtr pkt) const;
+
     // number of packets the coalescer receives
     Stats::Scalar uncoalescedAccesses;
     // number packets the coalescer send to the TLB
     Stats::Scalar coalescedAccesses;
+    // number of those that were coalesced by a large page
+    Stats::Scalar largePageAccesses;
 
     // Number of cycles the coalesced requests spend waiting in
     // coalescerFIFO. For each packet the coalescer receives we take into
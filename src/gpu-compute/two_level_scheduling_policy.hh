@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __GPU_COMPUTE_TWO_LEVEL_SCHEDULING_POLICY_HH__
+#define __GPU_COMPUTE_TWO_LEVEL_SCHEDULING_POLICY_HH__
+
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+#include "base/logging.hh"
+#include "gpu-compute/scheduling_policy.hh"
+#include "gpu-compute/wavefront.hh"
+
+/**
+ * Two-level scheduling: only the waves in a small active pool are
+ * scheduled, oldest first. Once none of the active waves are ready,
+ * e.g., because they are all waiting on long latency memory operations,
+ * the oldest ready wave of the pending pool (i.e., all the other waves)
+ * is promoted to the active pool, replacing the active wave that was
+ * scheduled least recently.
+ */
+class TwoLevelSchedulingPolicy final : public SchedulingPolicy
+{
+  public:
+    TwoLevelSchedulingPolicy(int active_waves) : maxActiveWaves(active_waves)
+    {
+        fatal_if(maxActiveWaves < 1, "The two-level scheduling policy "
+                 "needs at least one active wave.\n");
+    }
+
+    Wavefront*
+    chooseWave(std::vector<Wavefront*> *sched_list) override
+    {
+        panic_if(!sched_list->size(), "Two-level scheduling policy sched "
+            "list is empty.\n");
+        int selected_position = -1;
+        int oldest_position = -1;
+
+        for (int position = 0; position < sched_list->size(); ++position) {
+            Wavefront *cur_wave = sched_list->at(position);
+
+            if (oldest_position == -1 || cur_wave->wfDynId <
+                sched_list->at(oldest_position)->wfDynId) {
+                oldest_position = position;
+            }
+
+            if (isActive(cur_wave) && (selected_position == -1 ||
+                cur_wave->wfDynId <
+                sched_list->at(selected_position)->wfDynId)) {
+                selected_position = position;
+            }
+        }
+
+        stalled = selected_position == -1;
+
+        if (stalled) {
+            selected_position = oldest_position;
+
+            if (activeWaves.size() == maxActiveWaves) {
+                activeWaves.pop_back();
+            }
+        } else {
+            uint64_t wave_id = sched_list->at(selected_position)->wfDynId;
+            activeWaves.erase(std::find(activeWaves.begin(),
+                                        activeWaves.end(), wave_id));
+        }
+
+        // the active pool is kept in most recently scheduled order
+        activeWaves.push_front(sched_list->at(selected_position)->wfDynId);
+
+        return takeWave(sched_list, selected_position);
+    }
+
+  private:
+    const int maxActiveWaves;
+    // dynamic ids of the active waves, so that a wave slot reused by a
+    // new wave doesn't inherit its place in the pool
+    std::deque<uint64_t> activeWaves;
+
+    bool
+    isActive(const Wavefront *w) const
+    {
+        return std::find(activeWaves.begin(), activeWaves.end(), w->wfDynId)
+            != activeWaves.end();
+    }
+};
+
+#endif // __GPU_COMPUTE_TWO_LEVEL_SCHEDULING_POLICY_HH__
@@ -92,6 +92,12 @@ class VectorRegisterFile : public RegisterFile
     printReg(Wavefront *wf, int regIdx) const
     {
 #ifndef NDEBUG
+        // called for every operand access, skip the lane loop when the
+        // flag is off
+        if (!DTRACE(GPUVRF)) {
+            return;
+        }
+
         const auto &vec_reg_cont = regFile[regIdx];
         auto vgpr = vec_reg_cont.as<TheGpuISA::VecElemU32>();
 
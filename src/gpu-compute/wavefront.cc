@@ -77,6 +77,7 @@ Wavefront::Wavefront(const Params *p)
     scalarOutstandingReqsRdGm = 0;
     scalarOutstandingReqsWrGm = 0;
     lastNonIdleTick = 0;
+    startCycle = Cycles(0);
     barrierCnt = 0;
     oldBarrierCnt = 0;
     stalledAtBarrier = false;
@@ -89,6 +90,7 @@ Wavefront::Wavefront(const Params *p)
 
     pendingFetch = false;
     dropFetch = false;
+    functionalMode = false;
     maxVgprs = 0;
     maxSgprs = 0;
 
@@ -625,6 +627,14 @@ Wavefront::setStatus(status_e newStatus)
             assert(computeUnit->idleWfs >= 0);
         }
     }
+
+    // keep the CU's index of free WF slots up to date
+    if (newStatus == S_STOPPED && status != S_STOPPED) {
+        computeUnit->wfSlotFreed(this);
+    } else if (status == S_STOPPED && newStatus != S_STOPPED) {
+        computeUnit->wfSlotOccupied(this);
+    }
+
     status = newStatus;
 }
 
@@ -633,7 +643,11 @@ Wavefront::start(uint64_t _wf_dyn_id, Addr init_pc)
 {
     wfDynId = _wf_dyn_id;
     _pc = init_pc;
+    kernelCodeAddr = init_pc;
+    startCycle = computeUnit->curCycle();
 
+    assert(status == S_STOPPED);
+    computeUnit->wfSlotOccupied(this);
     status = S_RUNNING;
 
     vecReads.resize(maxVgprs, 0);
@@ -789,6 +803,11 @@ Wavefront::isOldestInstFlatMem()
 bool
 Wavefront::stopFetch()
 {
+    // functionally executed WFs fetch their own instructions
+    if (functionalMode) {
+        return true;
+    }
+
     for (auto it : instructionBuffer) {
         GPUDynInstPtr ii = it;
         if (ii->isReturn() || ii->isBranch() ||
@@ -956,6 +975,18 @@ Wavefront::exec()
             wfDynId, ii->disassemble(), old_pc, ii->seqNum());
 
     ii->execute(ii);
+
+    if (computeUnit->shader->trace()) {
+        GPUTrace *trace = computeUnit->shader->trace();
+        trace->record(GPUTrace::INST_ISSUE, this, ii->seqNum(),
+                      old_pc - kernelCodeAddr);
+        if (ii->isBarrier()) {
+            trace->record(GPUTrace::BARRIER_ARRIVE, this, ii->seqNum());
+        } else if (ii->isEndOfKernel()) {
+            trace->record(GPUTrace::WF_END, this, ii->seqNum());
+        }
+    }
+
     // delete the dynamic instruction from the pipeline map
     computeUnit->deleteFromPipeMap(this);
     // update the instruction stats in the CU
@@ -968,10 +999,13 @@ Wavefront::exec()
     }
     computeUnit->srf[simdId]->waveExecuteInst(this, ii);
 
-    computeUnit->shader->vectorInstSrcOperand[ii->numSrcVecOperands()]++;
-    computeUnit->shader->vectorInstDstOperand[ii->numDstVecOperands()]++;
+    computeUnit->vectorInstSrcOperand[ii->numSrcVecOperands()]++;
+    computeUnit->vectorInstDstOperand[ii->numDstVecOperands()]++;
     computeUnit->numInstrExecuted++;
     numInstrExecuted++;
+    if (computeUnit->shader->instProfiler()) {
+        computeUnit->shader->instProfiler()->issued(ii);
+    }
     computeUnit->instExecPerSimd[simdId]++;
     computeUnit->execRateDist.sample(computeUnit->totalCycles.value() -
                                      computeUnit->lastExecCycle[simdId]);
@@ -1216,6 +1250,66 @@ Wavefront::exec()
     }
 }
 
+void
+Wavefront::execFunctional()
+{
+    assert(functionalMode);
+    assert(status == S_RUNNING);
+    assert(instructionBuffer.empty());
+
+    const Addr old_pc = pc();
+
+    // no instruction is larger than a raw machine instruction, including
+    // its literal constant, if any
+    TheGpuISA::RawMachInst raw_inst = 0;
+    computeUnit->shader->ReadMem(old_pc, &raw_inst, sizeof(raw_inst),
+                                 computeUnit->cu_id);
+
+    GPUStaticInst *static_inst = computeUnit->shader->decodeCache().decode(
+        computeUnit->functionalDecoder, old_pc,
+        reinterpret_cast<TheGpuISA::MachInst>(&raw_inst));
+
+    GPUDynInstPtr ii = GPUDynInst::create(computeUnit, this, static_inst,
+                                          computeUnit->getAndIncSeqNum());
+
+    // instructions expect to be the oldest entry in the instruction buffer
+    instructionBuffer.push_back(ii);
+
+    DPRINTF(GPUExec, "CU%d: WF[%d][%d]: wave[%d] Functionally executing "
+            "inst: %s (pc: %#x)\n", computeUnit->cu_id, simdId, wfSlotId,
+            wfDynId, ii->disassemble(), old_pc);
+
+    // memory instructions complete their accesses before execute()
+    // returns, so a waitcnt never has anything to wait for
+    if (!ii->isWaitcnt()) {
+        reserveResources();
+        ii->execute(ii);
+    }
+
+    outstandingReqs = 0;
+    outstandingReqsWrGm = 0;
+    outstandingReqsWrLm = 0;
+    outstandingReqsRdGm = 0;
+    outstandingReqsRdLm = 0;
+    scalarOutstandingReqsRdGm = 0;
+    scalarOutstandingReqsWrGm = 0;
+    rdLmReqsInPipe = 0;
+    rdGmReqsInPipe = 0;
+    wrLmReqsInPipe = 0;
+    wrGmReqsInPipe = 0;
+    scalarRdGmReqsInPipe = 0;
+    scalarWrGmReqsInPipe = 0;
+
+    computeUnit->numFunctionalInstExecuted++;
+
+    // s_endpgm stops the WF, there is no next instruction to execute
+    if (status != S_STOPPED && pc() == old_pc) {
+        _gpuISA.advancePC(ii);
+    }
+
+    instructionBuffer.clear();
+}
+
 bool
 Wavefront::waitingAtBarrier(int lane)
 {
@@ -90,6 +90,8 @@ class Wavefront : public SimObject
     // HW slot id where the WF is mapped to inside a SIMD unit
     const int wfSlotId;
     int kernId;
+    // address of the first instruction of the kernel
+    Addr kernelCodeAddr;
     // SIMD unit where the WV has been scheduled
     const int simdId;
     // id of the execution unit (or pipeline) where the oldest instruction
@@ -105,8 +107,14 @@ class Wavefront : public SimObject
 
     bool pendingFetch;
     bool dropFetch;
+    // the WF belongs to a kernel that is executed functionally. it is
+    // never fetched or scheduled by the CU pipeline and its instructions
+    // are executed by execFunctional() instead.
+    bool functionalMode;
     // last tick during which all WFs in the CU are not idle
     Tick lastNonIdleTick;
+    // cycle at which the WF was started
+    Cycles startCycle;
 
     // Execution unit resource ID's associated with this WF
     // These are static mappings set at WF slot construction and
@@ -194,6 +202,10 @@ class Wavefront : public SimObject
     // Index into the Scalar Register File's namespace where the WF's registers
     // will live while the WF is executed
     uint32_t startSgprIndex;
+    // The chunks of the register files allocated to the WF by the dynamic
+    // register manager policy, in the order of the WF's registers
+    std::vector<int> vgprChunks;
+    std::vector<int> sgprChunks;
 
     // Old value of destination gpr (for trace)
     std::vector<uint32_t> oldVgpr;
@@ -294,6 +306,12 @@ class Wavefront : public SimObject
     void validateRequestCounters();
     void start(uint64_t _wfDynId, uint64_t _base_ptr);
     void exec();
+    /**
+     * Fetch, decode and execute the instruction at the WF's PC without
+     * modeling the pipeline. Memory accesses complete immediately using
+     * functional accesses.
+     */
+    void execFunctional();
     // called by SCH stage to reserve
     std::vector<int> reserveResources();
     bool stopFetch();
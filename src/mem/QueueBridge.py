@@ -0,0 +1,49 @@
+# Copyright (c) 2026 The gem5 Authors
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+from m5.params import *
+from m5.proxy import *
+from MemObject import MemObject
+
+# A queue bridge is a pass-through object that sits between objects
+# simulated on different event queues. Requests arriving on slave port
+# i are forwarded, unmodified, on master port i from the bridge's own
+# event queue, and responses travel back onto the event queue of the
+# slave side. The bridge adds no latency and no buffering; it only
+# hands packets between simulation threads.
+class QueueBridge(MemObject):
+    type = 'QueueBridge'
+    cxx_header = 'mem/queue_bridge.hh'
+
+    slave = VectorSlavePort("CPU-side ports, paired with master by index")
+    master = VectorMasterPort("Memory-side ports, paired with slave by "
+                              "index")
+
+    cpu_side_eventq_index = Param.UInt32(Parent.eventq_index,
+        "Event queue of the objects connected to the slave ports")
+
+    check_handoffs = Param.Bool(False, "Keep a running hash of all "
+        "packets that cross the bridge so that runs can be compared")
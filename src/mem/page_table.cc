@@ -37,9 +37,11 @@
  */
 #include "mem/page_table.hh"
 
+#include <algorithm>
 #include <string>
 
 #include "base/compiler.hh"
+#include "base/intmath.hh"
 #include "base/trace.hh"
 #include "debug/MMU.hh"
 #include "sim/faults.hh"
@@ -54,6 +56,8 @@ EmulationPageTable::map(Addr vaddr, Addr paddr, int64_t size, uint64_t flags)
 
     DPRINTF(MMU, "Allocating Page: %#x-%#x\n", vaddr, vaddr + size);
 
+    updateLargePages(vaddr, paddr, size, true);
+
     while (size > 0) {
         auto it = pTable.find(vaddr);
         if (it != pTable.end()) {
@@ -81,6 +85,10 @@ EmulationPageTable::remap(Addr vaddr, int64_t size, Addr new_vaddr)
     DPRINTF(MMU, "moving pages from vaddr %08p to %08p, size = %d\n", vaddr,
             new_vaddr, size);
 
+    // the moved pages are only remapped as base pages
+    updateLargePages(vaddr, 0, size, false);
+    updateLargePages(new_vaddr, 0, size, false);
+
     while (size > 0) {
         auto new_it M5_VAR_USED = pTable.find(new_vaddr);
         auto old_it = pTable.find(vaddr);
@@ -108,6 +116,8 @@ EmulationPageTable::unmap(Addr vaddr, int64_t size)
 
     DPRINTF(MMU, "Unmapping page: %#x-%#x\n", vaddr, vaddr + size);
 
+    updateLargePages(vaddr, 0, size, false);
+
     while (size > 0) {
         auto it = pTable.find(vaddr);
         assert(it != pTable.end());
@@ -130,6 +140,62 @@ EmulationPageTable::isUnmapped(Addr vaddr, int64_t size)
     return true;
 }
 
+void
+EmulationPageTable::addLargePageSize(Addr size)
+{
+    assert(isPowerOf2(size) && size > pageSize);
+
+    if (std::find(_largePageSizes.begin(), _largePageSizes.end(), size) !=
+        _largePageSizes.end()) {
+        return;
+    }
+
+    auto pos = std::upper_bound(_largePageSizes.begin(),
+                                _largePageSizes.end(), size);
+    largePages.emplace(largePages.begin() + (pos - _largePageSizes.begin()));
+    _largePageSizes.insert(pos, size);
+}
+
+void
+EmulationPageTable::updateLargePages(Addr vaddr, Addr paddr, int64_t size,
+                                     bool mapped)
+{
+    for (int i = 0; i < _largePageSizes.size(); ++i) {
+        Addr large_size = _largePageSizes[i];
+
+        // any large page we overlap is no longer mapped as a whole
+        for (Addr page = roundDown(vaddr, large_size); page < vaddr + size;
+             page += large_size) {
+            largePages[i].erase(page);
+        }
+
+        // unless it is now entirely mapped to an aligned physical region
+        if (mapped && (vaddr & (large_size - 1)) ==
+                      (paddr & (large_size - 1))) {
+            for (Addr page = roundUp(vaddr, large_size);
+                 page + large_size <= vaddr + size; page += large_size) {
+                DPRINTF(MMU, "Large page (%#x): %#x-%#x\n", large_size,
+                        page, page + large_size);
+                largePages[i].insert(page);
+            }
+        }
+    }
+}
+
+Addr
+EmulationPageTable::mappedPageSize(Addr vaddr) const
+{
+    for (int i = _largePageSizes.size() - 1; i >= 0; --i) {
+        Addr large_size = _largePageSizes[i];
+
+        if (largePages[i].count(roundDown(vaddr, large_size))) {
+            return large_size;
+        }
+    }
+
+    return pageSize;
+}
+
 const EmulationPageTable::Entry *
 EmulationPageTable::lookup(Addr vaddr)
 {
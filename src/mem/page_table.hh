@@ -39,6 +39,8 @@
 
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 #include "base/intmath.hh"
 #include "base/types.hh"
@@ -70,6 +72,20 @@ class EmulationPageTable : public Serializable
     const uint64_t _pid;
     const std::string _name;
 
+    /**
+     * The large page sizes, in ascending order, for which we track the
+     * virtual pages that can be mapped as a single large page, along with
+     * the start address of each such page (see mappedPageSize()).
+     */
+    std::vector<Addr> _largePageSizes;
+    std::vector<std::unordered_set<Addr>> largePages;
+
+    /**
+     * Update the large pages that overlap the region vaddr to vaddr + size
+     * after it has been (re)mapped to paddr, or unmapped if mapped is false.
+     */
+    void updateLargePages(Addr vaddr, Addr paddr, int64_t size, bool mapped);
+
   public:
 
     EmulationPageTable(
@@ -128,6 +144,26 @@ class EmulationPageTable : public Serializable
      */
     virtual bool isUnmapped(Addr vaddr, int64_t size);
 
+    /**
+     * Track which regions of size bytes may be mapped with a single large
+     * page of that size.
+     * @param size The large page size, a power of 2 multiple of the base
+     *             page size.
+     */
+    void addLargePageSize(Addr size);
+
+    const std::vector<Addr> &largePageSizes() const { return _largePageSizes; }
+
+    /**
+     * The size of the largest page vaddr may be mapped with. This is a
+     * large page size if the large-page-aligned region around vaddr was
+     * mapped as a whole to a physical region with the same alignment, and
+     * the base page size otherwise.
+     * @param vaddr The virtual address.
+     * @return The page size in bytes.
+     */
+    Addr mappedPageSize(Addr vaddr) const;
+
     /**
      * Lookup function
      * @param vaddr The virtual address.
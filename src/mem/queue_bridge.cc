@@ -0,0 +1,204 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/queue_bridge.hh"
+
+#include "base/logging.hh"
+
+QueueBridge::QueueBridge(const QueueBridgeParams *p)
+    : MemObject(p), cpuSideQueue(getEventQueue(p->cpu_side_eventq_index)),
+      checkHandoffs(p->check_handoffs), handoffHash(0)
+{
+    fatal_if(p->port_master_connection_count !=
+             p->port_slave_connection_count,
+             "%s: every slave port needs a matching master port\n", name());
+
+    for (int i = 0; i < p->port_master_connection_count; ++i) {
+        masterPorts.push_back(new BridgeMasterPort(
+            csprintf("%s.master%d", name(), i), *this, i));
+        slavePorts.push_back(new BridgeSlavePort(
+            csprintf("%s.slave%d", name(), i), *this, i));
+    }
+}
+
+BaseMasterPort&
+QueueBridge::getMasterPort(const std::string &if_name, PortID idx)
+{
+    if (if_name == "master" && idx < masterPorts.size()) {
+        return *masterPorts[idx];
+    } else {
+        return MemObject::getMasterPort(if_name, idx);
+    }
+}
+
+BaseSlavePort&
+QueueBridge::getSlavePort(const std::string &if_name, PortID idx)
+{
+    if (if_name == "slave" && idx < slavePorts.size()) {
+        return *slavePorts[idx];
+    } else {
+        return MemObject::getSlavePort(if_name, idx);
+    }
+}
+
+void
+QueueBridge::init()
+{
+    for (int i = 0; i < slavePorts.size(); ++i) {
+        fatal_if(!slavePorts[i]->isConnected() ||
+                 !masterPorts[i]->isConnected(),
+                 "%s: port pair %d is not connected on both sides\n",
+                 name(), i);
+        slavePorts[i]->sendRangeChange();
+    }
+}
+
+void
+QueueBridge::recordHandoff(Addr addr, int cmd, Direction dir)
+{
+    if (!checkHandoffs)
+        return;
+
+    // FNV-1a over the fields that identify a crossing
+    const uint64_t fields[] = { curTick(), addr, (uint64_t)cmd,
+                                (uint64_t)dir };
+    for (auto field : fields) {
+        for (int byte = 0; byte < sizeof(field); ++byte) {
+            handoffHash ^= (field >> (8 * byte)) & 0xff;
+            handoffHash *= 16777619;
+        }
+    }
+    handoffHashStat = handoffHash;
+}
+
+bool
+QueueBridge::BridgeSlavePort::recvTimingReq(PacketPtr pkt)
+{
+    EventQueue::ScopedMigration migrate(bridge.eventQueue());
+    bool accepted = bridge.masterPorts[id]->sendTimingReq(pkt);
+    if (accepted) {
+        bridge.recordHandoff(pkt->getAddr(), pkt->cmdToIndex(), ReqCross);
+        ++bridge.reqHandoffs;
+    }
+    return accepted;
+}
+
+void
+QueueBridge::BridgeSlavePort::recvRespRetry()
+{
+    EventQueue::ScopedMigration migrate(bridge.eventQueue());
+    bridge.masterPorts[id]->sendRetryResp();
+}
+
+Tick
+QueueBridge::BridgeSlavePort::recvAtomic(PacketPtr pkt)
+{
+    EventQueue::ScopedMigration migrate(bridge.eventQueue());
+    return bridge.masterPorts[id]->sendAtomic(pkt);
+}
+
+void
+QueueBridge::BridgeSlavePort::recvFunctional(PacketPtr pkt)
+{
+    EventQueue::ScopedMigration migrate(bridge.eventQueue());
+    bridge.masterPorts[id]->sendFunctional(pkt);
+}
+
+AddrRangeList
+QueueBridge::BridgeSlavePort::getAddrRanges() const
+{
+    return bridge.masterPorts[id]->getAddrRanges();
+}
+
+bool
+QueueBridge::BridgeMasterPort::recvTimingResp(PacketPtr pkt)
+{
+    // the packet may be consumed by the receiver, record it first
+    Addr addr = pkt->getAddr();
+    int cmd = pkt->cmdToIndex();
+
+    bool accepted;
+    {
+        EventQueue::ScopedNestedMigration enter(bridge.cpuSideQueue);
+        accepted = bridge.slavePorts[id]->sendTimingResp(pkt);
+    }
+
+    if (accepted) {
+        bridge.recordHandoff(addr, cmd, RespCross);
+        ++bridge.respHandoffs;
+    }
+    return accepted;
+}
+
+void
+QueueBridge::BridgeMasterPort::recvReqRetry()
+{
+    EventQueue::ScopedNestedMigration enter(bridge.cpuSideQueue);
+    bridge.slavePorts[id]->sendRetryReq();
+}
+
+void
+QueueBridge::BridgeMasterPort::recvFunctionalSnoop(PacketPtr pkt)
+{
+    EventQueue::ScopedNestedMigration enter(bridge.cpuSideQueue);
+    bridge.slavePorts[id]->sendFunctionalSnoop(pkt);
+}
+
+void
+QueueBridge::BridgeMasterPort::recvRangeChange()
+{
+    bridge.slavePorts[id]->sendRangeChange();
+}
+
+void
+QueueBridge::regStats()
+{
+    MemObject::regStats();
+
+    reqHandoffs
+        .name(name() + ".req_handoffs")
+        .desc("Number of requests handed to the memory-side queue")
+        ;
+
+    respHandoffs
+        .name(name() + ".resp_handoffs")
+        .desc("Number of responses handed to the CPU-side queue")
+        ;
+
+    handoffHashStat
+        .name(name() + ".handoff_hash")
+        .desc("Running hash of all packets that crossed the bridge "
+              "(only kept when check_handoffs is set)")
+        ;
+}
+
+QueueBridge*
+QueueBridgeParams::create()
+{
+    return new QueueBridge(this);
+}
@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __MEM_QUEUE_BRIDGE_HH__
+#define __MEM_QUEUE_BRIDGE_HH__
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "base/statistics.hh"
+#include "mem/mem_object.hh"
+#include "params/QueueBridge.hh"
+#include "sim/eventq.hh"
+
+/**
+ * A queue bridge connects objects that are simulated on different
+ * event queues, e.g., a GPU compute unit on its own simulation thread
+ * and the memory system it talks to. Slave port i is paired with
+ * master port i. The bridge itself lives on the memory-side queue:
+ * requests migrate onto that queue before they are forwarded, and
+ * responses are delivered with the memory-side queue still held while
+ * the slave-side queue is entered (see
+ * EventQueue::ScopedNestedMigration), so the memory-side queue is
+ * always locked first.
+ *
+ * Packets cross the bridge without delay or buffering. When the
+ * handoff check is enabled a running hash of every crossing (tick,
+ * address, command and direction) is kept as a statistic, which makes
+ * it easy to tell whether two runs saw the same sequence of traffic.
+ */
+class QueueBridge : public MemObject
+{
+  public:
+    QueueBridge(const QueueBridgeParams *p);
+
+    BaseMasterPort &getMasterPort(const std::string &if_name,
+                                  PortID idx=InvalidPortID) override;
+    BaseSlavePort &getSlavePort(const std::string &if_name,
+                                PortID idx=InvalidPortID) override;
+
+    void init() override;
+    void regStats() override;
+
+  protected:
+    class BridgeMasterPort : public MasterPort
+    {
+      public:
+        BridgeMasterPort(const std::string &_name, QueueBridge &_bridge,
+                         PortID _index)
+            : MasterPort(_name, &_bridge, _index), bridge(_bridge)
+        { }
+
+      protected:
+        bool recvTimingResp(PacketPtr pkt) override;
+        void recvReqRetry() override;
+        void recvFunctionalSnoop(PacketPtr pkt) override;
+        void recvRangeChange() override;
+
+      private:
+        QueueBridge &bridge;
+    };
+
+    class BridgeSlavePort : public SlavePort
+    {
+      public:
+        BridgeSlavePort(const std::string &_name, QueueBridge &_bridge,
+                        PortID _index)
+            : SlavePort(_name, &_bridge, _index), bridge(_bridge)
+        { }
+
+      protected:
+        bool recvTimingReq(PacketPtr pkt) override;
+        void recvRespRetry() override;
+        Tick recvAtomic(PacketPtr pkt) override;
+        void recvFunctional(PacketPtr pkt) override;
+        AddrRangeList getAddrRanges() const override;
+
+      private:
+        QueueBridge &bridge;
+    };
+
+    enum Direction
+    {
+        ReqCross,
+        RespCross
+    };
+
+    // fold one crossing into the handoff hash
+    void recordHandoff(Addr addr, int cmd, Direction dir);
+
+    // event queue of the objects connected to the slave ports
+    EventQueue *cpuSideQueue;
+
+    std::vector<BridgeMasterPort*> masterPorts;
+    std::vector<BridgeSlavePort*> slavePorts;
+
+    bool checkHandoffs;
+    uint32_t handoffHash;
+
+    Stats::Scalar reqHandoffs;
+    Stats::Scalar respHandoffs;
+    Stats::Scalar handoffHashStat;
+};
+
+#endif // __MEM_QUEUE_BRIDGE_HH__
@@ -30,6 +30,17 @@
 
 using namespace std;
 
+Consumer::~Consumer()
+{
+    // events still scheduled when the simulation ends are left to the
+    // event queue, as the auto-deleted events they replace were
+    for (auto evt : m_events) {
+        if (!evt->scheduled()) {
+            delete evt;
+        }
+    }
+}
+
 void
 Consumer::scheduleEvent(Cycles timeDelta)
 {
@@ -41,15 +52,22 @@ Consumer::scheduleEventAbsolute(Tick evt_time)
 {
     if (!alreadyScheduled(evt_time)) {
         // This wakeup is not redundant
-        auto *evt = new EventFunctionWrapper(
-            [this]{ wakeup(); }, "Consumer Event", true);
+        WakeupEvent *evt;
+
+        if (m_free_events.empty()) {
+            evt = new WakeupEvent(this);
+            m_events.push_back(evt);
+        } else {
+            evt = m_free_events.back();
+            m_free_events.pop_back();
+        }
 
         em->schedule(evt, evt_time);
         insertScheduledWakeupTime(evt_time);
     }
 
     Tick t = em->clockEdge();
-    set<Tick>::iterator bit = m_scheduled_wakeups.begin();
-    set<Tick>::iterator eit = m_scheduled_wakeups.lower_bound(t);
-    m_scheduled_wakeups.erase(bit,eit);
+    m_scheduled_wakeups.erase(m_scheduled_wakeups.begin(),
+        lower_bound(m_scheduled_wakeups.begin(), m_scheduled_wakeups.end(),
+                    t));
 }
@@ -35,8 +35,9 @@
 #ifndef __MEM_RUBY_COMMON_CONSUMER_HH__
 #define __MEM_RUBY_COMMON_CONSUMER_HH__
 
+#include <algorithm>
 #include <iostream>
-#include <set>
+#include <vector>
 
 #include "sim/clocked_object.hh"
 
@@ -48,9 +49,7 @@ class Consumer
     {
     }
 
-    virtual
-    ~Consumer()
-    { }
+    virtual ~Consumer();
 
     virtual void wakeup() = 0;
     virtual void print(std::ostream& out) const = 0;
@@ -59,13 +58,18 @@ class Consumer
     bool
     alreadyScheduled(Tick time)
     {
-        return m_scheduled_wakeups.find(time) != m_scheduled_wakeups.end();
+        return std::binary_search(m_scheduled_wakeups.begin(),
+                                  m_scheduled_wakeups.end(), time);
     }
 
     void
     insertScheduledWakeupTime(Tick time)
     {
-        m_scheduled_wakeups.insert(time);
+        auto it = std::lower_bound(m_scheduled_wakeups.begin(),
+                                   m_scheduled_wakeups.end(), time);
+        if (it == m_scheduled_wakeups.end() || *it != time) {
+            m_scheduled_wakeups.insert(it, time);
+        }
     }
 
     void scheduleEventAbsolute(Tick timeAbs);
@@ -74,7 +78,35 @@ class Consumer
     void scheduleEvent(Cycles timeDelta);
 
   private:
-    std::set<Tick> m_scheduled_wakeups;
+    /**
+     * A wakeup of the consumer. Each pending wakeup time has its own
+     * event, so wakeups are ordered with other events at the same tick
+     * as they were scheduled, and fired events are kept to be reused
+     * rather than deleted.
+     */
+    class WakeupEvent : public Event
+    {
+      public:
+        WakeupEvent(Consumer *_consumer) : consumer(_consumer) { }
+
+        void
+        process() override
+        {
+            consumer->m_free_events.push_back(this);
+            consumer->wakeup();
+        }
+
+        const char *description() const override { return "Consumer Event"; }
+
+      private:
+        Consumer *consumer;
+    };
+
+    // the pending wakeup times, sorted, as there are only a few
+    std::vector<Tick> m_scheduled_wakeups;
+    // all wakeup events of the consumer, and those not scheduled
+    std::vector<WakeupEvent*> m_events;
+    std::vector<WakeupEvent*> m_free_events;
     ClockedObject *em;
 };
 
@@ -32,23 +32,61 @@
 #include "mem/ruby/system/RubySystem.hh"
 
 DataBlock::DataBlock(const DataBlock &cp)
+    : m_shared(NULL)
 {
-    m_data = new uint8_t[RubySystem::getBlockSizeBytes()];
-    memcpy(m_data, cp.m_data, RubySystem::getBlockSizeBytes());
-    m_alloc = true;
+    if (cp.m_shared) {
+        share(cp);
+    } else {
+        allocStorage();
+        memcpy(m_data, cp.m_data, RubySystem::getBlockSizeBytes());
+    }
 }
 
 void
 DataBlock::alloc()
 {
-    m_data = new uint8_t[RubySystem::getBlockSizeBytes()];
-    m_alloc = true;
+    allocStorage();
     clear();
 }
 
+void
+DataBlock::allocStorage()
+{
+    int size = RubySystem::getBlockSizeBytes();
+    if (size <= RUBY_BLOCK_INLINE_BYTES) {
+        m_data = m_inline;
+    } else {
+        m_shared = new SharedData(size);
+        m_data = m_shared->data;
+    }
+    m_alloc = true;
+}
+
+void
+DataBlock::share(const DataBlock &obj)
+{
+    assert(obj.m_shared);
+    m_shared = obj.m_shared;
+    m_shared->refs++;
+    m_data = m_shared->data;
+    m_alloc = true;
+}
+
+void
+DataBlock::unshare()
+{
+    int size = RubySystem::getBlockSizeBytes();
+    SharedData *copy = new SharedData(size);
+    memcpy(copy->data, m_data, size);
+    m_shared->refs--;
+    m_shared = copy;
+    m_data = copy->data;
+}
+
 void
 DataBlock::clear()
 {
+    makeWritable();
     memset(m_data, 0, RubySystem::getBlockSizeBytes());
 }
 
@@ -61,6 +99,7 @@ DataBlock::equal(const DataBlock& obj) const
 void
 DataBlock::copyPartial(const DataBlock &dblk, const WriteMask &mask)
 {
+    makeWritable();
     for (int i = 0; i < RubySystem::getBlockSizeBytes(); i++) {
         if (mask.getMask(i, 1)) {
             m_data[i] = dblk.m_data[i];
@@ -71,6 +110,7 @@ DataBlock::copyPartial(const DataBlock &dblk, const WriteMask &mask)
 void
 DataBlock::atomicPartial(const DataBlock &dblk, const WriteMask &mask)
 {
+    makeWritable();
     for (int i = 0; i < RubySystem::getBlockSizeBytes(); i++) {
         m_data[i] = dblk.m_data[i];
     }
@@ -101,18 +141,30 @@ DataBlock::getData(int offset, int len) const
 uint8_t*
 DataBlock::getDataMod(int offset)
 {
+    makeWritable();
     return &m_data[offset];
 }
 
 void
 DataBlock::setData(const uint8_t *data, int offset, int len)
 {
+    makeWritable();
     memcpy(&m_data[offset], data, len);
 }
 
 DataBlock &
 DataBlock::operator=(const DataBlock & obj)
 {
-    memcpy(m_data, obj.m_data, RubySystem::getBlockSizeBytes());
+    if (this == &obj)
+        return *this;
+
+    if (m_shared && obj.m_shared) {
+        // Both blocks live on the heap, so just share obj's buffer
+        release();
+        share(obj);
+    } else {
+        makeWritable();
+        memcpy(m_data, obj.m_data, RubySystem::getBlockSizeBytes());
+    }
     return *this;
 }
@@ -35,12 +35,23 @@
 #include <iomanip>
 #include <iostream>
 
+#include "config/ruby_block_inline_bytes.hh"
+
 class WriteMask;
 
+/**
+ * A cache block's worth of data. Blocks that fit in
+ * RUBY_BLOCK_INLINE_BYTES (a build option, 64 by default) are stored
+ * inline so that constructing and copying the messages, TBEs and
+ * cache entries that carry them does not touch the heap. Larger
+ * blocks fall back to a heap buffer that copies share until one of
+ * them writes to it.
+ */
 class DataBlock
 {
   public:
     DataBlock()
+        : m_shared(NULL)
     {
         alloc();
     }
@@ -49,8 +60,7 @@ class DataBlock
 
     ~DataBlock()
     {
-        if (m_alloc)
-            delete [] m_data;
+        release();
     }
 
     DataBlock& operator=(const DataBlock& obj);
@@ -70,18 +80,53 @@ class DataBlock
     void print(std::ostream& out) const;
 
   private:
+    static_assert(RUBY_BLOCK_INLINE_BYTES > 0,
+                  "RUBY_BLOCK_INLINE_BYTES must be positive");
+
+    /** Heap storage shared by copies of a block too large to inline. */
+    struct SharedData
+    {
+        SharedData(int size) : refs(1), data(new uint8_t[size]) {}
+        ~SharedData() { delete [] data; }
+
+        int refs;
+        uint8_t *data;
+    };
+
     void alloc();
+    void allocStorage();
+    void share(const DataBlock &obj);
+    void unshare();
+
+    void
+    release()
+    {
+        if (m_shared && --m_shared->refs == 0)
+            delete m_shared;
+        m_shared = NULL;
+    }
+
+    /** Give this block a private copy of its data before a write. */
+    void
+    makeWritable()
+    {
+        if (m_shared && m_shared->refs > 1)
+            unshare();
+    }
+
     uint8_t *m_data;
+    // Non-NULL when m_data is a (possibly shared) heap buffer
+    SharedData *m_shared;
+    // False when m_data is external storage handed to assign()
     bool m_alloc;
+    uint8_t m_inline[RUBY_BLOCK_INLINE_BYTES];
 };
 
 inline void
 DataBlock::assign(uint8_t *data)
 {
     assert(data != NULL);
-    if (m_alloc) {
-        delete [] m_data;
-    }
+    release();
     m_data = data;
     m_alloc = false;
 }
@@ -95,6 +140,7 @@ DataBlock::getByte(int whichByte) const
 inline void
 DataBlock::setByte(int whichByte, uint8_t data)
 {
+    makeWritable();
     m_data[whichByte] = data;
 }
 
@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include "mem/ruby/common/DataBlock.hh"
+#include "mem/ruby/common/WriteMask.hh"
+#include "mem/ruby/system/RubySystem.hh"
+
+// Use a block too large for inline storage so that DataBlock falls
+// back to shared heap buffers.
+uint32_t RubySystem::m_block_size_bytes = 4 * RUBY_BLOCK_INLINE_BYTES;
+
+namespace {
+
+const int blockSize = 4 * RUBY_BLOCK_INLINE_BYTES;
+
+const uint8_t *
+storage(const DataBlock &blk)
+{
+    return blk.getData(0, blockSize);
+}
+
+void
+fill(DataBlock &blk, uint8_t seed)
+{
+    for (int i = 0; i < blockSize; i++)
+        blk.setByte(i, seed + i);
+}
+
+} // anonymous namespace
+
+TEST(DataBlockCowTest, CopiesShareUntilWritten)
+{
+    DataBlock a;
+    fill(a, 1);
+
+    DataBlock b(a);
+    DataBlock c(b);
+    EXPECT_EQ(storage(a), storage(b));
+    EXPECT_EQ(storage(a), storage(c));
+
+    b.setByte(0, 0xff);
+    EXPECT_NE(storage(a), storage(b));
+    EXPECT_EQ(storage(a), storage(c));
+    EXPECT_EQ(1, a.getByte(0));
+    EXPECT_EQ(1, c.getByte(0));
+    EXPECT_EQ(0xff, b.getByte(0));
+
+    // The last holder of a buffer writes to it in place
+    const uint8_t *old = storage(b);
+    b.setByte(1, 0xfe);
+    EXPECT_EQ(old, storage(b));
+}
+
+TEST(DataBlockCowTest, AssignmentShares)
+{
+    DataBlock a, b;
+    fill(a, 5);
+    b = a;
+    EXPECT_EQ(storage(a), storage(b));
+    EXPECT_TRUE(a == b);
+
+    DataBlock &alias = b;
+    b = alias;
+    EXPECT_EQ(storage(a), storage(b));
+
+    a.clear();
+    EXPECT_NE(storage(a), storage(b));
+    EXPECT_EQ(0, a.getByte(1));
+    EXPECT_EQ(6, b.getByte(1));
+}
+
+TEST(DataBlockCowTest, WritersUnshare)
+{
+    DataBlock a;
+    fill(a, 9);
+
+    DataBlock b(a);
+    *b.getDataMod(2) = 0;
+    EXPECT_EQ(11, a.getByte(2));
+
+    DataBlock c(a);
+    uint8_t byte = 0;
+    c.setData(&byte, 3, 1);
+    EXPECT_EQ(12, a.getByte(3));
+
+    // Copying part of a block over a block it shares storage with
+    DataBlock d(a);
+    d.copyPartial(b, 0, blockSize);
+    EXPECT_TRUE(d == b);
+    EXPECT_EQ(11, a.getByte(2));
+
+    WriteMask mask;
+    mask.setMask(0, 4);
+    DataBlock e(a);
+    e.copyPartial(b, mask);
+    EXPECT_EQ(0, e.getByte(2));
+    EXPECT_EQ(11, a.getByte(2));
+}
+
+TEST(DataBlockCowTest, AssignedStorageIsNotShared)
+{
+    uint8_t backing[blockSize];
+    DataBlock a;
+    fill(a, 2);
+
+    DataBlock b;
+    b.assign(backing);
+    b = a;
+    EXPECT_EQ(backing, storage(b));
+    EXPECT_EQ(2, backing[0]);
+
+    DataBlock c(b);
+    EXPECT_NE(backing, storage(c));
+    DataBlock d(c);
+    EXPECT_EQ(storage(c), storage(d));
+}
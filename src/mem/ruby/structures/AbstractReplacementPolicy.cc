@@ -37,12 +37,12 @@ AbstractReplacementPolicy::AbstractReplacementPolicy(const Params * p)
 {
     m_num_sets = p->size/p->block_size/p->assoc;
     m_assoc = p->assoc;
+    // Keep every set's timestamps in one block, laid out in the same
+    // set-major order as the cache's tags and entries
     m_last_ref_ptr = new Tick*[m_num_sets];
+    Tick *last_refs = new Tick[m_num_sets * m_assoc]();
     for (unsigned i = 0; i < m_num_sets; i++){
-        m_last_ref_ptr[i] = new Tick[m_assoc];
-        for (unsigned j = 0; j < m_assoc; j++){
-            m_last_ref_ptr[i][j] = 0;
-        }
+        m_last_ref_ptr[i] = &last_refs[i * m_assoc];
     }
 }
 
@@ -58,11 +58,8 @@ ReplacementPolicyParams::create()
 AbstractReplacementPolicy::~AbstractReplacementPolicy()
 {
     if (m_last_ref_ptr != NULL){
-        for (unsigned i = 0; i < m_num_sets; i++){
-            if (m_last_ref_ptr[i] != NULL){
-                delete[] m_last_ref_ptr[i];
-            }
-        }
+        if (m_num_sets > 0)
+            delete[] m_last_ref_ptr[0];
         delete[] m_last_ref_ptr;
     }
 }
@@ -31,7 +31,6 @@
 #define __MEM_RUBY_STRUCTURES_CACHEMEMORY_HH__
 
 #include <string>
-#include <unordered_map>
 #include <vector>
 
 #include "base/statistics.hh"
@@ -43,6 +42,7 @@
 #include "mem/ruby/slicc_interface/RubySlicc_ComponentMapping.hh"
 #include "mem/ruby/structures/AbstractReplacementPolicy.hh"
 #include "mem/ruby/structures/BankedArray.hh"
+#include "mem/ruby/structures/SetTagArray.hh"
 #include "mem/ruby/system/CacheRecorder.hh"
 #include "params/RubyCache.hh"
 #include "sim/sim_object.hh"
@@ -160,6 +160,18 @@ class CacheMemory : public SimObject
     int findTagInSet(int64_t line, Addr tag) const;
     int findTagInSetIgnorePermissions(int64_t cacheSet, Addr tag) const;
 
+    AbstractCacheEntry *&
+    entryAt(int64_t cacheSet, int loc)
+    {
+        return m_cache[cacheSet * m_cache_assoc + loc];
+    }
+
+    AbstractCacheEntry *
+    entryAt(int64_t cacheSet, int loc) const
+    {
+        return m_cache[cacheSet * m_cache_assoc + loc];
+    }
+
     // Private copy constructor and assignment operator
     CacheMemory(const CacheMemory& obj);
     CacheMemory& operator=(const CacheMemory& obj);
@@ -168,10 +180,9 @@ class CacheMemory : public SimObject
     // Data Members (m_prefix)
     bool m_is_instruction_only_cache;
 
-    // The first index is the # of cache lines.
-    // The second index is the the amount associativity.
-    std::unordered_map<Addr, int> m_tag_index;
-    std::vector<std::vector<AbstractCacheEntry*> > m_cache;
+    // Tags and entries are both indexed by set * associativity + way
+    SetTagArray m_tags;
+    std::vector<AbstractCacheEntry*> m_cache;
 
     AbstractReplacementPolicy *m_replacementPolicy_ptr;
 
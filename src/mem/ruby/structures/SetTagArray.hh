@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __MEM_RUBY_STRUCTURES_SETTAGARRAY_HH__
+#define __MEM_RUBY_STRUCTURES_SETTAGARRAY_HH__
+
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+#include "base/types.hh"
+
+/**
+ * The line addresses held by a set-associative cache. The tags of all
+ * sets live in one contiguous array with the ways of a set next to
+ * each other, so a lookup is a scan of one or two host cache lines
+ * rather than a probe of a map holding every resident line. Empty
+ * ways hold MaxAddr, which is never a line address. A tag may be held by
+ * at most one way of its set.
+ */
+class SetTagArray
+{
+  public:
+    SetTagArray() : m_assoc(0) { }
+
+    void
+    init(int64_t num_sets, int assoc)
+    {
+        m_assoc = assoc;
+        m_tags.assign(num_sets * assoc, MaxAddr);
+    }
+
+    /**
+     * Returns the way of set that holds tag, or -1 if none does. The
+     * scan has no early exit so that it compiles to branch-free
+     * (and, where the host allows, vector) compares.
+     */
+    int
+    find(int64_t set, Addr tag) const
+    {
+        const Addr *tags = &m_tags[set * m_assoc];
+        int found = -1;
+        for (int way = m_assoc - 1; way >= 0; way--)
+            found = tags[way] == tag ? way : found;
+        return found;
+    }
+
+    Addr
+    get(int64_t set, int way) const
+    {
+        return m_tags[set * m_assoc + way];
+    }
+
+    void
+    set(int64_t set, int way, Addr tag)
+    {
+        assert(tag != MaxAddr);
+        m_tags[set * m_assoc + way] = tag;
+    }
+
+    void
+    invalidate(int64_t set, int way)
+    {
+        m_tags[set * m_assoc + way] = MaxAddr;
+    }
+
+  private:
+    int m_assoc;
+    std::vector<Addr> m_tags;
+};
+
+#endif // __MEM_RUBY_STRUCTURES_SETTAGARRAY_HH__
@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "base/gtest/benchmark.hh"
+#include "mem/ruby/structures/SetTagArray.hh"
+
+namespace {
+
+const int blockBits = 6;
+
+int64_t
+setOf(Addr addr, int64_t num_sets)
+{
+    return (addr >> blockBits) & (num_sets - 1);
+}
+
+/**
+ * Fills a cache of the given capacity and times lookups of random line
+ * addresses, half of which hit, against both the per-set tag array and
+ * the global unordered_map index CacheMemory used to keep.
+ */
+void
+lookupThroughput(uint64_t capacity, int assoc)
+{
+    const int64_t numSets = (capacity >> blockBits) / assoc;
+    const int numLookups = 1 << 22;
+
+    SetTagArray tags;
+    tags.init(numSets, assoc);
+    std::unordered_map<Addr, int> index;
+
+    for (int64_t set = 0; set < numSets; set++) {
+        for (int way = 0; way < assoc; way++) {
+            Addr addr = ((way * numSets) + set) << blockBits;
+            tags.set(set, way, addr);
+            index[addr] = way;
+        }
+    }
+
+    std::mt19937_64 rng(capacity);
+    std::uniform_int_distribution<Addr> dist(0, 2 * numSets * assoc - 1);
+    std::vector<Addr> addrs(numLookups);
+    for (auto &addr : addrs)
+        addr = dist(rng) << blockBits;
+
+    std::string mb = std::to_string(capacity >> 20) + "MB";
+
+    int64_t tagHits = 0;
+    recordThroughput(mb + "_set_tag_array_lookups_per_second", numLookups,
+        [&]() {
+            for (auto addr : addrs)
+                tagHits += tags.find(setOf(addr, numSets), addr) != -1;
+        });
+
+    int64_t indexHits = 0;
+    recordThroughput(mb + "_unordered_map_lookups_per_second", numLookups,
+        [&]() {
+            for (auto addr : addrs)
+                indexHits += index.find(addr) != index.end();
+        });
+
+    EXPECT_EQ(indexHits, tagHits);
+}
+
+} // anonymous namespace
+
+TEST(SetTagArrayTest, Empty)
+{
+    SetTagArray tags;
+    tags.init(4, 8);
+    for (int set = 0; set < 4; set++) {
+        EXPECT_EQ(-1, tags.find(set, 0));
+        for (int way = 0; way < 8; way++)
+            EXPECT_EQ(MaxAddr, tags.get(set, way));
+    }
+}
+
+TEST(SetTagArrayTest, SetAndInvalidate)
+{
+    SetTagArray tags;
+    tags.init(4, 8);
+    tags.set(1, 3, 0x1040);
+    tags.set(2, 3, 0x2080);
+
+    EXPECT_EQ(3, tags.find(1, 0x1040));
+    EXPECT_EQ(3, tags.find(2, 0x2080));
+    EXPECT_EQ(-1, tags.find(2, 0x1040));
+    EXPECT_EQ(0x1040, tags.get(1, 3));
+
+    tags.set(1, 3, 0x10c0);
+    EXPECT_EQ(-1, tags.find(1, 0x1040));
+    EXPECT_EQ(3, tags.find(1, 0x10c0));
+
+    tags.invalidate(1, 3);
+    EXPECT_EQ(-1, tags.find(1, 0x10c0));
+    EXPECT_EQ(3, tags.find(2, 0x2080));
+}
+
+// Benchmark across L2, L3 and TCC sized caches; only run on request
+TEST(SetTagArrayTest, DISABLED_LookupThroughput)
+{
+    for (uint64_t mb = 1; mb <= 64; mb *= 4)
+        lookupThroughput(mb << 20, 16);
+}
@@ -0,0 +1,203 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __MEM_RUBY_SYSTEM_COALESCED_TABLE_HH__
+#define __MEM_RUBY_SYSTEM_COALESCED_TABLE_HH__
+
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+#include "base/intmath.hh"
+#include "base/types.hh"
+
+/**
+ * An MSHR-like table holding the coalesced requests of each line address,
+ * in age order. The table is open-addressed with linear probing, and the
+ * requests of a line are chained through the requests themselves, so
+ * adding and removing requests allocates no memory once the table has
+ * grown to the number of outstanding lines. Requests must have a
+ * getSeqNum() method and a next pointer, which the table uses to chain
+ * them.
+ */
+template <class Request>
+class CoalescedTable
+{
+  public:
+    struct Entry
+    {
+        Addr lineAddr;
+        // oldest and youngest request of the line, nullptr if the entry
+        // is unused
+        Request *head;
+        Request *tail;
+    };
+
+    CoalescedTable() : numEntries(0) { resize(16); }
+
+    bool empty() const { return numEntries == 0; }
+    int size() const { return numEntries; }
+
+    // Oldest request of the line, nullptr if the line has none.
+    Request*
+    front(Addr line_addr) const
+    {
+        const Entry &entry = table[findSlot(line_addr)];
+        return entry.head;
+    }
+
+    // Request of the given instruction to the line, nullptr if the line
+    // has none.
+    Request*
+    find(Addr line_addr, uint64_t seq_num) const
+    {
+        Request *req = front(line_addr);
+
+        while (req && req->getSeqNum() != seq_num) {
+            req = req->next;
+        }
+
+        return req;
+    }
+
+    // Append the request to the requests of the line.
+    void
+    pushBack(Addr line_addr, Request *req)
+    {
+        Entry *entry = &table[findSlot(line_addr)];
+
+        if (entry->head) {
+            entry->tail->next = req;
+            entry->tail = req;
+            return;
+        }
+
+        // keep the load factor at or below one half
+        if (2 * (numEntries + 1) > table.size()) {
+            resize(2 * table.size());
+            entry = &table[findSlot(line_addr)];
+        }
+
+        entry->lineAddr = line_addr;
+        entry->head = req;
+        entry->tail = req;
+        ++numEntries;
+    }
+
+    // Remove the oldest request of the line, and return the next one,
+    // or nullptr if the line has no more requests.
+    Request*
+    popFront(Addr line_addr)
+    {
+        int slot = findSlot(line_addr);
+        Entry &entry = table[slot];
+        assert(entry.head);
+
+        entry.head = entry.head->next;
+
+        if (!entry.head) {
+            erase(slot);
+            return nullptr;
+        }
+
+        return entry.head;
+    }
+
+    // All entries, including unused ones which have no head request.
+    const std::vector<Entry>& entries() const { return table; }
+
+  private:
+    int
+    hash(Addr line_addr) const
+    {
+        // multiplicative hashing, as the low bits of line addresses are
+        // always zero
+        return (line_addr * 0x9e3779b97f4a7c15ULL) >> (64 - hashBits);
+    }
+
+    // Slot holding the line, or the unused slot it would be placed in.
+    int
+    findSlot(Addr line_addr) const
+    {
+        int mask = table.size() - 1;
+        int slot = hash(line_addr);
+
+        while (table[slot].head && table[slot].lineAddr != line_addr) {
+            slot = (slot + 1) & mask;
+        }
+
+        return slot;
+    }
+
+    // Remove the entry in the slot, moving back the entries after it
+    // that would otherwise no longer be found.
+    void
+    erase(int slot)
+    {
+        int mask = table.size() - 1;
+        int next = (slot + 1) & mask;
+
+        while (table[next].head) {
+            int home = hash(table[next].lineAddr);
+
+            // move the entry if the freed slot lies between its home
+            // slot and its current slot
+            if (((next - home) & mask) >= ((next - slot) & mask)) {
+                table[slot] = table[next];
+                slot = next;
+            }
+
+            next = (next + 1) & mask;
+        }
+
+        table[slot].head = nullptr;
+        table[slot].tail = nullptr;
+        --numEntries;
+    }
+
+    void
+    resize(int new_size)
+    {
+        assert(isPowerOf2(new_size));
+        std::vector<Entry> old_table(new_size, Entry{0, nullptr, nullptr});
+        old_table.swap(table);
+        hashBits = floorLog2(new_size);
+
+        for (const auto &entry : old_table) {
+            if (entry.head) {
+                table[findSlot(entry.lineAddr)] = entry;
+            }
+        }
+    }
+
+    std::vector<Entry> table;
+    int hashBits;
+    int numEntries;
+};
+
+#endif // __MEM_RUBY_SYSTEM_COALESCED_TABLE_HH__
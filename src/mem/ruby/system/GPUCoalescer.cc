@@ -43,6 +43,8 @@
 #endif // X86_ISA
 #include "mem/ruby/system/GPUCoalescer.hh"
 
+#include <algorithm>
+
 #include "cpu/testers/rubytest/RubyTester.hh"
 #include "debug/GPUCoalescer.hh"
 #include "debug/MemoryAccess.hh"
@@ -68,70 +70,107 @@ UncoalescedTable::UncoalescedTable(GPUCoalescer *gc)
 {
 }
 
+std::deque<UncoalescedTable::InstPackets>::iterator
+UncoalescedTable::findInst(uint64_t seqNum)
+{
+    auto inst = std::lower_bound(instList.begin(), instList.end(), seqNum,
+        [](const InstPackets &i, uint64_t s) { return i.seqNum < s; });
+
+    if (inst != instList.end() && inst->seqNum != seqNum) {
+        return instList.end();
+    }
+
+    return inst;
+}
+
 void
 UncoalescedTable::insertPacket(PacketPtr pkt)
 {
     uint64_t seqNum = pkt->req->getReqInstSeqNum();
+    auto inst = instList.end();
+
+    // packets of the youngest instruction are the common case
+    if (!instList.empty() && instList.back().seqNum == seqNum) {
+        inst = std::prev(instList.end());
+    } else if (instList.empty() || instList.back().seqNum < seqNum) {
+        instList.push_back(InstPackets{seqNum, PerInstPackets()});
+        inst = std::prev(instList.end());
+    } else {
+        inst = std::lower_bound(instList.begin(), instList.end(), seqNum,
+            [](const InstPackets &i, uint64_t s) { return i.seqNum < s; });
 
-    instMap[seqNum].push_back(pkt);
+        if (inst->seqNum != seqNum) {
+            inst = instList.insert(inst, InstPackets{seqNum,
+                                                     PerInstPackets()});
+        }
+    }
+
+    if (inst->pkts.empty() && !freePktLists.empty()) {
+        inst->pkts.swap(freePktLists.back());
+        freePktLists.pop_back();
+    }
+
+    inst->pkts.push_back(pkt);
     DPRINTF(GPUCoalescer, "Adding 0x%X seqNum %d to map. (map %d vec %d)\n",
-            pkt->getAddr(), seqNum, instMap.size(), instMap[seqNum].size());
+            pkt->getAddr(), seqNum, instList.size(), inst->pkts.size());
 }
 
 bool
 UncoalescedTable::packetAvailable()
 {
-    return !instMap.empty();
+    return !instList.empty();
 }
 
 PerInstPackets*
 UncoalescedTable::getInstPackets(int offset)
 {
-    if (offset >= instMap.size()) {
+    if (offset >= instList.size()) {
         return nullptr;
     }
 
-    auto instMapIter = instMap.begin();
-    std::advance(instMapIter, offset);
-
-    return &(instMapIter->second);
+    return &(instList[offset].pkts);
 }
 
 void
 UncoalescedTable::updateResources()
 {
-    for (auto iter = instMap.begin(); iter != instMap.end(); ) {
-        if (iter->second.empty()) {
-            DPRINTF(GPUCoalescer, "Returning token seqNum %d\n", iter->first);
-            instMap.erase(iter++);
-            coalescer->getMemSlavePort(0)->sendTokens(1);
-        } else {
-            ++iter;
+    // return the tokens of the instructions with no packets left, and
+    // move the remaining instructions forward, keeping them in age order
+    auto last = instList.begin();
+
+    for (auto inst = instList.begin(); inst != instList.end(); ++inst) {
+        if (!inst->pkts.empty()) {
+            if (inst != last) {
+                *last = std::move(*inst);
+            }
+            ++last;
+            continue;
         }
+
+        DPRINTF(GPUCoalescer, "Returning token seqNum %d\n", inst->seqNum);
+        freePktLists.push_back(std::move(inst->pkts));
+        coalescer->getMemSlavePort(0)->sendTokens(1);
     }
+
+    instList.erase(last, instList.end());
 }
 
 bool
 UncoalescedTable::areRequestsDone(const uint64_t instSeqNum) {
-    // iterate the instructions held in UncoalescedTable to see whether there
+    // search the instructions held in UncoalescedTable to see whether there
     // are more requests to issue; if yes, not yet done; otherwise, done
-    for (auto& inst : instMap) {
-        DPRINTF(GPUCoalescer, "instSeqNum= %d, pending packets=%d\n"
-            ,inst.first, inst.second.size());
-        if (inst.first == instSeqNum) { return false; }
-    }
-
-    return true;
+    return findInst(instSeqNum) == instList.end();
 }
 
 void
 UncoalescedTable::printRequestTable(std::stringstream& ss)
 {
-    ss << "Listing pending packets from " << instMap.size() << " instructions";
+    ss << "Listing pending packets from " << instList.size()
+       << " instructions";
 
-    for (auto& inst : instMap) {
-        ss << "\tAddr: " << printAddress(inst.first) << " with "
-           << inst.second.size() << " pending packets" << std::endl;
+    for (auto& inst : instList) {
+        ss << "\tAddr: " << printAddress(inst.seqNum) << " with "
+           << inst.pkts.size() << " pending packets" << std::endl;
     }
 }
 
@@ -173,13 +212,51 @@ GPUCoalescer::GPUCoalescer(const Params *p)
 
 GPUCoalescer::~GPUCoalescer()
 {
+    for (auto crequest : requestPool) {
+        delete crequest;
+    }
+}
+
+CoalescedRequest*
+GPUCoalescer::allocRequest(uint64_t seqNum)
+{
+    if (requestPool.empty()) {
+        return new CoalescedRequest(seqNum);
+    }
+
+    CoalescedRequest *crequest = requestPool.back();
+    requestPool.pop_back();
+    crequest->reset(seqNum);
+
+    return crequest;
+}
+
+void
+GPUCoalescer::freeRequest(CoalescedRequest *crequest)
+{
+    requestPool.push_back(crequest);
+}
+
+void
+GPUCoalescer::completeRequest(Addr address)
+{
+    CoalescedRequest *crequest = coalescedTable.front(address);
+    CoalescedRequest *nextRequest = coalescedTable.popFront(address);
+
+    // remove this crequest in coalescedTable
+    freeRequest(crequest);
+
+    if (nextRequest) {
+        issueRequest(nextRequest);
+    }
 }
 
 void
 GPUCoalescer::wakeup()
 {
-    for (auto& requestList : coalescedTable) {
-        for (auto& request : requestList.second) {
+    for (auto& entry : coalescedTable.entries()) {
+        for (auto request = entry.head; request;
+             request = request->getNext()) {
             if (curCycle() - request->getIssueTime() > m_deadlock_threshold) {
                 std::stringstream ss;
                 printRequestTable(ss);
@@ -203,9 +280,10 @@ GPUCoalescer::printRequestTable(std::stringstream& ss)
     ss << "Printing out " << coalescedTable.size()
        << " outstanding requests in the coalesced table\n";
 
-    for (auto& requestList : coalescedTable) {
-        for (auto& request : requestList.second) {
-            ss << "\tAddr: " << printAddress(requestList.first) << "\n"
+    for (auto& entry : coalescedTable.entries()) {
+        for (auto request = entry.head; request;
+             request = request->getNext()) {
+            ss << "\tAddr: " << printAddress(entry.lineAddr) << "\n"
                << "\tInstruction sequence number: "
                << request->getSeqNum() << "\n"
                << "\t\tType: "
@@ -303,23 +381,14 @@ GPUCoalescer::writeCallback(Addr address,
                          bool isRegion)
 {
     assert(address == makeLineAddress(address));
-    assert(coalescedTable.count(address));
 
-    auto crequest = coalescedTable.at(address).front();
+    auto crequest = coalescedTable.front(address);
+    assert(crequest);
 
     hitCallback(crequest, mach, data, true, crequest->getIssueTime(),
                 forwardRequestTime, firstResponseTime, isRegion);
 
-    // remove this crequest in coalescedTable
-    delete crequest;
-    coalescedTable.at(address).pop_front();
-
-    if (coalescedTable.at(address).empty()) {
-        coalescedTable.erase(address);
-    } else {
-        auto nextRequest = coalescedTable.at(address).front();
-        issueRequest(nextRequest);
-    }
+    completeRequest(address);
 }
 
 void
@@ -390,32 +459,24 @@ GPUCoalescer::readCallback(Addr address,
                         bool isRegion)
 {
     assert(address == makeLineAddress(address));
-    assert(coalescedTable.count(address));
 
-    auto crequest = coalescedTable.at(address).front();
+    auto crequest = coalescedTable.front(address);
+    assert(crequest);
     fatal_if(crequest->getRubyType() != RubyRequestType_LD,
              "readCallback received non-read type response\n");
 
     // Iterate over the coalesced requests to respond to as many loads as
     // possible until another request type is seen. Models MSHR for TCP.
-    while (crequest->getRubyType() == RubyRequestType_LD) {
+    while (crequest && crequest->getRubyType() == RubyRequestType_LD) {
         hitCallback(crequest, mach, data, true, crequest->getIssueTime(),
                     forwardRequestTime, firstResponseTime, isRegion);
 
-        delete crequest;
-        coalescedTable.at(address).pop_front();
-        if (coalescedTable.at(address).empty()) {
-            break;
-        }
-
-        crequest = coalescedTable.at(address).front();
+        freeRequest(crequest);
+        crequest = coalescedTable.popFront(address);
     }
 
-    if (coalescedTable.at(address).empty()) {
-        coalescedTable.erase(address);
-    } else {
-        auto nextRequest = coalescedTable.at(address).front();
-        issueRequest(nextRequest);
+    if (crequest) {
+        issueRequest(crequest);
     }
 }
 
@@ -445,7 +506,7 @@ GPUCoalescer::hitCallback(CoalescedRequest* crequest,
     // update the data
     //
     // MUST AD DOING THIS FOR EACH REQUEST IN COALESCER
-    std::vector<PacketPtr> pktList = crequest->getPackets();
+    std::vector<PacketPtr> &pktList = crequest->getPackets();
     DPRINTF(GPUCoalescer, "Responding to %d packets for addr 0x%X\n",
             pktList.size(), request_line_address);
     for (auto& pkt : pktList) {
@@ -587,16 +648,11 @@ GPUCoalescer::coalescePacket(PacketPtr pkt)
 
     // If the packet has the same line address as a request already in the
     // coalescedTable and has the same sequence number, it can be coalesced.
-    if (coalescedTable.count(line_addr)) {
-        // Search for a previous coalesced request with the same seqNum.
-        auto& creqQueue = coalescedTable.at(line_addr);
-        auto citer = std::find_if(creqQueue.begin(), creqQueue.end(),
-            [&](CoalescedRequest* c) { return c->getSeqNum() == seqNum; }
-        );
-        if (citer != creqQueue.end()) {
-            (*citer)->insertPacket(pkt);
-            return true;
-        }
+    // Search for a previous coalesced request with the same seqNum.
+    CoalescedRequest *prev_creq = coalescedTable.find(line_addr, seqNum);
+    if (prev_creq) {
+        prev_creq->insertPacket(pkt);
+        return true;
     }
 
     if (m_outstanding_count < m_max_outstanding_requests) {
@@ -605,16 +661,17 @@ GPUCoalescer::coalescePacket(PacketPtr pkt)
         DPRINTF(GPUCoalescer, "Creating new or aliased request for 0x%X\n",
                 line_addr);
 
-        CoalescedRequest *creq = new CoalescedRequest(seqNum);
+        CoalescedRequest *creq = allocRequest(seqNum);
         creq->insertPacket(pkt);
         creq->setRubyType(getRequestType(pkt));
         creq->setIssueTime(curCycle());
 
-        if (!coalescedTable.count(line_addr)) {
+        bool outstanding = coalescedTable.front(line_addr) != nullptr;
+        coalescedTable.pushBack(line_addr, creq);
+
+        if (!outstanding) {
             // If there is no outstanding request for this line address,
             // create a new coalecsed request and issue it immediately.
-            auto reqList = std::deque<CoalescedRequest*> { creq };
-            coalescedTable.insert(std::make_pair(line_addr, reqList));
 
             DPRINTF(GPUCoalescer, "Issued req type %s seqNum %d\n",
                     RubyRequestType_to_string(creq->getRubyType()), seqNum);
@@ -623,7 +680,6 @@ GPUCoalescer::coalescePacket(PacketPtr pkt)
             // The request is for a line address that is already outstanding
             // but for a different instruction. Add it as a new request to be
             // issued when the current outstanding request is completed.
-            coalescedTable.at(line_addr).push_back(creq);
             DPRINTF(GPUCoalescer, "found address 0x%X with new seqNum %d\n",
                     line_addr, seqNum);
         }
@@ -678,9 +734,9 @@ GPUCoalescer::completeIssue()
             // erase them from the list if coalescing is successful and
             // leave them in the list otherwise. This aggressively attempts
             // to coalesce as many packets as possible from the current inst.
-            pktList->remove_if(
-                [&](PacketPtr pkt) { return coalescePacket(pkt); }
-            );
+            pktList->erase(std::remove_if(pktList->begin(), pktList->end(),
+                [&](PacketPtr pkt) { return coalescePacket(pkt); }),
+                pktList->end());
         }
     }
 
@@ -718,9 +774,9 @@ GPUCoalescer::atomicCallback(Addr address,
                              const DataBlock& data)
 {
     assert(address == makeLineAddress(address));
-    assert(coalescedTable.count(address));
 
-    auto crequest = coalescedTable.at(address).front();
+    auto crequest = coalescedTable.front(address);
+    assert(crequest);
 
     fatal_if((crequest->getRubyType() != RubyRequestType_ATOMIC &&
               crequest->getRubyType() != RubyRequestType_ATOMIC_RETURN &&
@@ -730,15 +786,7 @@ GPUCoalescer::atomicCallback(Addr address,
     hitCallback(crequest, mach, (DataBlock&)data, true,
                 crequest->getIssueTime(), Cycles(0), Cycles(0), false);
 
-    delete crequest;
-    coalescedTable.at(address).pop_front();
-
-    if (coalescedTable.at(address).empty()) {
-        coalescedTable.erase(address);
-    } else {
-        auto nextRequest = coalescedTable.at(address).front();
-        issueRequest(nextRequest);
-    }
+    completeRequest(address);
 }
 
 void
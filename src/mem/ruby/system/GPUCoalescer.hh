@@ -36,8 +36,10 @@
 #ifndef __MEM_RUBY_SYSTEM_GPU_COALESCER_HH__
 #define __MEM_RUBY_SYSTEM_GPU_COALESCER_HH__
 
+#include <deque>
 #include <iostream>
 #include <unordered_map>
+#include <vector>
 
 #include "base/statistics.hh"
 #include "cpu/testers/gpu_ruby_test/ProtocolTester.hh"
@@ -50,6 +52,7 @@
 #include "mem/request.hh"
 #include "mem/ruby/common/Address.hh"
 #include "mem/ruby/common/Consumer.hh"
+#include "mem/ruby/system/CoalescedTable.hh"
 #include "mem/ruby/system/Sequencer.hh"
 
 class DataBlock;
@@ -60,7 +63,7 @@ class CacheMemory;
 class RubyGPUCoalescerParams;
 
 // List of packets that belongs to a specific instruction.
-typedef std::list<PacketPtr> PerInstPackets;
+typedef std::vector<PacketPtr> PerInstPackets;
 
 class UncoalescedTable
 {
@@ -80,13 +83,28 @@ class UncoalescedTable
     bool areRequestsDone(const uint64_t instSeqNum);
 
   private:
+    struct InstPackets
+    {
+        uint64_t seqNum;
+        PerInstPackets pkts;
+    };
+
+    // Returns the entry of the instruction with the given sequence
+    // number, or the end of instList if there is none.
+    std::deque<InstPackets>::iterator findInst(uint64_t seqNum);
+
     GPUCoalescer *coalescer;
 
-    // Maps an instructions unique sequence number to a queue of packets
-    // which need responses. This data structure assumes the sequence number
-    // is monotonically increasing (which is true for CU class) in order to
-    // issue packets in age order.
-    std::map<uint64_t, PerInstPackets> instMap;
+    // The packets which need responses of each instruction, sorted by
+    // the instructions' unique sequence numbers in order to issue
+    // packets in age order. The sequence numbers are mostly
+    // monotonically increasing (which is true for CU class), so new
+    // instructions are usually appended.
+    std::deque<InstPackets> instList;
+
+    // Emptied packet lists, which are reused for new instructions to
+    // avoid reallocating their storage.
+    std::vector<PerInstPackets> freePktLists;
 };
 
 class CoalescedRequest
@@ -94,10 +112,22 @@ class CoalescedRequest
   public:
     CoalescedRequest(uint64_t _seqNum)
         : seqNum(_seqNum), issueTime(Cycles(0)),
-          rubyType(RubyRequestType_NULL)
+          rubyType(RubyRequestType_NULL), next(nullptr)
     {}
     ~CoalescedRequest() {}
 
+    // Prepare a request taken from the coalescer's pool for reuse,
+    // keeping the storage of its packet list.
+    void
+    reset(uint64_t _seqNum)
+    {
+        seqNum = _seqNum;
+        issueTime = Cycles(0);
+        rubyType = RubyRequestType_NULL;
+        pkts.clear();
+        next = nullptr;
+    }
+
     void insertPacket(PacketPtr pkt) { pkts.push_back(pkt); }
     void setSeqNum(uint64_t _seqNum) { seqNum = _seqNum; }
     void setIssueTime(Cycles _issueTime) { issueTime = _issueTime; }
@@ -108,12 +138,17 @@ class CoalescedRequest
     Cycles getIssueTime() const { return issueTime; }
     RubyRequestType getRubyType() const { return rubyType; }
     std::vector<PacketPtr>& getPackets() { return pkts; }
+    CoalescedRequest* getNext() const { return next; }
 
   private:
     uint64_t seqNum;
     Cycles issueTime;
     RubyRequestType rubyType;
     std::vector<PacketPtr> pkts;
+
+    // next request to the same line in the coalesced table
+    CoalescedRequest *next;
+    template <class Request> friend class CoalescedTable;
 };
 
 // PendingWriteInst tracks the number of outstanding Ruby requests
@@ -434,7 +469,20 @@ class GPUCoalescer : public RubyPort
     // maximum size is equal to the maximum outstanding requests for a CU
     // (typically the number of blocks in TCP). If there are duplicates of
     // an address, the are serviced in age order.
-    std::map<Addr, std::deque<CoalescedRequest*>> coalescedTable;
+    CoalescedTable<CoalescedRequest> coalescedTable;
+
+    // Get a request from the pool, or allocate one if it is empty, and
+    // return a completed request to the pool.
+    CoalescedRequest* allocRequest(uint64_t seqNum);
+    void freeRequest(CoalescedRequest *crequest);
+
+    // Completed requests, reused to avoid allocating a request (and its
+    // packet list) for every coalesced line.
+    std::vector<CoalescedRequest*> requestPool;
+
+    // Complete the oldest request to the line, and issue the next one,
+    // if any.
+    void completeRequest(Addr address);
 
     // a map btw an instruction sequence number and PendingWriteInst
     // this is used to do a final call back for each write when it is
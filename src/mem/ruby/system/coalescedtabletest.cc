@@ -0,0 +1,247 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <deque>
+#include <map>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "mem/ruby/system/CoalescedTable.hh"
+
+namespace {
+
+const Addr lineSize = 64;
+
+struct Request
+{
+    explicit Request(uint64_t seq_num) : seqNum(seq_num), next(nullptr) { }
+
+    uint64_t getSeqNum() const { return seqNum; }
+
+    uint64_t seqNum;
+    Request *next;
+};
+
+typedef CoalescedTable<Request> Table;
+
+/**
+ * Lines whose entry is placed in the given slot of an empty table, found
+ * by inserting candidate lines one at a time.
+ */
+std::vector<Addr>
+linesWithHome(int slot, int count)
+{
+    std::vector<Addr> lines;
+    Request req(0);
+
+    for (Addr line = 0; lines.size() < count; line += lineSize) {
+        Table table;
+        table.pushBack(line, &req);
+        if (table.entries()[slot].head) {
+            lines.push_back(line);
+        }
+    }
+
+    return lines;
+}
+
+int
+slotOf(const Table &table, Addr line)
+{
+    for (int slot = 0; slot < table.entries().size(); ++slot) {
+        const Table::Entry &entry = table.entries()[slot];
+        if (entry.head && entry.lineAddr == line) {
+            return slot;
+        }
+    }
+
+    return -1;
+}
+
+} // anonymous namespace
+
+TEST(CoalescedTableTest, ChainsRequestsOfALine)
+{
+    Table table;
+    Request a(1), b(2), c(3);
+
+    EXPECT_TRUE(table.empty());
+    EXPECT_EQ(nullptr, table.front(0x40));
+
+    table.pushBack(0x40, &a);
+    table.pushBack(0x40, &b);
+    table.pushBack(0x80, &c);
+    EXPECT_EQ(2, table.size());
+    EXPECT_EQ(&a, table.front(0x40));
+    EXPECT_EQ(&b, table.find(0x40, 2));
+    EXPECT_EQ(nullptr, table.find(0x40, 3));
+    EXPECT_EQ(&c, table.find(0x80, 3));
+
+    EXPECT_EQ(&b, table.popFront(0x40));
+    EXPECT_EQ(nullptr, table.popFront(0x40));
+    EXPECT_EQ(nullptr, table.front(0x40));
+    EXPECT_EQ(1, table.size());
+    EXPECT_EQ(nullptr, table.popFront(0x80));
+    EXPECT_TRUE(table.empty());
+}
+
+TEST(CoalescedTableTest, ProbesWrapAround)
+{
+    const int last_slot = 15;
+    std::vector<Addr> lines = linesWithHome(last_slot, 3);
+    Table table;
+    Request a(1), b(2), c(3);
+    ASSERT_EQ(16, table.entries().size());
+
+    // all three lines have the last slot as home, so the second and the
+    // third are placed in the first slots
+    table.pushBack(lines[0], &a);
+    table.pushBack(lines[1], &b);
+    table.pushBack(lines[2], &c);
+    EXPECT_EQ(last_slot, slotOf(table, lines[0]));
+    EXPECT_EQ(0, slotOf(table, lines[1]));
+    EXPECT_EQ(1, slotOf(table, lines[2]));
+
+    // removing the first line moves the others back across the end of
+    // the table, and leaves them reachable
+    EXPECT_EQ(nullptr, table.popFront(lines[0]));
+    EXPECT_EQ(last_slot, slotOf(table, lines[1]));
+    EXPECT_EQ(0, slotOf(table, lines[2]));
+    EXPECT_EQ(nullptr, table.entries()[1].head);
+    EXPECT_EQ(&b, table.front(lines[1]));
+    EXPECT_EQ(&c, table.front(lines[2]));
+    EXPECT_EQ(nullptr, table.front(lines[0]));
+
+    // a line whose home is the first slot is not moved past its home
+    std::vector<Addr> first = linesWithHome(0, 1);
+    Request d(4);
+    table.pushBack(first[0], &d);
+    EXPECT_EQ(1, slotOf(table, first[0]));
+    EXPECT_EQ(nullptr, table.popFront(lines[1]));
+    EXPECT_EQ(last_slot, slotOf(table, lines[2]));
+    EXPECT_EQ(0, slotOf(table, first[0]));
+    EXPECT_EQ(&d, table.front(first[0]));
+}
+
+TEST(CoalescedTableTest, ResizeKeepsChains)
+{
+    Table table;
+    std::deque<Request> reqs;
+    const int num_lines = 100;
+
+    // two requests per line, so that the chains have to move with the
+    // entries when the table grows
+    for (int i = 0; i < 2 * num_lines; ++i) {
+        reqs.emplace_back(i);
+        table.pushBack((i % num_lines) * lineSize, &reqs.back());
+    }
+
+    EXPECT_EQ(num_lines, table.size());
+    // the load factor is kept at or below one half
+    EXPECT_EQ(256, table.entries().size());
+
+    for (int i = 0; i < num_lines; ++i) {
+        Addr line = i * lineSize;
+        EXPECT_EQ(&reqs[i], table.front(line));
+        EXPECT_EQ(&reqs[i + num_lines], table.find(line, i + num_lines));
+        EXPECT_EQ(&reqs[i + num_lines], table.popFront(line));
+    }
+}
+
+TEST(CoalescedTableTest, MatchesMap)
+{
+    // few enough lines that they collide and are removed often
+    const int num_lines = 96;
+    const int ops = 200000;
+
+    for (unsigned seed = 1; seed <= 4; ++seed) {
+        std::mt19937 rng(seed);
+        std::uniform_int_distribution<int> line_dist(0, num_lines - 1);
+        std::uniform_int_distribution<int> op_dist(0, 9);
+
+        Table table;
+        std::map<Addr, std::deque<Request*>> ref;
+        std::vector<std::unique_ptr<Request>> reqs;
+        uint64_t seq_num = 0;
+
+        for (int i = 0; i < ops; ++i) {
+            // lines far apart in the address space as well as adjacent
+            Addr line = line_dist(rng) * lineSize;
+            if (line_dist(rng) % 2) {
+                line += Addr(1) << 40;
+            }
+            auto it = ref.find(line);
+            int op = op_dist(rng);
+
+            if (op < 4) {
+                reqs.emplace_back(new Request(++seq_num));
+                table.pushBack(line, reqs.back().get());
+                ref[line].push_back(reqs.back().get());
+            } else if (op < 8) {
+                if (it == ref.end()) {
+                    EXPECT_EQ(nullptr, table.front(line));
+                    continue;
+                }
+                it->second.pop_front();
+                Request *next = it->second.empty() ? nullptr :
+                    it->second.front();
+                ASSERT_EQ(next, table.popFront(line));
+                if (!next) {
+                    ref.erase(it);
+                }
+            } else if (it != ref.end()) {
+                std::uniform_int_distribution<int> req_dist(
+                    0, it->second.size() - 1);
+                Request *req = it->second[req_dist(rng)];
+                EXPECT_EQ(req, table.find(line, req->getSeqNum()));
+                EXPECT_EQ(nullptr, table.find(line, seq_num + 1));
+            } else {
+                EXPECT_EQ(nullptr, table.find(line, seq_num));
+            }
+
+            ASSERT_EQ(ref.size(), table.size());
+        }
+
+        // every line of the table is in the map, with the same oldest
+        // request
+        int used = 0;
+        for (const auto &entry : table.entries()) {
+            if (entry.head) {
+                ++used;
+                auto it = ref.find(entry.lineAddr);
+                ASSERT_NE(ref.end(), it);
+                EXPECT_EQ(it->second.front(), entry.head);
+                EXPECT_EQ(it->second.back(), entry.tail);
+            }
+        }
+        EXPECT_EQ(ref.size(), used);
+    }
+}
@@ -45,6 +45,9 @@ class Process(SimObject):
     useArchPT = Param.Bool('false', 'maintain an in-memory version of the page\
                             table in an architecture-specific format')
     kvmInSE = Param.Bool('false', 'initialize the process for KvmCPU in SE')
+    useLargePages = Param.Bool(False, "allocate and map aligned regions "
+                               "with large pages, where the ISA supports "
+                               "them")
     maxStackSize = Param.MemorySize('64MB', 'maximum size of the stack')
 
     uid = Param.Int(100, 'user id')
@@ -58,6 +58,7 @@ Tick simQuantum = 0;
 uint32_t numMainEventQueues = 0;
 vector<EventQueue *> mainEventQueue;
 __thread EventQueue *_curEventQueue = NULL;
+__thread EventQueue *_heldEventQueue = NULL;
 bool inParallelMode = false;
 
 EventQueue *
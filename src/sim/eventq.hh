@@ -73,6 +73,10 @@ extern std::vector<EventQueue *> mainEventQueue;
 
 extern __thread EventQueue *_curEventQueue;
 
+//! The event queue the running thread keeps locked underneath a
+//! nested migration (see EventQueue::ScopedNestedMigration), or NULL.
+extern __thread EventQueue *_heldEventQueue;
+
 //! Current mode of execution: parallel / serial
 extern bool inParallelMode;
 
@@ -551,9 +555,15 @@ class EventQueue
       public:
         ScopedMigration(EventQueue *_new_eq, bool _doMigrate = true)
             :new_eq(*_new_eq), old_eq(*curEventQueue()),
-             doMigrate((&new_eq != &old_eq)&&_doMigrate)
+             doMigrate((&new_eq != &old_eq)&&_doMigrate),
+             alreadyHeld(doMigrate && &new_eq == _heldEventQueue)
         {
-            if (doMigrate){
+            if (alreadyHeld) {
+                // the thread still holds new_eq underneath a nested
+                // migration, swap the roles of the two locked queues
+                _heldEventQueue = &old_eq;
+                curEventQueue(&new_eq);
+            } else if (doMigrate){
                 old_eq.unlock();
                 new_eq.lock();
                 curEventQueue(&new_eq);
@@ -562,7 +572,10 @@ class EventQueue
 
         ~ScopedMigration()
         {
-            if (doMigrate){
+            if (alreadyHeld) {
+                _heldEventQueue = &new_eq;
+                curEventQueue(&old_eq);
+            } else if (doMigrate){
                 new_eq.unlock();
                 old_eq.lock();
                 curEventQueue(&old_eq);
@@ -573,6 +586,58 @@ class EventQueue
         EventQueue &new_eq;
         EventQueue &old_eq;
         bool doMigrate;
+        bool alreadyHeld;
+    };
+
+    /**
+     * Temporarily enter a different event queue without releasing the
+     * current one.
+     *
+     * Unlike ScopedMigration, the current queue stays locked while
+     * execution runs on the new queue. This lets an object that owns
+     * state shared by several threads (e.g., a GPU shader and its
+     * compute units) call into objects on other queues while keeping
+     * its own state protected. To avoid deadlocks, queues must always
+     * be nested in the same order, and only one level of nesting is
+     * supported. A ScopedMigration back to the held queue from within
+     * the nested region is recognized and does not block.
+     *
+     * ScopedNestedMigration does nothing if both eqs are the same.
+     */
+    class ScopedNestedMigration
+    {
+      public:
+        ScopedNestedMigration(EventQueue *_new_eq)
+            : new_eq(*_new_eq), old_eq(*curEventQueue()),
+              old_held(_heldEventQueue),
+              doMigrate(&new_eq != &old_eq),
+              alreadyHeld(doMigrate && &new_eq == _heldEventQueue)
+        {
+            if (doMigrate) {
+                assert(alreadyHeld || !_heldEventQueue);
+                if (!alreadyHeld)
+                    new_eq.lock();
+                _heldEventQueue = &old_eq;
+                curEventQueue(&new_eq);
+            }
+        }
+
+        ~ScopedNestedMigration()
+        {
+            if (doMigrate) {
+                if (!alreadyHeld)
+                    new_eq.unlock();
+                _heldEventQueue = old_held;
+                curEventQueue(&old_eq);
+            }
+        }
+
+      private:
+        EventQueue &new_eq;
+        EventQueue &old_eq;
+        EventQueue *old_held;
+        bool doMigrate;
+        bool alreadyHeld;
     };
 
     /**
@@ -387,7 +387,28 @@ MemState::fixupFault(Addr vaddr)
     for (const auto &vma : _vmaList) {
         if (vma.contains(vaddr)) {
             Addr vpage_start = roundDown(vaddr, TheISA::PageBytes);
-            allocateMem(vpage_start, TheISA::PageBytes);
+            Addr vpage_size = TheISA::PageBytes;
+
+            /**
+             * If the page table tracks large pages, fault in the whole
+             * (smallest) large page around vaddr, provided it is part of
+             * this VMA and none of it has been touched yet, so that it may
+             * be mapped as a large page. Larger pages are only used for
+             * regions that are allocated at once.
+             */
+            if (!_pTable->largePageSizes().empty()) {
+                Addr large_size = _pTable->largePageSizes().front();
+                Addr large_start = roundDown(vaddr, large_size);
+
+                if (vma.start() <= large_start &&
+                    large_start + large_size - 1 <= vma.end() &&
+                    _pTable->isUnmapped(large_start, large_size)) {
+                    vpage_start = large_start;
+                    vpage_size = large_size;
+                }
+            }
+
+            allocateMem(vpage_start, vpage_size);
 
             /**
              * We are assuming that fresh pages are zero-filled, so there is
@@ -396,7 +417,7 @@ MemState::fixupFault(Addr vaddr)
              * are recycled.
              */
             if (vma.hasHostBuf()) {
-                vma.fillMemPages(vpage_start, TheISA::PageBytes, _virtMem);
+                vma.fillMemPages(vpage_start, vpage_size, _virtMem);
             }
             return true;
         }
@@ -417,7 +438,17 @@ void
 MemState::allocateMem(Addr vaddr, int64_t size, bool clobber)
 {
     int npages = divCeil(size, (int64_t)TheISA::PageBytes);
-    Addr paddr = system()->allocPhysPages(npages);
+
+    // the largest page size the region contains an aligned page of
+    Addr large_size = 0;
+    for (Addr page_size : _pTable->largePageSizes()) {
+        if (roundUp(vaddr, page_size) + page_size <= vaddr + size)
+            large_size = page_size;
+    }
+
+    Addr paddr = large_size ?
+                 system()->allocPhysPages(npages, vaddr, large_size) :
+                 system()->allocPhysPages(npages);
     auto flags = clobber ? EmulationPageTable::Clobber :
                            EmulationPageTable::MappingFlags(0);
     _pTable->map(vaddr, paddr, size, flags);
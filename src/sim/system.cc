@@ -51,6 +51,7 @@
 
 #include "arch/remote_gdb.hh"
 #include "arch/utility.hh"
+#include "base/intmath.hh"
 #include "base/loader/object_file.hh"
 #include "base/loader/symtab.hh"
 #include "base/str.hh"
@@ -391,6 +392,23 @@ System::allocPhysPages(int npages)
     return return_addr;
 }
 
+Addr
+System::allocPhysPages(int npages, Addr vaddr, Addr align)
+{
+    assert(isPowerOf2(align));
+
+    // the pages we skip over are simply never used
+    Addr next_addr = pagePtr << PageShift;
+    Addr aligned_addr = roundDown(next_addr, align) + (vaddr & (align - 1));
+
+    if (aligned_addr < next_addr)
+        aligned_addr += align;
+
+    pagePtr = aligned_addr >> PageShift;
+
+    return allocPhysPages(npages);
+}
+
 Addr
 System::memSize() const
 {
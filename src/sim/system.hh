@@ -574,6 +574,12 @@ class System : public MemObject
     /// @return Starting address of first page
     Addr allocPhysPages(int npages);
 
+    /// Allocate npages contiguous unused physical pages, starting at an
+    /// address congruent to vaddr modulo align, so that the align-aligned
+    /// regions of a mapping that starts at vaddr may use large pages
+    /// @return Starting address of first page
+    Addr allocPhysPages(int npages, Addr vaddr, Addr align);
+
     ContextID registerThreadContext(ThreadContext *tc,
                                     ContextID assigned = InvalidContextID);
     void replaceThreadContext(ThreadContext *tc, ContextID context_id);
@@ -0,0 +1,151 @@
+#!/usr/bin/env python2
+
+#
+# Copyright (c) 2026 The gem5 Authors
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+
+# Annotate the disassembly of a GPU kernel with its per-instruction
+# profile, as written by the shader when its inst_profile_dir parameter is
+# set. Each line of the profile directory's kernel<N>.csv files holds the
+# issue count, active lanes and stall cycles (by reason) of an instruction,
+# keyed by its offset from the start of the kernel's code.
+#
+# By default the disassembly recorded in the profile is used. If the
+# output of llvm-objdump -d for the code object is given instead, its
+# lines are annotated in place, which keeps the labels and the
+# instructions that were never reached. The offsets are relative to the
+# first instruction of the disassembly unless --base gives the address
+# of the kernel's entry point.
+#
+# Usage:
+#   gpu_inst_profile.py [--disasm <objdump output>] [--base <addr>]
+#                       [--top <n>] <kernel csv>
+
+from __future__ import print_function
+
+import argparse
+import csv
+import re
+import sys
+
+STALL_SUFFIX = ' stalls'
+
+def read_profile(path):
+    kernel = ''
+    rows = []
+    with open(path) as f:
+        first = f.readline()
+        if first.startswith('#'):
+            kernel = first[1:].strip()
+        else:
+            f.seek(0)
+
+        reader = csv.reader(f, skipinitialspace=True)
+        header = next(reader)
+        stalls = [h for h in header if h.endswith(STALL_SUFFIX)]
+        for row in reader:
+            entry = dict(zip(header, row))
+            rows.append({
+                'pc': int(entry['pc'], 16),
+                'issued': int(entry['issued']),
+                'lanes': int(entry['active lanes']),
+                'stalls': [int(entry[s]) for s in stalls],
+                'disasm': entry['disassembly'],
+            })
+
+    return kernel, [s[:-len(STALL_SUFFIX)] for s in stalls], rows
+
+def columns(stall_names):
+    return ['issued', 'lanes/issue'] + stall_names
+
+def annotation(row, stall_names):
+    if row is None:
+        return ' ' * (12 * len(columns(stall_names)))
+
+    lanes = float(row['lanes']) / row['issued'] if row['issued'] else 0
+    fields = ['%d' % row['issued'], '%.1f' % lanes]
+    fields += ['%d' % s for s in row['stalls']]
+    return ''.join('%12s' % f for f in fields)
+
+# llvm-objdump prints the address of each instruction in a trailing
+# comment, e.g., "s_endpgm // 000000001234: BF810000"
+OBJDUMP_ADDR = re.compile(r'//\s*([0-9a-fA-F]+):')
+
+def annotate_objdump(path, base, rows, stall_names):
+    by_pc = dict((r['pc'], r) for r in rows)
+    with open(path) as f:
+        for line in f:
+            line = line.rstrip('\n')
+            match = OBJDUMP_ADDR.search(line)
+            if not match:
+                print(' ' * (12 * len(columns(stall_names))) + '  ' + line)
+                continue
+
+            addr = int(match.group(1), 16)
+            if base is None:
+                base = addr
+            row = by_pc.get(addr - base)
+            print(annotation(row, stall_names) + '  ' + line)
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Annotate a GPU kernel with its instruction profile')
+    parser.add_argument('profile', help='kernel<N>.csv profile to read')
+    parser.add_argument('--disasm', help='llvm-objdump -d output of the '
+                        'kernel to annotate')
+    parser.add_argument('--base', type=lambda x: int(x, 0),
+                        help='address of the kernel entry point in the '
+                        'disassembly')
+    parser.add_argument('--top', type=int, default=0,
+                        help='also list the N instructions with the most '
+                        'stall cycles')
+    args = parser.parse_args()
+
+    kernel, stall_names, rows = read_profile(args.profile)
+    if kernel:
+        print('#', kernel)
+    print(''.join('%12s' % c for c in columns(stall_names)))
+
+    if args.disasm:
+        annotate_objdump(args.disasm, args.base, rows, stall_names)
+    else:
+        for row in rows:
+            print('%s  %#06x: %s' % (annotation(row, stall_names),
+                                     row['pc'], row['disasm']))
+
+    if args.top:
+        print()
+        print('instructions with the most stall cycles:')
+        hot = sorted(rows, key=lambda r: sum(r['stalls']), reverse=True)
+        for row in hot[:args.top]:
+            reasons = ', '.join('%s %d' % (n, s) for n, s in
+                                zip(stall_names, row['stalls']) if s)
+            print('%#06x: %-40s %d (%s)' % (row['pc'], row['disasm'],
+                                            sum(row['stalls']), reasons))
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,125 @@
+#!/usr/bin/env python2
+
+#
+# Copyright (c) 2026 The gem5 Authors
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+
+# Measure the host throughput of the GPU coalescer and the Ruby memory
+# system with the GPU Ruby tester (cpu/testers/gpu_ruby_test). Each gem5
+# binary given is run on configs/example/ruby_gpu_random_test.py with a
+# configuration that keeps many aliased and coalesced requests in flight,
+# and the median host time and simulated ticks per host second of the
+# runs are reported, along with the speedup over the first binary. The
+# binaries must be built for a GPU protocol, e.g., GPU_VIPER.
+#
+# Usage:
+#   gpu_ruby_test_bench.py [--runs <n>] [--test-length <n>]
+#                          [--wavefronts <n>] [--outdir <dir>]
+#                          <gem5 binary> [<gem5 binary> ...]
+
+from __future__ import print_function
+
+import argparse
+import os
+import re
+import subprocess
+import sys
+
+CONFIG = os.path.join(os.path.dirname(os.path.abspath(__file__)),
+                      '..', 'configs', 'example', 'ruby_gpu_random_test.py')
+
+def read_stats(path):
+    stats = {}
+    with open(path) as f:
+        for line in f:
+            m = re.match(r'(host_seconds|sim_ticks)\s+(\S+)', line)
+            if m:
+                stats[m.group(1)] = float(m.group(2))
+    return stats
+
+def median(values):
+    values = sorted(values)
+    mid = len(values) // 2
+    if len(values) % 2:
+        return values[mid]
+    return (values[mid - 1] + values[mid]) / 2.0
+
+def run(binary, outdir, args):
+    cmd = [binary, '--outdir=%s' % outdir, CONFIG,
+           '--system-size=2', '--address-range=0', '--episode-length=2',
+           '--cache-size=0', '--test-length=%d' % args.test_length,
+           '--wavefronts-per-cu=%d' % args.wavefronts,
+           '--random-seed=%d' % args.seed]
+    with open(os.path.join(outdir, 'bench.log'), 'w') as log:
+        if subprocess.call(cmd, stdout=log, stderr=subprocess.STDOUT):
+            sys.exit('%s failed, see %s' % (' '.join(cmd),
+                                            os.path.join(outdir, 'bench.log')))
+    return read_stats(os.path.join(outdir, 'stats.txt'))
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Benchmark the host throughput of the GPU Ruby tester')
+    parser.add_argument('binaries', nargs='+', help='gem5 binaries')
+    parser.add_argument('--runs', type=int, default=3,
+                        help='runs per binary, the median is reported')
+    parser.add_argument('--test-length', type=int, default=100,
+                        help='episodes executed by each wavefront')
+    parser.add_argument('--wavefronts', type=int, default=10,
+                        help='wavefronts per CU')
+    parser.add_argument('--seed', type=int, default=0,
+                        help='random seed of the tester')
+    parser.add_argument('--outdir', default='gpu_ruby_test_bench',
+                        help='directory for the output of the runs')
+    args = parser.parse_args()
+
+    results = []
+    for i, binary in enumerate(args.binaries):
+        seconds = []
+        ticks = None
+        for r in range(args.runs):
+            outdir = os.path.join(args.outdir, '%d' % i, '%d' % r)
+            if not os.path.isdir(outdir):
+                os.makedirs(outdir)
+            stats = run(binary, outdir, args)
+            seconds.append(stats['host_seconds'])
+            ticks = stats['sim_ticks']
+        results.append((binary, median(seconds), ticks))
+
+    base_seconds = results[0][1]
+    print('%-40s %12s %16s %8s' % ('binary', 'host seconds', 'ticks/host s',
+                                   'speedup'))
+    for binary, seconds, ticks in results:
+        print('%-40s %12.2f %16.0f %8.2f' % (binary[-40:], seconds,
+                                             ticks / seconds,
+                                             base_seconds / seconds))
+
+    # the simulated behavior must not depend on the host data structures
+    if len(set(ticks for _, _, ticks in results)) > 1:
+        print('warning: the binaries simulated different numbers of ticks')
+
+if __name__ == '__main__':
+    main()
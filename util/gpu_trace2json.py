@@ -0,0 +1,186 @@
+#!/usr/bin/env python2
+
+#
+# Copyright (c) 2026 The gem5 Authors
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+
+# Convert a GPU timeline trace, as written by the shader when its
+# trace_file parameter is set, to the Chrome trace event format, which
+# can be viewed in chrome://tracing or the Perfetto UI.
+#
+# Each CU is shown as a process with a thread per wavefront slot, on
+# which the lifetime of the wavefronts and the instructions they issued
+# are drawn. Memory instructions and barriers are drawn as async slices
+# that span from their issue to their completion. Kernel launches and
+# workgroup completions are shown on the dispatcher.
+#
+# Usage:
+#   gpu_trace2json.py [--no-mem-requests] <trace file> <json file>
+
+from __future__ import print_function
+
+import argparse
+import gzip
+import json
+import struct
+import sys
+
+# must match GPUTrace::FileHeader and GPUTrace::Record
+HEADER = struct.Struct('<8sIIQQ')
+RECORD = struct.Struct('<QQQIIIHHBB6x')
+MAGIC = b'GEM5GPUT'
+
+(WF_DISPATCH, WF_END, INST_ISSUE, INST_COMPLETE, MEM_SEND, MEM_RESP,
+ BARRIER_ARRIVE, BARRIER_RELEASE, WG_COMPLETE, KERNEL_LAUNCH,
+ KERNEL_END) = range(11)
+
+DISPATCHER_PID = 0
+# the thread of each wavefront slot, on the process of its CU
+SLOTS_PER_SIMD = 1000
+
+def read_trace(path):
+    opener = gzip.open if path.endswith('.gz') else open
+    with opener(path, 'rb') as f:
+        data = f.read()
+
+    magic, version, record_size, freq, period = HEADER.unpack_from(data, 0)
+    if magic != MAGIC or version != 1 or record_size != RECORD.size:
+        sys.exit('%s is not a GPU trace this script can read' % path)
+
+    records = []
+    kernel_names = {}
+    pos = HEADER.size
+    while pos + RECORD.size <= len(data):
+        rec = RECORD.unpack_from(data, pos)
+        pos += RECORD.size
+        if rec[9] == KERNEL_LAUNCH:
+            # the name of the kernel follows the launch record
+            length = rec[2]
+            name = data[pos:pos + length].decode('utf-8', 'replace')
+            kernel_names[rec[3]] = name
+            pos += -(-length // RECORD.size) * RECORD.size
+        records.append(rec)
+
+    return freq, period, kernel_names, records
+
+def convert(trace, out, mem_requests):
+    freq, period, kernel_names, records = read_trace(trace)
+
+    def ts(tick):
+        return tick * 1e6 / freq
+
+    # instructions that completed after they were issued, all others take
+    # a single cycle
+    completed = set((r[6], r[1]) for r in records if r[9] == INST_COMPLETE)
+
+    events = []
+    threads = set()
+    waves = {}
+
+    for (tick, seq_num, arg, kern_id, wg_id, wf_dyn_id, cu_id, wf_slot,
+         simd_id, etype) in records:
+        pid = cu_id + 1
+        tid = simd_id * SLOTS_PER_SIMD + wf_slot
+
+        if etype == WF_DISPATCH:
+            threads.add((pid, tid, simd_id, wf_slot))
+            waves[(cu_id, wf_dyn_id)] = tick
+        elif etype == WF_END:
+            start = waves.pop((cu_id, wf_dyn_id), tick)
+            events.append({'name': 'wf %d' % wf_dyn_id, 'cat': 'wave',
+                           'ph': 'X', 'pid': pid, 'tid': tid,
+                           'ts': ts(start), 'dur': ts(tick - start),
+                           'args': {'kernel': kern_id, 'wg': wg_id}})
+        elif etype == INST_ISSUE:
+            name = 'pc %#x' % arg
+            if (cu_id, seq_num) in completed:
+                events.append({'name': name, 'cat': 'mem', 'ph': 'b',
+                               'id': '%d.%d' % (cu_id, seq_num),
+                               'pid': pid, 'tid': tid, 'ts': ts(tick)})
+            else:
+                events.append({'name': name, 'cat': 'inst', 'ph': 'X',
+                               'pid': pid, 'tid': tid, 'ts': ts(tick),
+                               'dur': ts(period)})
+        elif etype == INST_COMPLETE:
+            events.append({'cat': 'mem', 'ph': 'e',
+                           'id': '%d.%d' % (cu_id, seq_num),
+                           'pid': pid, 'tid': tid, 'ts': ts(tick)})
+        elif etype in (MEM_SEND, MEM_RESP):
+            if mem_requests:
+                name = 'send' if etype == MEM_SEND else 'resp'
+                events.append({'name': name, 'cat': 'mem_req', 'ph': 'i',
+                               's': 't', 'pid': pid, 'tid': tid,
+                               'ts': ts(tick),
+                               'args': {'addr': '%#x' % arg,
+                                        'seq_num': seq_num}})
+        elif etype in (BARRIER_ARRIVE, BARRIER_RELEASE):
+            events.append({'name': 'barrier', 'cat': 'barrier',
+                           'ph': 'b' if etype == BARRIER_ARRIVE else 'e',
+                           'id': 'wf%d' % wf_dyn_id, 'pid': pid,
+                           'tid': tid, 'ts': ts(tick)})
+        elif etype == WG_COMPLETE:
+            events.append({'name': 'wg %d complete' % wg_id, 'cat': 'wg',
+                           'ph': 'i', 's': 'p', 'pid': DISPATCHER_PID,
+                           'tid': 0, 'ts': ts(tick),
+                           'args': {'kernel': kern_id, 'cu': cu_id}})
+        elif etype in (KERNEL_LAUNCH, KERNEL_END):
+            events.append({'name': kernel_names.get(kern_id,
+                                                    'kernel %d' % kern_id),
+                           'cat': 'kernel',
+                           'ph': 'b' if etype == KERNEL_LAUNCH else 'e',
+                           'id': 'kernel%d' % kern_id,
+                           'pid': DISPATCHER_PID, 'tid': 0, 'ts': ts(tick),
+                           'args': {'dispatch_id': kern_id}})
+
+    # name the processes and threads
+    events.append({'name': 'process_name', 'ph': 'M',
+                   'pid': DISPATCHER_PID, 'args': {'name': 'dispatcher'}})
+    for pid in sorted(set(t[0] for t in threads)):
+        events.append({'name': 'process_name', 'ph': 'M', 'pid': pid,
+                       'args': {'name': 'CU %d' % (pid - 1)}})
+    for pid, tid, simd_id, wf_slot in threads:
+        events.append({'name': 'thread_name', 'ph': 'M', 'pid': pid,
+                       'tid': tid, 'args': {'name': 'SIMD %d WF %d' %
+                                            (simd_id, wf_slot)}})
+
+    with open(out, 'w') as f:
+        json.dump({'traceEvents': events, 'displayTimeUnit': 'ns'}, f)
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Convert a GPU trace to the Chrome trace event format')
+    parser.add_argument('trace', help='trace file written by the shader')
+    parser.add_argument('json', help='JSON file to write')
+    parser.add_argument('--no-mem-requests', dest='mem_requests',
+                        action='store_false',
+                        help='omit the individual memory requests')
+    args = parser.parse_args()
+
+    convert(args.trace, args.json, args.mem_requests)
+
+if __name__ == '__main__':
+    sys.exit(main())